@@ -1,7 +1,9 @@
+#define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include <stdlib.h>
 #include <math.h>
 #include <limits.h>
+#include <string.h>
 
 // --- Hex Utils ---
 
@@ -95,17 +97,49 @@ static Node heap_pop(MinHeap *heap) {
 }
 
 // --- Common Parser ---
+// Copy a width*height byte mask (bytes, bytearray, array('B')) into out.
+// Returns 1 if obj was such a mask, 0 if it is not a buffer, -1 on error.
+static int read_tile_mask(PyObject *obj, int map_size, int *out, const char *name) {
+    if (!PyObject_CheckBuffer(obj)) return 0;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_SIMPLE) < 0) return -1;
+    if (view.len != map_size) {
+        PyErr_Format(PyExc_ValueError, "%s mask must have %d bytes, got %zd", name, map_size, view.len);
+        PyBuffer_Release(&view);
+        return -1;
+    }
+    const unsigned char *mask = (const unsigned char*)view.buf;
+    for (int i = 0; i < map_size; i++) {
+        out[i] = mask[i] != 0;
+    }
+    PyBuffer_Release(&view);
+    return 1;
+}
+
 static int parse_common_args(int width, int height, PyObject *terrain_grid_obj, 
                            PyObject *cost_map_obj, PyObject *blockers_list_obj,
                            int **grid_out, double *costs_out, int **blocked_out) {
     
     int map_size = width * height;
     
-    // 1. Parse Terrain Grid
+    // 1. Parse Terrain Grid: a byte plane (one terrain id per tile) or a sequence of ints
     int *grid = (int*)malloc(sizeof(int) * map_size);
     if (!grid) { PyErr_NoMemory(); return 0; }
     
-    if (PySequence_Check(terrain_grid_obj)) {
+    if (PyBytes_Check(terrain_grid_obj) || PyByteArray_Check(terrain_grid_obj)) {
+        Py_ssize_t size = PyBytes_Check(terrain_grid_obj) ? PyBytes_GET_SIZE(terrain_grid_obj)
+                                                          : PyByteArray_GET_SIZE(terrain_grid_obj);
+        const unsigned char *ids = PyBytes_Check(terrain_grid_obj)
+            ? (const unsigned char*)PyBytes_AS_STRING(terrain_grid_obj)
+            : (const unsigned char*)PyByteArray_AS_STRING(terrain_grid_obj);
+        if (size != map_size) {
+            free(grid);
+            PyErr_Format(PyExc_ValueError, "terrain_grid must have %d tiles, got %zd", map_size, size);
+            return 0;
+        }
+        for (int i = 0; i < map_size; i++) grid[i] = ids[i];
+    } else if (PySequence_Check(terrain_grid_obj)) {
         for (int i = 0; i < map_size; i++) {
             PyObject *item = PySequence_GetItem(terrain_grid_obj, i);
             if (!item) { free(grid); return 0; }
@@ -133,9 +167,18 @@ static int parse_common_args(int width, int height, PyObject *terrain_grid_obj,
         }
     }
     
-    // 3. Parse Blockers 
+    // 3. Parse Blockers: a byte mask, or an iterable of (x, y) tuples
     int *blocked = (int*)calloc(map_size, sizeof(int));
+    int mask_read = 0;
     if (blockers_list_obj && blockers_list_obj != Py_None) {
+        mask_read = read_tile_mask(blockers_list_obj, map_size, blocked, "blockers");
+        if (mask_read < 0) {
+            free(grid);
+            free(blocked);
+            return 0;
+        }
+    }
+    if (!mask_read && blockers_list_obj && blockers_list_obj != Py_None) {
         PyObject *iterator = PyObject_GetIter(blockers_list_obj);
         if (iterator) {
             PyObject *item;
@@ -302,10 +345,17 @@ static PyObject* c_find_reachable(PyObject* self, PyObject* args) {
     
     int map_size = width * height;
     
-    // Parse ZOC Map
+    // Parse ZOC Map: a byte mask or a sequence of truthy values
     int *zoc_map = (int*)calloc(map_size, sizeof(int));
     if (zoc_map_obj && zoc_map_obj != Py_None) {
-        if (PySequence_Check(zoc_map_obj)) {
+        int mask_read = read_tile_mask(zoc_map_obj, map_size, zoc_map, "zoc_map");
+        if (mask_read < 0) {
+            free(grid);
+            free(blocked);
+            free(zoc_map);
+            return NULL;
+        }
+        if (!mask_read && PySequence_Check(zoc_map_obj)) {
             for (int i = 0; i < map_size; i++) {
                 PyObject *item = PySequence_GetItem(zoc_map_obj, i);
                 if (item) {
@@ -427,9 +477,1744 @@ static PyObject* c_find_reachable(PyObject* self, PyObject* args) {
     return result_dict;
 }
 
+// --- Threat / Influence Maps ---
+
+#define THREAT_UNREACHED 255
+
+typedef struct {
+    int x;
+    int y;
+    int profile;
+    double action_points;
+    double attack_cost;
+    int attack_range;
+    double attack_potential;
+} ThreatSource;
+
+static int parse_cost_profile(PyObject *profile_obj, double *costs_out) {
+    for (int i = 0; i < 100; i++) costs_out[i] = 1.0;
+    if (!PyDict_Check(profile_obj)) {
+        PyErr_SetString(PyExc_TypeError, "cost profiles must be dicts");
+        return 0;
+    }
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(profile_obj, &pos, &key, &value)) {
+        long id = PyLong_AsLong(key);
+        double cost = PyFloat_AsDouble(value);
+        if (PyErr_Occurred()) return 0;
+        if (id >= 0 && id < 100) {
+            costs_out[id] = cost;
+        }
+    }
+    return 1;
+}
+
+static int parse_threat_source(PyObject *item, int profile_count, ThreatSource *out) {
+    if (!PyArg_ParseTuple(item, "iiiddid", &out->x, &out->y, &out->profile,
+                          &out->action_points, &out->attack_cost,
+                          &out->attack_range, &out->attack_potential)) {
+        return 0;
+    }
+    if (out->profile < 0 || out->profile >= profile_count) {
+        PyErr_SetString(PyExc_ValueError, "threat source references unknown cost profile");
+        return 0;
+    }
+    return 1;
+}
+
+// Bounded Dijkstra from one source; fills min_costs (INFINITY when beyond budget)
+static void threat_dijkstra(int width, int height, const int *grid, const int *blocked,
+                            const double *costs, const ThreatSource *src, double budget,
+                            double *min_costs, int *closed, MinHeap *queue) {
+    int map_size = width * height;
+    for (int i = 0; i < map_size; i++) { min_costs[i] = INFINITY; closed[i] = 0; }
+    queue->size = 0;
+
+    int even_row_dirs[6][2] = {{-1, -1}, {0, -1}, {1, 0}, {0, 1}, {-1, 1}, {-1, 0}};
+    int odd_row_dirs[6][2]  = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 0}};
+
+    min_costs[src->y * width + src->x] = 0.0;
+    heap_push(queue, src->x, src->y, 0.0);
+
+    while (queue->size > 0) {
+        Node current = heap_pop(queue);
+        int c_idx = current.y * width + current.x;
+        if (current.priority > min_costs[c_idx]) continue;
+        if (closed[c_idx]) continue;
+        closed[c_idx] = 1;
+
+        int (*dirs)[2] = (current.y % 2 == 0) ? even_row_dirs : odd_row_dirs;
+        for (int i = 0; i < 6; i++) {
+            int nx = current.x + dirs[i][0];
+            int ny = current.y + dirs[i][1];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+            int n_idx = ny * width + nx;
+            if (closed[n_idx] || blocked[n_idx]) continue;
+
+            int terrain_id = grid[n_idx];
+            double move_cost = 1.0;
+            if (terrain_id >= 0 && terrain_id < 100) move_cost = costs[terrain_id];
+            if (move_cost < 1.0) move_cost = 1.0;
+            if (isinf(move_cost)) continue;
+
+            double new_cost = min_costs[c_idx] + move_cost;
+            if (new_cost > budget) continue;
+            if (new_cost < min_costs[n_idx]) {
+                min_costs[n_idx] = new_cost;
+                heap_push(queue, nx, ny, new_cost);
+            }
+        }
+    }
+}
+
+static PyObject* c_compute_threat_map(PyObject* self, PyObject* args) {
+    int width, height;
+    PyObject *terrain_grid_obj;
+    PyObject *cost_profiles_obj;
+    PyObject *sources_obj;
+    PyObject *blockers_list_obj;
+    int max_turns;
+
+    if (!PyArg_ParseTuple(args, "iiOOOOi",
+        &width, &height, &terrain_grid_obj, &cost_profiles_obj,
+        &sources_obj, &blockers_list_obj, &max_turns)) {
+        return NULL;
+    }
+    if (width <= 0 || height <= 0) {
+        PyErr_SetString(PyExc_ValueError, "threat map dimensions must be positive");
+        return NULL;
+    }
+    if (max_turns < 0 || max_turns >= THREAT_UNREACHED) {
+        PyErr_SetString(PyExc_ValueError, "max_turns must be between 0 and 254");
+        return NULL;
+    }
+
+    int *grid = NULL;
+    int *blocked = NULL;
+    double unused_costs[100];
+    if (!parse_common_args(width, height, terrain_grid_obj, Py_None, blockers_list_obj,
+                          &grid, unused_costs, &blocked)) {
+        return NULL;
+    }
+
+    PyObject *profiles_seq = PySequence_Fast(cost_profiles_obj, "cost_profiles must be a sequence");
+    PyObject *sources_seq = profiles_seq ? PySequence_Fast(sources_obj, "sources must be a sequence") : NULL;
+    if (!sources_seq) {
+        Py_XDECREF(profiles_seq);
+        free(grid); free(blocked);
+        return NULL;
+    }
+
+    int map_size = width * height;
+    Py_ssize_t profile_count = PySequence_Fast_GET_SIZE(profiles_seq);
+    Py_ssize_t source_count = PySequence_Fast_GET_SIZE(sources_seq);
+
+    double *profiles = (double*)malloc(sizeof(double) * 100 * (profile_count > 0 ? profile_count : 1));
+    unsigned char *earliest = (unsigned char*)malloc(map_size);
+    double *cost_field = (double*)malloc(sizeof(double) * map_size);
+    double *potential = (double*)calloc(map_size, sizeof(double));
+    unsigned char *coverage = (unsigned char*)calloc(map_size, 1);
+    double *min_costs = (double*)malloc(sizeof(double) * map_size);
+    int *closed = (int*)malloc(sizeof(int) * map_size);
+    int *stamp = (int*)calloc(map_size, sizeof(int));
+    // Lazy deletion pushes at most one entry per relaxed edge
+    MinHeap *queue = create_heap(map_size * 6 + 1);
+    PyObject *result = NULL;
+
+    if (!profiles || !earliest || !cost_field || !potential || !coverage ||
+        !min_costs || !closed || !stamp || !queue || !queue->nodes) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    for (Py_ssize_t p = 0; p < profile_count; p++) {
+        if (!parse_cost_profile(PySequence_Fast_GET_ITEM(profiles_seq, p), profiles + 100 * p)) {
+            goto cleanup;
+        }
+    }
+
+    memset(earliest, THREAT_UNREACHED, map_size);
+    for (int i = 0; i < map_size; i++) cost_field[i] = INFINITY;
+
+    for (Py_ssize_t s = 0; s < source_count; s++) {
+        ThreatSource src;
+        if (!parse_threat_source(PySequence_Fast_GET_ITEM(sources_seq, s), (int)profile_count, &src)) {
+            goto cleanup;
+        }
+        if (src.x < 0 || src.x >= width || src.y < 0 || src.y >= height) continue;
+
+        double budget = src.action_points > 0 ? src.action_points * max_turns : 0.0;
+        threat_dijkstra(width, height, grid, blocked, profiles + 100 * src.profile,
+                        &src, budget, min_costs, closed, queue);
+
+        // Tiles this source can still attack from after moving on its next turn
+        double attack_budget = src.action_points - src.attack_cost;
+        int can_attack = src.attack_range > 0 && src.attack_potential > 0 && attack_budget >= 0;
+        int ranged = src.attack_range > 1;
+        int tag = (int)s + 1;
+
+        for (int idx = 0; idx < map_size; idx++) {
+            double cost = min_costs[idx];
+            if (isinf(cost)) continue;
+
+            int turn = cost <= 0.0 ? 0 : (int)ceil(cost / src.action_points - 1e-9);
+            if (turn < earliest[idx]) earliest[idx] = (unsigned char)turn;
+            if (cost < cost_field[idx]) cost_field[idx] = cost;
+
+            if (!can_attack || cost > attack_budget) continue;
+
+            int fx = idx % width;
+            int fy = idx / width;
+            HexCoord from_hex = offset_to_axial(fx, fy);
+            int range = src.attack_range;
+            for (int ty = fy - range; ty <= fy + range; ty++) {
+                if (ty < 0 || ty >= height) continue;
+                for (int tx = fx - range - 1; tx <= fx + range + 1; tx++) {
+                    if (tx < 0 || tx >= width) continue;
+                    int t_idx = ty * width + tx;
+                    if (stamp[t_idx] == tag) continue;
+                    if (hex_distance(from_hex, offset_to_axial(tx, ty)) > range) continue;
+                    stamp[t_idx] = tag;
+                    potential[t_idx] += src.attack_potential;
+                    if (ranged && coverage[t_idx] < 255) coverage[t_idx]++;
+                }
+            }
+        }
+    }
+
+    result = Py_BuildValue("(y#y#y#y#)",
+        (const char*)earliest, (Py_ssize_t)map_size,
+        (const char*)cost_field, (Py_ssize_t)(sizeof(double) * map_size),
+        (const char*)potential, (Py_ssize_t)(sizeof(double) * map_size),
+        (const char*)coverage, (Py_ssize_t)map_size);
+
+cleanup:
+    if (queue) destroy_heap(queue);
+    free(profiles); free(earliest); free(cost_field); free(potential); free(coverage);
+    free(min_costs); free(closed); free(stamp);
+    free(grid); free(blocked);
+    Py_DECREF(profiles_seq);
+    Py_DECREF(sources_seq);
+    return result;
+}
+
+// --- Flee Field ---
+
+// Unbounded Dijkstra seeded from every tile in seeds (flat indices)
+static void multi_source_dijkstra(int width, int height, const int *grid, const int *blocked,
+                                  const double *costs, const int *seeds, int seed_count,
+                                  double *min_costs, int *closed, MinHeap *queue) {
+    int map_size = width * height;
+    for (int i = 0; i < map_size; i++) { min_costs[i] = INFINITY; closed[i] = 0; }
+    queue->size = 0;
+
+    int even_row_dirs[6][2] = {{-1, -1}, {0, -1}, {1, 0}, {0, 1}, {-1, 1}, {-1, 0}};
+    int odd_row_dirs[6][2]  = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 0}};
+
+    for (int s = 0; s < seed_count; s++) {
+        if (min_costs[seeds[s]] == 0.0) continue;
+        min_costs[seeds[s]] = 0.0;
+        heap_push(queue, seeds[s] % width, seeds[s] / width, 0.0);
+    }
+
+    while (queue->size > 0) {
+        Node current = heap_pop(queue);
+        int c_idx = current.y * width + current.x;
+        if (current.priority > min_costs[c_idx]) continue;
+        if (closed[c_idx]) continue;
+        closed[c_idx] = 1;
+
+        int (*dirs)[2] = (current.y % 2 == 0) ? even_row_dirs : odd_row_dirs;
+        for (int i = 0; i < 6; i++) {
+            int nx = current.x + dirs[i][0];
+            int ny = current.y + dirs[i][1];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+            int n_idx = ny * width + nx;
+            if (closed[n_idx] || blocked[n_idx]) continue;
+
+            int terrain_id = grid[n_idx];
+            double move_cost = 1.0;
+            if (terrain_id >= 0 && terrain_id < 100) move_cost = costs[terrain_id];
+            if (move_cost < 1.0) move_cost = 1.0;
+            if (isinf(move_cost)) continue;
+
+            double new_cost = min_costs[c_idx] + move_cost;
+            if (new_cost < min_costs[n_idx]) {
+                min_costs[n_idx] = new_cost;
+                heap_push(queue, nx, ny, new_cost);
+            }
+        }
+    }
+}
+
+// Lowest movement cost any source pays to reach each tile, each source moving
+// with its own cost profile. One multi-source pass per profile in use.
+static PyObject* c_compute_flee_field(PyObject* self, PyObject* args) {
+    int width, height;
+    PyObject *terrain_grid_obj;
+    PyObject *cost_profiles_obj;
+    PyObject *sources_obj;
+    PyObject *blockers_obj;
+
+    if (!PyArg_ParseTuple(args, "iiOOOO",
+        &width, &height, &terrain_grid_obj, &cost_profiles_obj, &sources_obj, &blockers_obj)) {
+        return NULL;
+    }
+    if (width <= 0 || height <= 0) {
+        PyErr_SetString(PyExc_ValueError, "flee field dimensions must be positive");
+        return NULL;
+    }
+
+    int *grid = NULL;
+    int *blocked = NULL;
+    double unused_costs[100];
+    if (!parse_common_args(width, height, terrain_grid_obj, Py_None, blockers_obj,
+                          &grid, unused_costs, &blocked)) {
+        return NULL;
+    }
+
+    PyObject *profiles_seq = PySequence_Fast(cost_profiles_obj, "cost_profiles must be a sequence");
+    PyObject *sources_seq = profiles_seq ? PySequence_Fast(sources_obj, "sources must be a sequence") : NULL;
+    if (!sources_seq) {
+        Py_XDECREF(profiles_seq);
+        free(grid); free(blocked);
+        return NULL;
+    }
+
+    int map_size = width * height;
+    Py_ssize_t profile_count = PySequence_Fast_GET_SIZE(profiles_seq);
+    Py_ssize_t source_count = PySequence_Fast_GET_SIZE(sources_seq);
+
+    double *profiles = (double*)malloc(sizeof(double) * 100 * (profile_count > 0 ? profile_count : 1));
+    int *source_tiles = (int*)malloc(sizeof(int) * (source_count > 0 ? source_count : 1));
+    int *source_profiles = (int*)malloc(sizeof(int) * (source_count > 0 ? source_count : 1));
+    int *seeds = (int*)malloc(sizeof(int) * (source_count > 0 ? source_count : 1));
+    double *field = (double*)malloc(sizeof(double) * map_size);
+    double *min_costs = (double*)malloc(sizeof(double) * map_size);
+    int *closed = (int*)malloc(sizeof(int) * map_size);
+    // Lazy deletion pushes at most one entry per relaxed edge plus the seeds
+    MinHeap *queue = create_heap(map_size * 7 + 1);
+    PyObject *result = NULL;
+
+    if (!profiles || !source_tiles || !source_profiles || !seeds || !field ||
+        !min_costs || !closed || !queue || !queue->nodes) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    for (Py_ssize_t p = 0; p < profile_count; p++) {
+        if (!parse_cost_profile(PySequence_Fast_GET_ITEM(profiles_seq, p), profiles + 100 * p)) {
+            goto cleanup;
+        }
+    }
+
+    int valid_sources = 0;
+    for (Py_ssize_t s = 0; s < source_count; s++) {
+        int x, y, profile;
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(sources_seq, s), "iii", &x, &y, &profile)) {
+            goto cleanup;
+        }
+        if (profile < 0 || profile >= profile_count) {
+            PyErr_SetString(PyExc_ValueError, "flee source references unknown cost profile");
+            goto cleanup;
+        }
+        if (x < 0 || x >= width || y < 0 || y >= height) continue;
+        source_tiles[valid_sources] = y * width + x;
+        source_profiles[valid_sources] = profile;
+        valid_sources++;
+    }
+
+    for (int i = 0; i < map_size; i++) field[i] = INFINITY;
+
+    for (Py_ssize_t p = 0; p < profile_count; p++) {
+        int seed_count = 0;
+        for (int s = 0; s < valid_sources; s++) {
+            if (source_profiles[s] == p) seeds[seed_count++] = source_tiles[s];
+        }
+        if (seed_count == 0) continue;
+
+        multi_source_dijkstra(width, height, grid, blocked, profiles + 100 * p,
+                              seeds, seed_count, min_costs, closed, queue);
+        for (int i = 0; i < map_size; i++) {
+            if (min_costs[i] < field[i]) field[i] = min_costs[i];
+        }
+    }
+
+    result = PyBytes_FromStringAndSize((const char*)field, (Py_ssize_t)(sizeof(double) * map_size));
+
+cleanup:
+    if (queue) destroy_heap(queue);
+    free(profiles); free(source_tiles); free(source_profiles); free(seeds);
+    free(field); free(min_costs); free(closed);
+    free(grid); free(blocked);
+    Py_DECREF(profiles_seq);
+    Py_DECREF(sources_seq);
+    return result;
+}
+
+// --- Battle Rollouts ---
+
+#define ROLLOUT_EPSILON 0.1
+#define UNIT_WARRIOR 0
+#define UNIT_ARCHER 1
+#define UNIT_CAVALRY 2
+
+typedef struct {
+    int x;
+    int y;
+    int side;
+    int profile;
+    int kind;
+    int soldiers;
+    int max_soldiers;
+    double formation_width;
+    double attack_per_soldier;
+    double morale_factor;
+    double counter_morale_factor;
+    double cohesion_factor;
+    int disrupted;
+    double damage_modifier;
+    double defense;
+    double base_defense;
+    int garrisoned;
+    double action_points;
+    double max_action_points;
+    double attack_cost;
+    int attack_range;
+    double value;
+} RolloutUnit;
+
+typedef struct {
+    double defense_bonus;
+    double frontage;
+    int is_hills;
+    double movement_cost;
+} RolloutTerrain;
+
+typedef struct {
+    int width;
+    int height;
+    const int *grid;
+    const int *blocked;
+    const double *cost_profiles;
+    const double *combat_profiles;
+    const RolloutTerrain *terrain;
+} RolloutBoard;
+
+// xorshift64*; the Python twin reproduces the exact sequence
+static unsigned long long rollout_next(unsigned long long *state) {
+    unsigned long long x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 2685821657736338717ULL;
+}
+
+static int rollout_below(unsigned long long *state, int n) {
+    return (int)((rollout_next(state) >> 33) % (unsigned long long)n);
+}
+
+static double rollout_uniform(unsigned long long *state) {
+    return (double)(rollout_next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static const RolloutTerrain *rollout_terrain_at(const RolloutBoard *board, int x, int y) {
+    static const RolloutTerrain open_ground = {0.0, 1.0, 0, 1.0};
+    int terrain_id = board->grid[y * board->width + x];
+    if (terrain_id < 0 || terrain_id >= 100) return &open_ground;
+    return &board->terrain[terrain_id];
+}
+
+static double rollout_combat_modifier(const RolloutBoard *board, const RolloutUnit *unit) {
+    int terrain_id = board->grid[unit->y * board->width + unit->x];
+    if (terrain_id < 0 || terrain_id >= 100) return 1.0;
+    return board->combat_profiles[100 * unit->profile + terrain_id];
+}
+
+static int rollout_effective_soldiers(const RolloutUnit *unit, const RolloutTerrain *terrain) {
+    int width = (int)(unit->formation_width * terrain->frontage);
+    return width < unit->soldiers ? width : unit->soldiers;
+}
+
+static int rollout_distance(const RolloutUnit *a, const RolloutUnit *b) {
+    return hex_distance(offset_to_axial(a->x, a->y), offset_to_axial(b->x, b->y));
+}
+
+// AttackBehavior.calculate_damage for a frontal attack
+static int rollout_damage(const RolloutBoard *board, const RolloutUnit *attacker,
+                          const RolloutUnit *target, int charge) {
+    const RolloutTerrain *attacker_terrain = rollout_terrain_at(board, attacker->x, attacker->y);
+    const RolloutTerrain *target_terrain = rollout_terrain_at(board, target->x, target->y);
+    int attacking_soldiers = rollout_effective_soldiers(attacker, attacker_terrain);
+
+    double base_damage = attacking_soldiers * attacker->attack_per_soldier;
+    if (charge) base_damage *= 1.3;
+    base_damage *= rollout_combat_modifier(board, attacker);
+    base_damage *= attacker->morale_factor;
+    base_damage *= attacker->cohesion_factor;
+    if (attacker->disrupted) base_damage *= 0.5;
+    base_damage *= attacker->damage_modifier;
+
+    if (attacker->attack_range > 1) {
+        if (!attacker_terrain->is_hills && target_terrain->is_hills) {
+            base_damage = (int)(base_damage * 0.5);
+        } else if (attacker_terrain->is_hills && !target_terrain->is_hills) {
+            base_damage = (int)(base_damage * 1.5);
+        }
+    }
+
+    double target_defense = target->defense;
+    target_defense += target_terrain->defense_bonus;
+    if (target->disrupted) target_defense *= 0.5;
+    if (target->garrisoned) target_defense += 20;
+
+    double total = base_damage + target_defense;
+    double damage_ratio = total != 0.0 ? base_damage / total : 0.0;
+    int casualties = (int)(damage_ratio * attacking_soldiers * 0.25);
+
+    if (attacker->kind == UNIT_CAVALRY && target->kind == UNIT_ARCHER) {
+        casualties = (int)(casualties * 1.5);
+    } else if (attacker->kind == UNIT_ARCHER && target->kind == UNIT_WARRIOR) {
+        casualties = (int)(casualties * 0.8);
+    }
+    return casualties < target->soldiers ? casualties : target->soldiers;
+}
+
+// AttackBehavior.calculate_counter_damage
+static int rollout_counter_damage(const RolloutBoard *board, const RolloutUnit *defender,
+                                  const RolloutUnit *attacker) {
+    if (defender->kind == UNIT_ARCHER) return 0;
+    const RolloutTerrain *defender_terrain = rollout_terrain_at(board, defender->x, defender->y);
+    const RolloutTerrain *attacker_terrain = rollout_terrain_at(board, attacker->x, attacker->y);
+    int defending_soldiers = rollout_effective_soldiers(defender, defender_terrain);
+
+    double base_damage = defender->attack_per_soldier * defending_soldiers;
+    base_damage *= rollout_combat_modifier(board, defender);
+    base_damage *= defender->counter_morale_factor;
+    base_damage *= defender->cohesion_factor;
+
+    double attacker_defense = attacker->base_defense + attacker_terrain->defense_bonus;
+    double total = base_damage + attacker_defense;
+    double damage_ratio = total != 0.0 ? base_damage / total : 0.0;
+    int casualties = (int)(damage_ratio * defending_soldiers * 0.15);
+
+    if (defender->kind == UNIT_WARRIOR && attacker->kind == UNIT_CAVALRY) {
+        casualties = (int)(casualties * 1.2);
+    }
+    return casualties < attacker->soldiers ? casualties : attacker->soldiers;
+}
+
+static double rollout_attack_cost(const RolloutBoard *board, const RolloutUnit *attacker,
+                                  const RolloutUnit *target) {
+    double movement_cost = rollout_terrain_at(board, target->x, target->y)->movement_cost;
+    double cost = attacker->attack_cost;
+    if (movement_cost > 1.0) {
+        cost += attacker->attack_range > 1 ? (int)(movement_cost - 1.0) : (int)((movement_cost - 1.0) * 2);
+    }
+    return cost;
+}
+
+// Weakest enemy in range (occasionally a random one), -1 if none
+static int rollout_pick_target(const RolloutUnit *units, int count, int self_index,
+                               unsigned long long *rng, int *candidates) {
+    const RolloutUnit *unit = &units[self_index];
+    int found = 0;
+    for (int i = 0; i < count; i++) {
+        if (units[i].soldiers <= 0 || units[i].side == unit->side) continue;
+        if (rollout_distance(unit, &units[i]) <= unit->attack_range) candidates[found++] = i;
+    }
+    if (found == 0) return -1;
+    if (rollout_uniform(rng) < ROLLOUT_EPSILON) return candidates[rollout_below(rng, found)];
+    int best = candidates[0];
+    for (int i = 1; i < found; i++) {
+        if (units[candidates[i]].soldiers < units[best].soldiers) best = candidates[i];
+    }
+    return best;
+}
+
+// Greedy advance towards the nearest enemy, keeping AP for the attack when possible
+static void rollout_advance(const RolloutBoard *board, RolloutUnit *units, int count, int self_index,
+                            int *occupied, double *action_points, unsigned long long *rng) {
+    static const int even_row_dirs[6][2] = {{-1, -1}, {0, -1}, {1, 0}, {0, 1}, {-1, 1}, {-1, 0}};
+    static const int odd_row_dirs[6][2]  = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 0}};
+    RolloutUnit *unit = &units[self_index];
+
+    int nearest = -1;
+    int nearest_distance = INT_MAX;
+    for (int i = 0; i < count; i++) {
+        if (units[i].soldiers <= 0 || units[i].side == unit->side) continue;
+        int distance = rollout_distance(unit, &units[i]);
+        if (distance < nearest_distance) { nearest_distance = distance; nearest = i; }
+    }
+    if (nearest < 0) return;
+
+    HexCoord goal = offset_to_axial(units[nearest].x, units[nearest].y);
+    double budget = *action_points - unit->attack_cost;
+    if (budget < 0) budget = *action_points;
+    const double *costs = board->cost_profiles + 100 * unit->profile;
+
+    while (nearest_distance > unit->attack_range) {
+        int step_x[6], step_y[6], step_distance[6];
+        double step_cost[6];
+        int steps = 0;
+        const int (*dirs)[2] = (unit->y % 2 == 0) ? even_row_dirs : odd_row_dirs;
+        for (int d = 0; d < 6; d++) {
+            int nx = unit->x + dirs[d][0];
+            int ny = unit->y + dirs[d][1];
+            if (nx < 0 || nx >= board->width || ny < 0 || ny >= board->height) continue;
+            int n_idx = ny * board->width + nx;
+            if (board->blocked[n_idx] || occupied[n_idx]) continue;
+            int terrain_id = board->grid[n_idx];
+            double move_cost = (terrain_id >= 0 && terrain_id < 100) ? costs[terrain_id] : 1.0;
+            if (move_cost < 1.0) move_cost = 1.0;
+            if (isinf(move_cost) || move_cost > budget) continue;
+            int distance = hex_distance(offset_to_axial(nx, ny), goal);
+            if (distance >= nearest_distance) continue;
+            step_x[steps] = nx; step_y[steps] = ny;
+            step_distance[steps] = distance; step_cost[steps] = move_cost;
+            steps++;
+        }
+        if (steps == 0) return;
+
+        int chosen = 0;
+        if (rollout_uniform(rng) < ROLLOUT_EPSILON) {
+            chosen = rollout_below(rng, steps);
+        } else {
+            for (int i = 1; i < steps; i++) {
+                if (step_distance[i] < step_distance[chosen] ||
+                    (step_distance[i] == step_distance[chosen] && step_cost[i] < step_cost[chosen])) {
+                    chosen = i;
+                }
+            }
+        }
+
+        occupied[unit->y * board->width + unit->x] = 0;
+        unit->x = step_x[chosen];
+        unit->y = step_y[chosen];
+        occupied[unit->y * board->width + unit->x] = self_index + 1;
+        budget -= step_cost[chosen];
+        *action_points -= step_cost[chosen];
+        nearest_distance = step_distance[chosen];
+    }
+}
+
+static void rollout_resolve_attack(const RolloutBoard *board, RolloutUnit *units, int attacker_index,
+                                   int target_index, int *occupied) {
+    RolloutUnit *attacker = &units[attacker_index];
+    RolloutUnit *target = &units[target_index];
+    int ranged = rollout_distance(attacker, target) > 1;
+    int charge = !ranged && attacker->kind == UNIT_CAVALRY;
+
+    int damage = rollout_damage(board, attacker, target, charge);
+    int counter_damage = 0;
+    if (!ranged) {
+        counter_damage = rollout_counter_damage(board, target, attacker);
+        if (charge) counter_damage = (int)(counter_damage * 0.75);
+    }
+
+    target->soldiers -= damage;
+    attacker->soldiers -= counter_damage;
+    if (target->soldiers <= 0) {
+        target->soldiers = 0;
+        occupied[target->y * board->width + target->x] = 0;
+    }
+    if (attacker->soldiers <= 0) {
+        attacker->soldiers = 0;
+        occupied[attacker->y * board->width + attacker->x] = 0;
+    }
+}
+
+static double rollout_strength(const RolloutUnit *units, int count, int side) {
+    double strength = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (units[i].side == side && units[i].max_soldiers > 0) {
+            strength += units[i].value * units[i].soldiers / units[i].max_soldiers;
+        }
+    }
+    return strength;
+}
+
+// One playout; side 0 finishes its current turn first. Returns side 0's reward in [0, 1],
+// measured against the strengths each side had at the search root.
+static double rollout_play(const RolloutBoard *board, const RolloutUnit *initial, RolloutUnit *units,
+                           int count, int turns, const double *baseline, int *occupied, int *order,
+                           int *candidates, unsigned long long *rng) {
+    int map_size = board->width * board->height;
+    memcpy(units, initial, sizeof(RolloutUnit) * count);
+    memset(occupied, 0, sizeof(int) * map_size);
+    for (int i = 0; i < count; i++) {
+        if (units[i].soldiers > 0) occupied[units[i].y * board->width + units[i].x] = i + 1;
+    }
+
+    for (int half = 0; half < 2 * turns; half++) {
+        int side = half % 2;
+        int movers = 0;
+        int defenders = 0;
+        for (int i = 0; i < count; i++) {
+            if (units[i].soldiers <= 0) continue;
+            if (units[i].side == side) order[movers++] = i;
+            else defenders++;
+        }
+        if (movers == 0 || defenders == 0) break;
+
+        for (int i = movers - 1; i > 0; i--) {
+            int j = rollout_below(rng, i + 1);
+            int swap = order[i]; order[i] = order[j]; order[j] = swap;
+        }
+
+        for (int k = 0; k < movers; k++) {
+            int index = order[k];
+            RolloutUnit *unit = &units[index];
+            if (unit->soldiers <= 0 || unit->attack_range <= 0) continue;
+            double action_points = half == 0 ? unit->action_points : unit->max_action_points;
+
+            int target = rollout_pick_target(units, count, index, rng, candidates);
+            if (target < 0) {
+                rollout_advance(board, units, count, index, occupied, &action_points, rng);
+                target = rollout_pick_target(units, count, index, rng, candidates);
+            }
+            if (target >= 0 && action_points >= rollout_attack_cost(board, unit, &units[target])) {
+                rollout_resolve_attack(board, units, index, target, occupied);
+            }
+        }
+    }
+
+    double own_ratio = baseline[0] > 0 ? rollout_strength(units, count, 0) / baseline[0] : 0.0;
+    double enemy_ratio = baseline[1] > 0 ? rollout_strength(units, count, 1) / baseline[1] : 0.0;
+    return 0.5 + 0.5 * (own_ratio - enemy_ratio);
+}
+
+static int parse_rollout_terrain(PyObject *table_obj, RolloutTerrain *terrain_out) {
+    for (int i = 0; i < 100; i++) terrain_out[i] = (RolloutTerrain){0.0, 1.0, 0, 1.0};
+    PyObject *table = PySequence_Fast(table_obj, "terrain_table must be a sequence");
+    if (!table) return 0;
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(table);
+    for (Py_ssize_t i = 0; i < size && i < 100; i++) {
+        RolloutTerrain *terrain = &terrain_out[i];
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(table, i), "ddid", &terrain->defense_bonus,
+                              &terrain->frontage, &terrain->is_hills, &terrain->movement_cost)) {
+            Py_DECREF(table);
+            return 0;
+        }
+    }
+    Py_DECREF(table);
+    return 1;
+}
+
+static int parse_rollout_unit(PyObject *item, int profile_count, int width, int height, RolloutUnit *out) {
+    if (!PyArg_ParseTuple(item, "iiiiiiidddddidddidddid",
+                          &out->x, &out->y, &out->side, &out->profile, &out->kind,
+                          &out->soldiers, &out->max_soldiers, &out->formation_width,
+                          &out->attack_per_soldier, &out->morale_factor, &out->counter_morale_factor,
+                          &out->cohesion_factor, &out->disrupted, &out->damage_modifier,
+                          &out->defense, &out->base_defense, &out->garrisoned,
+                          &out->action_points, &out->max_action_points, &out->attack_cost,
+                          &out->attack_range, &out->value)) {
+        return 0;
+    }
+    if (out->profile < 0 || out->profile >= profile_count) {
+        PyErr_SetString(PyExc_ValueError, "rollout unit references unknown profile");
+        return 0;
+    }
+    if (out->side != 0 && out->side != 1) {
+        PyErr_SetString(PyExc_ValueError, "rollout unit side must be 0 or 1");
+        return 0;
+    }
+    if (out->x < 0 || out->x >= width || out->y < 0 || out->y >= height) {
+        PyErr_SetString(PyExc_ValueError, "rollout unit is outside the board");
+        return 0;
+    }
+    return 1;
+}
+
+static PyObject* c_simulate_battle(PyObject* self, PyObject* args) {
+    int width, height;
+    PyObject *terrain_grid_obj;
+    PyObject *cost_profiles_obj;
+    PyObject *combat_profiles_obj;
+    PyObject *terrain_table_obj;
+    PyObject *units_obj;
+    PyObject *blockers_list_obj;
+    double baseline[2];
+    int turns, rollouts;
+    unsigned long long seed;
+
+    if (!PyArg_ParseTuple(args, "iiOOOOOO(dd)iiK",
+        &width, &height, &terrain_grid_obj, &cost_profiles_obj, &combat_profiles_obj,
+        &terrain_table_obj, &units_obj, &blockers_list_obj, &baseline[0], &baseline[1],
+        &turns, &rollouts, &seed)) {
+        return NULL;
+    }
+    if (width <= 0 || height <= 0) {
+        PyErr_SetString(PyExc_ValueError, "board dimensions must be positive");
+        return NULL;
+    }
+    if (turns < 0 || rollouts <= 0) {
+        PyErr_SetString(PyExc_ValueError, "turns must be >= 0 and rollouts > 0");
+        return NULL;
+    }
+
+    int *grid = NULL;
+    int *blocked = NULL;
+    double unused_costs[100];
+    if (!parse_common_args(width, height, terrain_grid_obj, Py_None, blockers_list_obj,
+                          &grid, unused_costs, &blocked)) {
+        return NULL;
+    }
+
+    PyObject *profiles_seq = PySequence_Fast(cost_profiles_obj, "cost_profiles must be a sequence");
+    PyObject *combat_seq = profiles_seq ? PySequence_Fast(combat_profiles_obj, "combat_profiles must be a sequence") : NULL;
+    PyObject *units_seq = combat_seq ? PySequence_Fast(units_obj, "units must be a sequence") : NULL;
+    if (!units_seq) {
+        Py_XDECREF(profiles_seq);
+        Py_XDECREF(combat_seq);
+        free(grid); free(blocked);
+        return NULL;
+    }
+
+    int map_size = width * height;
+    Py_ssize_t profile_count = PySequence_Fast_GET_SIZE(profiles_seq);
+    int count = (int)PySequence_Fast_GET_SIZE(units_seq);
+    int slots = count > 0 ? count : 1;
+    double *cost_profiles = (double*)malloc(sizeof(double) * 100 * (profile_count > 0 ? profile_count : 1));
+    double *combat_profiles = (double*)malloc(sizeof(double) * 100 * (profile_count > 0 ? profile_count : 1));
+    RolloutTerrain *terrain = (RolloutTerrain*)malloc(sizeof(RolloutTerrain) * 100);
+    RolloutUnit *initial = (RolloutUnit*)malloc(sizeof(RolloutUnit) * slots);
+    RolloutUnit *units = (RolloutUnit*)malloc(sizeof(RolloutUnit) * slots);
+    int *occupied = (int*)malloc(sizeof(int) * map_size);
+    int *order = (int*)malloc(sizeof(int) * slots);
+    int *candidates = (int*)malloc(sizeof(int) * slots);
+    PyObject *result = NULL;
+
+    if (!cost_profiles || !combat_profiles || !terrain || !initial || !units ||
+        !occupied || !order || !candidates) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+    if (PySequence_Fast_GET_SIZE(combat_seq) != profile_count) {
+        PyErr_SetString(PyExc_ValueError, "combat_profiles must match cost_profiles");
+        goto cleanup;
+    }
+    for (Py_ssize_t p = 0; p < profile_count; p++) {
+        if (!parse_cost_profile(PySequence_Fast_GET_ITEM(profiles_seq, p), cost_profiles + 100 * p) ||
+            !parse_cost_profile(PySequence_Fast_GET_ITEM(combat_seq, p), combat_profiles + 100 * p)) {
+            goto cleanup;
+        }
+    }
+    if (!parse_rollout_terrain(terrain_table_obj, terrain)) goto cleanup;
+    for (int i = 0; i < count; i++) {
+        if (!parse_rollout_unit(PySequence_Fast_GET_ITEM(units_seq, i), (int)profile_count,
+                                width, height, &initial[i])) {
+            goto cleanup;
+        }
+    }
+
+    RolloutBoard board = {width, height, grid, blocked, cost_profiles, combat_profiles, terrain};
+    unsigned long long rng = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    double total = 0.0;
+
+    Py_BEGIN_ALLOW_THREADS
+    for (int r = 0; r < rollouts; r++) {
+        total += rollout_play(&board, initial, units, count, turns, baseline, occupied, order, candidates, &rng);
+    }
+    Py_END_ALLOW_THREADS
+
+    result = PyFloat_FromDouble(total / rollouts);
+
+cleanup:
+    free(cost_profiles); free(combat_profiles); free(terrain);
+    free(initial); free(units); free(occupied); free(order); free(candidates);
+    free(grid); free(blocked);
+    Py_DECREF(profiles_seq);
+    Py_DECREF(combat_seq);
+    Py_DECREF(units_seq);
+    return result;
+}
+
+// --- Batch Combat Evaluation ---
+
+#define COMBAT_MODE_NONE 0
+#define COMBAT_MODE_RANGED 1
+#define COMBAT_MODE_MELEE 2
+#define COMBAT_MODE_SKIRMISH 3
+#define COMBAT_MODE_CHARGE 4
+
+typedef struct {
+    int x;
+    int y;
+    int kind;
+    int profile;
+    int soldiers;
+    double formation_width;
+    double attack_per_soldier;
+    double morale;
+    double raw_morale;
+    double morale_bonus;
+    double cohesion;
+    double max_cohesion;
+    int disrupted;
+    double damage_modifier;
+    double defense;
+    double base_defense;
+    int garrisoned;
+    int routing;
+    int attack_range;
+} CombatSnapshot;
+
+typedef struct {
+    double cohesion_min_factor;
+    double morale_casualty_scale;
+    double morale_casualty_ratio_scale;
+    double cohesion_casualty_scale;
+    double cohesion_casualty_ratio_scale;
+    double morale_shock[5];
+    double cohesion_shock[5];
+} CombatRules;
+
+typedef struct {
+    int attacker;
+    int target;
+    int attacker_terrain;
+    int target_terrain;
+    int mode;
+    // AttackArc modifiers of the target's facing, looked up by the caller
+    double arc_damage;
+    double arc_morale;
+    double arc_cohesion;
+} CombatPair;
+
+static int combat_effective_soldiers(const CombatSnapshot *unit, const RolloutTerrain *terrain) {
+    int width = (int)(unit->formation_width * (terrain ? terrain->frontage : 1.0));
+    return width < unit->soldiers ? width : unit->soldiers;
+}
+
+static double combat_modifier(const double *combat_profiles, const CombatSnapshot *unit, int terrain_id) {
+    if (terrain_id < 0 || terrain_id >= 100) return 1.0;
+    return combat_profiles[100 * unit->profile + terrain_id];
+}
+
+// AttackBehavior.calculate_damage
+static int combat_damage(const RolloutTerrain *terrain, const double *combat_profiles, const CombatRules *rules,
+                         const CombatSnapshot *attacker, const CombatSnapshot *target, const CombatPair *pair) {
+    const RolloutTerrain *attacker_terrain = pair->attacker_terrain >= 0 ? &terrain[pair->attacker_terrain] : NULL;
+    const RolloutTerrain *target_terrain = pair->target_terrain >= 0 ? &terrain[pair->target_terrain] : NULL;
+    int attacking_soldiers = combat_effective_soldiers(attacker, attacker_terrain);
+
+    double base_damage = attacking_soldiers * attacker->attack_per_soldier;
+    if (pair->mode == COMBAT_MODE_CHARGE) {
+        base_damage *= 1.3;
+    } else if (pair->mode == COMBAT_MODE_SKIRMISH) {
+        base_damage *= 0.8;
+    }
+    if (attacker_terrain) base_damage *= combat_modifier(combat_profiles, attacker, pair->attacker_terrain);
+    base_damage *= (attacker->morale / 100);
+    double cohesion_ratio = attacker->cohesion / attacker->max_cohesion;
+    base_damage *= cohesion_ratio > rules->cohesion_min_factor ? cohesion_ratio : rules->cohesion_min_factor;
+    if (attacker->disrupted) base_damage *= 0.5;
+    base_damage *= attacker->damage_modifier;
+
+    base_damage *= pair->arc_damage;
+
+    if (attacker->attack_range > 1 && attacker_terrain && target_terrain) {
+        if (!attacker_terrain->is_hills && target_terrain->is_hills) {
+            base_damage = (int)(base_damage * 0.5);
+        } else if (attacker_terrain->is_hills && !target_terrain->is_hills) {
+            base_damage = (int)(base_damage * 1.5);
+        }
+    }
+
+    double target_defense = target->defense;
+    if (target_terrain) target_defense += target_terrain->defense_bonus;
+    if (target->disrupted) target_defense *= 0.5;
+    if (target->garrisoned) target_defense += 20;
+
+    double total = base_damage + target_defense;
+    double damage_ratio = total != 0.0 ? base_damage / total : 0.0;
+    int casualties = (int)(damage_ratio * attacking_soldiers * 0.25);
+
+    if (attacker->kind == UNIT_CAVALRY && target->kind == UNIT_ARCHER) {
+        casualties = (int)(casualties * 1.5);
+    } else if (attacker->kind == UNIT_ARCHER && target->kind == UNIT_WARRIOR) {
+        casualties = (int)(casualties * 0.8);
+    }
+    return casualties < target->soldiers ? casualties : target->soldiers;
+}
+
+// AttackBehavior.calculate_counter_damage, scaled by combat mode as AttackBehavior.execute does
+static int combat_counter_damage(const RolloutTerrain *terrain, const double *combat_profiles,
+                                 const CombatRules *rules, const CombatSnapshot *attacker,
+                                 const CombatSnapshot *defender, const CombatPair *pair) {
+    if (pair->mode == COMBAT_MODE_RANGED || defender->kind == UNIT_ARCHER) return 0;
+    const RolloutTerrain *defender_terrain = pair->target_terrain >= 0 ? &terrain[pair->target_terrain] : NULL;
+    const RolloutTerrain *attacker_terrain = pair->attacker_terrain >= 0 ? &terrain[pair->attacker_terrain] : NULL;
+    int defending_soldiers = combat_effective_soldiers(defender, defender_terrain);
+
+    double base_damage = defender->attack_per_soldier * defending_soldiers;
+    if (defender_terrain) base_damage *= combat_modifier(combat_profiles, defender, pair->target_terrain);
+    base_damage *= (defender->raw_morale / 200);
+    double cohesion_ratio = defender->cohesion / defender->max_cohesion;
+    base_damage *= cohesion_ratio > rules->cohesion_min_factor ? cohesion_ratio : rules->cohesion_min_factor;
+
+    double attacker_defense = attacker->base_defense;
+    if (attacker_terrain) attacker_defense += attacker_terrain->defense_bonus;
+
+    double total = base_damage + attacker_defense;
+    double damage_ratio = total != 0.0 ? base_damage / total : 0.0;
+    int casualties = (int)(damage_ratio * defending_soldiers * 0.15);
+
+    if (defender->kind == UNIT_WARRIOR && attacker->kind == UNIT_CAVALRY) {
+        casualties = (int)(casualties * 1.2);
+    }
+    if (casualties > attacker->soldiers) casualties = attacker->soldiers;
+
+    if (pair->mode == COMBAT_MODE_SKIRMISH) return (int)(casualties * 0.5);
+    if (pair->mode == COMBAT_MODE_CHARGE) return (int)(casualties * 0.75);
+    return casualties;
+}
+
+// Unit.take_casualties / StatsComponent.take_casualties morale and cohesion losses
+static void combat_casualty_losses(const CombatRules *rules, const CombatSnapshot *unit, int damage,
+                                   double *morale, double *cohesion) {
+    *morale = unit->raw_morale;
+    *cohesion = unit->cohesion;
+    if (damage <= 0 || unit->soldiers <= 0) return;
+    int amount = unit->routing ? (int)(damage * 0.7) : damage;
+    double casualty_ratio = (double)amount / unit->soldiers;
+    double morale_loss = rules->morale_casualty_scale * (1 - exp(-casualty_ratio / rules->morale_casualty_ratio_scale));
+    double cohesion_loss = rules->cohesion_casualty_scale * (1 - exp(-casualty_ratio / rules->cohesion_casualty_ratio_scale));
+    *morale = *morale - morale_loss > 0 ? *morale - morale_loss : 0;
+    *cohesion = *cohesion - cohesion_loss > 0 ? *cohesion - cohesion_loss : 0;
+}
+
+static void combat_evaluate_pair(const RolloutTerrain *terrain, const double *combat_profiles,
+                                 const CombatRules *rules, const CombatSnapshot *attacker,
+                                 const CombatSnapshot *target, const CombatPair *pair,
+                                 int *damage_out, int *counter_out, double *deltas_out) {
+    int damage = combat_damage(terrain, combat_profiles, rules, attacker, target, pair);
+    int counter = combat_counter_damage(terrain, combat_profiles, rules, attacker, target, pair);
+
+    double target_morale, target_cohesion;
+    combat_casualty_losses(rules, target, damage, &target_morale, &target_cohesion);
+
+    // CombatResolver._apply_extra_penalties goes through the morale property (with general bonus)
+    double extra_morale = rules->morale_shock[pair->mode] + pair->arc_morale;
+    double extra_cohesion = rules->cohesion_shock[pair->mode] + pair->arc_cohesion;
+    if (extra_morale > 0) {
+        double morale = target_morale + target->morale_bonus;
+        if (morale > 100) morale = 100;
+        target_morale = morale - extra_morale > 0 ? morale - extra_morale : 0;
+    }
+    if (extra_cohesion > 0) {
+        target_cohesion = target_cohesion - extra_cohesion > 0 ? target_cohesion - extra_cohesion : 0;
+    }
+
+    double attacker_morale, attacker_cohesion;
+    combat_casualty_losses(rules, attacker, counter, &attacker_morale, &attacker_cohesion);
+
+    *damage_out = damage;
+    *counter_out = counter;
+    deltas_out[0] = target_morale - target->raw_morale;
+    deltas_out[1] = target_cohesion - target->cohesion;
+    deltas_out[2] = attacker_morale - attacker->raw_morale;
+    deltas_out[3] = attacker_cohesion - attacker->cohesion;
+}
+
+static int parse_combat_snapshot(PyObject *item, int profile_count, CombatSnapshot *out) {
+    if (!PyArg_ParseTuple(item, "iiiiidddddddidddiii",
+                          &out->x, &out->y, &out->kind, &out->profile, &out->soldiers,
+                          &out->formation_width, &out->attack_per_soldier, &out->morale,
+                          &out->raw_morale, &out->morale_bonus, &out->cohesion, &out->max_cohesion,
+                          &out->disrupted, &out->damage_modifier, &out->defense, &out->base_defense,
+                          &out->garrisoned, &out->routing, &out->attack_range)) {
+        return 0;
+    }
+    if (out->profile < 0 || out->profile >= profile_count) {
+        PyErr_SetString(PyExc_ValueError, "combat snapshot references unknown combat profile");
+        return 0;
+    }
+    if (out->max_cohesion <= 0) {
+        PyErr_SetString(PyExc_ValueError, "max_cohesion must be positive for damage calculation");
+        return 0;
+    }
+    return 1;
+}
+
+static PyObject* c_evaluate_combat_batch(PyObject* self, PyObject* args) {
+    PyObject *terrain_table_obj;
+    PyObject *combat_profiles_obj;
+    PyObject *attackers_obj;
+    PyObject *targets_obj;
+    PyObject *attacker_terrain_obj;
+    PyObject *target_terrain_obj;
+    PyObject *modes_obj;
+    PyObject *arcs_obj;
+    CombatRules rules;
+
+    if (!PyArg_ParseTuple(args, "OO(ddddd(dddd)(dddd))OOOOOO",
+        &terrain_table_obj, &combat_profiles_obj,
+        &rules.cohesion_min_factor, &rules.morale_casualty_scale, &rules.morale_casualty_ratio_scale,
+        &rules.cohesion_casualty_scale, &rules.cohesion_casualty_ratio_scale,
+        &rules.morale_shock[1], &rules.morale_shock[2], &rules.morale_shock[3], &rules.morale_shock[4],
+        &rules.cohesion_shock[1], &rules.cohesion_shock[2], &rules.cohesion_shock[3], &rules.cohesion_shock[4],
+        &attackers_obj, &targets_obj, &attacker_terrain_obj, &target_terrain_obj, &modes_obj, &arcs_obj)) {
+        return NULL;
+    }
+    rules.morale_shock[COMBAT_MODE_NONE] = 0.0;
+    rules.cohesion_shock[COMBAT_MODE_NONE] = 0.0;
+    if (rules.morale_casualty_ratio_scale <= 0 || rules.cohesion_casualty_ratio_scale <= 0) {
+        PyErr_SetString(PyExc_ValueError, "casualty ratio scales must be positive");
+        return NULL;
+    }
+
+    PyObject *combat_seq = PySequence_Fast(combat_profiles_obj, "combat_profiles must be a sequence");
+    PyObject *attackers_seq = combat_seq ? PySequence_Fast(attackers_obj, "attackers must be a sequence") : NULL;
+    PyObject *targets_seq = attackers_seq ? PySequence_Fast(targets_obj, "targets must be a sequence") : NULL;
+    PyObject *attacker_terrain_seq = targets_seq ? PySequence_Fast(attacker_terrain_obj, "attacker_terrain must be a sequence") : NULL;
+    PyObject *target_terrain_seq = attacker_terrain_seq ? PySequence_Fast(target_terrain_obj, "target_terrain must be a sequence") : NULL;
+    PyObject *modes_seq = target_terrain_seq ? PySequence_Fast(modes_obj, "modes must be a sequence") : NULL;
+    PyObject *arcs_seq = modes_seq ? PySequence_Fast(arcs_obj, "arcs must be a sequence") : NULL;
+    if (!arcs_seq) {
+        Py_XDECREF(combat_seq);
+        Py_XDECREF(attackers_seq);
+        Py_XDECREF(targets_seq);
+        Py_XDECREF(attacker_terrain_seq);
+        Py_XDECREF(target_terrain_seq);
+        Py_XDECREF(modes_seq);
+        return NULL;
+    }
+
+    Py_ssize_t profile_count = PySequence_Fast_GET_SIZE(combat_seq);
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(attackers_seq);
+    Py_ssize_t slots = count > 0 ? count : 1;
+    double *combat_profiles = (double*)malloc(sizeof(double) * 100 * (profile_count > 0 ? profile_count : 1));
+    RolloutTerrain *terrain = (RolloutTerrain*)malloc(sizeof(RolloutTerrain) * 100);
+    CombatSnapshot *attackers = (CombatSnapshot*)malloc(sizeof(CombatSnapshot) * slots);
+    CombatSnapshot *targets = (CombatSnapshot*)malloc(sizeof(CombatSnapshot) * slots);
+    CombatPair *pairs = (CombatPair*)malloc(sizeof(CombatPair) * slots);
+    int *damage = (int*)malloc(sizeof(int) * slots);
+    int *counter = (int*)malloc(sizeof(int) * slots);
+    double *deltas = (double*)malloc(sizeof(double) * 4 * slots);
+    double *columns = (double*)malloc(sizeof(double) * 4 * slots);
+    PyObject *result = NULL;
+
+    if (!combat_profiles || !terrain || !attackers || !targets || !pairs ||
+        !damage || !counter || !deltas || !columns) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+    if (PySequence_Fast_GET_SIZE(targets_seq) != count ||
+        PySequence_Fast_GET_SIZE(attacker_terrain_seq) != count ||
+        PySequence_Fast_GET_SIZE(target_terrain_seq) != count ||
+        PySequence_Fast_GET_SIZE(modes_seq) != count ||
+        PySequence_Fast_GET_SIZE(arcs_seq) != count) {
+        PyErr_SetString(PyExc_ValueError, "combat batch arrays must have the same length");
+        goto cleanup;
+    }
+    for (Py_ssize_t p = 0; p < profile_count; p++) {
+        if (!parse_cost_profile(PySequence_Fast_GET_ITEM(combat_seq, p), combat_profiles + 100 * p)) {
+            goto cleanup;
+        }
+    }
+    if (!parse_rollout_terrain(terrain_table_obj, terrain)) goto cleanup;
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        CombatPair *pair = &pairs[i];
+        if (!parse_combat_snapshot(PySequence_Fast_GET_ITEM(attackers_seq, i), (int)profile_count, &attackers[i]) ||
+            !parse_combat_snapshot(PySequence_Fast_GET_ITEM(targets_seq, i), (int)profile_count, &targets[i])) {
+            goto cleanup;
+        }
+        pair->attacker_terrain = (int)PyLong_AsLong(PySequence_Fast_GET_ITEM(attacker_terrain_seq, i));
+        pair->target_terrain = (int)PyLong_AsLong(PySequence_Fast_GET_ITEM(target_terrain_seq, i));
+        pair->mode = (int)PyLong_AsLong(PySequence_Fast_GET_ITEM(modes_seq, i));
+        if (PyErr_Occurred()) goto cleanup;
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(arcs_seq, i), "ddd",
+                              &pair->arc_damage, &pair->arc_morale, &pair->arc_cohesion)) {
+            goto cleanup;
+        }
+        if (pair->mode < COMBAT_MODE_NONE || pair->mode > COMBAT_MODE_CHARGE) {
+            PyErr_SetString(PyExc_ValueError, "unknown combat mode code");
+            goto cleanup;
+        }
+        // Ids outside the terrain table mean "no terrain", as with the pathfinding grid
+        if (pair->attacker_terrain >= 100) pair->attacker_terrain = -1;
+        if (pair->target_terrain >= 100) pair->target_terrain = -1;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t i = 0; i < count; i++) {
+        combat_evaluate_pair(terrain, combat_profiles, &rules, &attackers[i], &targets[i], &pairs[i],
+                             &damage[i], &counter[i], &deltas[4 * i]);
+    }
+    // Column-major so each delta comes back as its own array
+    for (Py_ssize_t i = 0; i < count; i++) {
+        for (int c = 0; c < 4; c++) columns[c * count + i] = deltas[4 * i + c];
+    }
+    Py_END_ALLOW_THREADS
+
+    Py_ssize_t int_bytes = (Py_ssize_t)sizeof(int) * count;
+    Py_ssize_t double_bytes = (Py_ssize_t)sizeof(double) * count;
+    result = Py_BuildValue("(y#y#y#y#y#y#)",
+        (const char*)damage, int_bytes,
+        (const char*)counter, int_bytes,
+        (const char*)columns, double_bytes,
+        (const char*)(columns + count), double_bytes,
+        (const char*)(columns + 2 * count), double_bytes,
+        (const char*)(columns + 3 * count), double_bytes);
+
+cleanup:
+    free(combat_profiles); free(terrain); free(attackers); free(targets); free(pairs);
+    free(damage); free(counter); free(deltas); free(columns);
+    Py_DECREF(combat_seq);
+    Py_DECREF(attackers_seq);
+    Py_DECREF(targets_seq);
+    Py_DECREF(attacker_terrain_seq);
+    Py_DECREF(target_terrain_seq);
+    Py_DECREF(modes_seq);
+    Py_DECREF(arcs_seq);
+    return result;
+}
+
+// --- Terrain Noise ---
+
+// Python's hash((a, b, c)) for small ints, so seeded maps match TerrainGenerator
+// tile for tile (CPython's xxHash-based tuple hash, 64-bit builds).
+#define NOISE_HASH_MODULUS (((Py_uhash_t)1 << 61) - 1)
+#define NOISE_XXPRIME_1 ((Py_uhash_t)11400714785074694791ULL)
+#define NOISE_XXPRIME_2 ((Py_uhash_t)14029467366897019727ULL)
+#define NOISE_XXPRIME_5 ((Py_uhash_t)2870177450012600261ULL)
+
+static Py_hash_t noise_int_hash(long long value) {
+    Py_uhash_t magnitude = value < 0 ? (Py_uhash_t)0 - (Py_uhash_t)value : (Py_uhash_t)value;
+    Py_hash_t hash = (Py_hash_t)(magnitude % NOISE_HASH_MODULUS);
+    if (value < 0) hash = -hash;
+    return hash == -1 ? -2 : hash;
+}
+
+static double lattice_noise(long long x, long long y, long long seed) {
+    long long items[3] = {x * 1000, y * 1000, seed};
+    Py_uhash_t acc = NOISE_XXPRIME_5;
+    for (int i = 0; i < 3; i++) {
+        acc += (Py_uhash_t)noise_int_hash(items[i]) * NOISE_XXPRIME_2;
+        acc = (acc << 31) | (acc >> 33);
+        acc *= NOISE_XXPRIME_1;
+    }
+    acc += 3 ^ (NOISE_XXPRIME_5 ^ 3527539UL);
+    Py_hash_t hash = acc == (Py_uhash_t)-1 ? 1546275796 : (Py_hash_t)acc;
+    // Python's floored modulo
+    long long bucket = hash % 10000;
+    if (bucket < 0) bucket += 10000;
+    return bucket / 5000.0 - 1.0;
+}
+
+static double smooth_interpolate(double a, double b, double t) {
+    t = t * t * (3 - 2 * t);
+    return a + t * (b - a);
+}
+
+// Lattice noise for x0 = 0..count-1 on one lattice row
+static void fill_lattice_row(double *out, int count, long long y0, long long seed) {
+    for (int i = 0; i < count; i++) out[i] = lattice_noise(i, y0, seed);
+}
+
+// Octave noise normalised to 0..1, row-major doubles. Octave k samples at
+// scale * 2^k with seed + seed_offset + 1000k and weight 0.5^k. Each row
+// reuses the two lattice rows around it, so hashing costs one call per
+// lattice point instead of four per tile.
+static PyObject* c_noise_map(PyObject* self, PyObject* args) {
+    int width, height, octaves;
+    long long seed;
+    double scale;
+
+    if (!PyArg_ParseTuple(args, "iiLdi", &width, &height, &seed, &scale, &octaves)) {
+        return NULL;
+    }
+    if (width <= 0 || height <= 0) {
+        PyErr_SetString(PyExc_ValueError, "noise map dimensions must be positive");
+        return NULL;
+    }
+    if (octaves < 1 || octaves > 30) {
+        PyErr_SetString(PyExc_ValueError, "noise map octaves must be between 1 and 30");
+        return NULL;
+    }
+    double frequency_max = scale * (double)(1 << (octaves - 1));
+    double extent = (double)(width > height ? width : height) * frequency_max;
+    if (!(scale >= 0) || !(extent < 1e8)) {
+        PyErr_SetString(PyExc_ValueError, "noise scale must be non-negative and keep the lattice small");
+        return NULL;
+    }
+
+    int map_size = width * height;
+    int lattice_count = (int)floor((width - 1) * frequency_max) + 2;
+    double *values = (double*)calloc(map_size, sizeof(double));
+    double *lattice_top = (double*)malloc(sizeof(double) * lattice_count);
+    double *lattice_bottom = (double*)malloc(sizeof(double) * lattice_count);
+    int *cell = (int*)malloc(sizeof(int) * width);
+    double *weight = (double*)malloc(sizeof(double) * width);
+    PyObject *result = NULL;
+
+    if (!values || !lattice_top || !lattice_bottom || !cell || !weight) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    double amplitude = 1.0;
+    double frequency = scale;
+    for (int octave = 0; octave < octaves; octave++) {
+        long long octave_seed = seed + 1000LL * octave;
+        int count = (int)floor((width - 1) * frequency) + 2;
+        for (int x = 0; x < width; x++) {
+            double fx = x * frequency;
+            cell[x] = (int)floor(fx);
+            weight[x] = fx - cell[x];
+        }
+
+        long long loaded_row = LLONG_MIN;
+        for (int y = 0; y < height; y++) {
+            double fy = y * frequency;
+            long long y0 = (long long)floor(fy);
+            double sy = fy - y0;
+            if (y0 != loaded_row) {
+                if (y0 == loaded_row + 1) {
+                    double *swap = lattice_top;
+                    lattice_top = lattice_bottom;
+                    lattice_bottom = swap;
+                } else {
+                    fill_lattice_row(lattice_top, count, y0, octave_seed);
+                }
+                fill_lattice_row(lattice_bottom, count, y0 + 1, octave_seed);
+                loaded_row = y0;
+            }
+
+            double *row = values + (Py_ssize_t)y * width;
+            for (int x = 0; x < width; x++) {
+                int x0 = cell[x];
+                double nx0 = smooth_interpolate(lattice_top[x0], lattice_top[x0 + 1], weight[x]);
+                double nx1 = smooth_interpolate(lattice_bottom[x0], lattice_bottom[x0 + 1], weight[x]);
+                row[x] += smooth_interpolate(nx0, nx1, sy) * amplitude;
+            }
+        }
+        amplitude *= 0.5;
+        frequency *= 2;
+    }
+
+    for (int i = 0; i < map_size; i++) values[i] = (values[i] + 1) / 2;
+    result = PyBytes_FromStringAndSize((const char*)values, (Py_ssize_t)(sizeof(double) * map_size));
+
+cleanup:
+    free(values); free(lattice_top); free(lattice_bottom); free(cell); free(weight);
+    return result;
+}
+
+// --- Campaign Terrain ---
+
+// Write code into every [min_x, max_x) x [min_y, max_y) rectangle of a
+// writable width*height byte grid, clipped to the grid. Later rectangles
+// overwrite earlier ones.
+static PyObject* c_fill_rects(PyObject* self, PyObject* args) {
+    int width, height;
+    PyObject *cells_obj;
+    unsigned char code;
+    PyObject *rects_obj;
+
+    if (!PyArg_ParseTuple(args, "iiObO", &width, &height, &cells_obj, &code, &rects_obj)) {
+        return NULL;
+    }
+    if (width < 0 || height < 0) {
+        PyErr_SetString(PyExc_ValueError, "grid dimensions must be non-negative");
+        return NULL;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(cells_obj, &view, PyBUF_SIMPLE | PyBUF_WRITABLE) < 0) return NULL;
+    if (view.len != (Py_ssize_t)width * height) {
+        PyErr_Format(PyExc_ValueError, "cells must have %d bytes, got %zd", width * height, view.len);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    unsigned char *cells = (unsigned char*)view.buf;
+
+    PyObject *iterator = PyObject_GetIter(rects_obj);
+    if (!iterator) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    PyObject *rect;
+    int failed = 0;
+    while (!failed && (rect = PyIter_Next(iterator))) {
+        PyObject *bounds = PySequence_Fast(rect, "rectangle must be a sequence");
+        Py_DECREF(rect);
+        if (!bounds) { failed = 1; break; }
+        if (PySequence_Fast_GET_SIZE(bounds) != 4) {
+            PyErr_SetString(PyExc_ValueError, "rectangle must be [min_x, max_x, min_y, max_y]");
+            Py_DECREF(bounds);
+            failed = 1;
+            break;
+        }
+        long v[4];
+        for (int i = 0; i < 4; i++) {
+            v[i] = PyLong_AsLong(PySequence_Fast_GET_ITEM(bounds, i));
+            if (v[i] == -1 && PyErr_Occurred()) failed = 1;
+        }
+        Py_DECREF(bounds);
+        if (failed) break;
+
+        long min_x = v[0] > 0 ? v[0] : 0, max_x = v[1] < width ? v[1] : width;
+        long min_y = v[2] > 0 ? v[2] : 0, max_y = v[3] < height ? v[3] : height;
+        if (min_x >= max_x) continue;
+        for (long y = min_y; y < max_y; y++) {
+            memset(cells + y * width + min_x, code, (size_t)(max_x - min_x));
+        }
+    }
+    Py_DECREF(iterator);
+    PyBuffer_Release(&view);
+    if (failed || PyErr_Occurred()) return NULL;
+    Py_RETURN_NONE;
+}
+
+// --- Campaign Routing ---
+
+typedef struct {
+    int tile;
+    double budget;
+} CampaignStart;
+
+// Bounded Dijkstra over a campaign terrain byte grid. Stop tiles (enemy
+// armies, cities and their zones of control) can be entered but not left,
+// except by the army standing on one at the start.
+static void campaign_search(int width, int height, const unsigned char *cells, const double *move_costs,
+                            const unsigned char *stop, CampaignStart start,
+                            double *min_costs, int *parents, unsigned char *closed, MinHeap *queue) {
+    int map_size = width * height;
+    for (int i = 0; i < map_size; i++) { min_costs[i] = INFINITY; parents[i] = -1; closed[i] = 0; }
+    queue->size = 0;
+
+    int even_row_dirs[6][2] = {{-1, -1}, {0, -1}, {1, 0}, {0, 1}, {-1, 1}, {-1, 0}};
+    int odd_row_dirs[6][2]  = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 0}};
+
+    min_costs[start.tile] = 0.0;
+    heap_push(queue, start.tile % width, start.tile / width, 0.0);
+
+    while (queue->size > 0) {
+        Node current = heap_pop(queue);
+        int c_idx = current.y * width + current.x;
+        if (current.priority > min_costs[c_idx]) continue;
+        if (closed[c_idx]) continue;
+        closed[c_idx] = 1;
+        if (stop && stop[c_idx] && c_idx != start.tile) continue;
+
+        int (*dirs)[2] = (current.y % 2 == 0) ? even_row_dirs : odd_row_dirs;
+        for (int i = 0; i < 6; i++) {
+            int nx = current.x + dirs[i][0];
+            int ny = current.y + dirs[i][1];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+            int n_idx = ny * width + nx;
+            if (closed[n_idx]) continue;
+            double new_cost = min_costs[c_idx] + move_costs[cells[n_idx]];
+            if (new_cost > start.budget) continue;
+            if (new_cost < min_costs[n_idx]) {
+                min_costs[n_idx] = new_cost;
+                parents[n_idx] = c_idx;
+                heap_push(queue, nx, ny, new_cost);
+            }
+        }
+    }
+}
+
+// Movement cost and parent planes for many armies on one campaign map.
+// move_costs is indexed by terrain code; codes past its end are impassable.
+// Returns one (costs, parents) pair of packed doubles and int32s per start.
+static PyObject* c_campaign_routes(PyObject* self, PyObject* args) {
+    int width, height;
+    PyObject *cells_obj;
+    PyObject *move_costs_obj;
+    PyObject *stop_obj;
+    PyObject *starts_obj;
+
+    if (!PyArg_ParseTuple(args, "iiOOOO",
+        &width, &height, &cells_obj, &move_costs_obj, &stop_obj, &starts_obj)) {
+        return NULL;
+    }
+    if (width <= 0 || height <= 0) {
+        PyErr_SetString(PyExc_ValueError, "campaign map dimensions must be positive");
+        return NULL;
+    }
+    int map_size = width * height;
+
+    double move_costs[256];
+    PyObject *costs_seq = PySequence_Fast(move_costs_obj, "move_costs must be a sequence");
+    if (!costs_seq) return NULL;
+    Py_ssize_t cost_count = PySequence_Fast_GET_SIZE(costs_seq);
+    if (cost_count > 256) {
+        Py_DECREF(costs_seq);
+        PyErr_SetString(PyExc_ValueError, "move_costs can hold at most 256 terrain codes");
+        return NULL;
+    }
+    for (int code = 0; code < 256; code++) {
+        double cost = INFINITY;
+        if (code < cost_count) {
+            cost = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(costs_seq, code));
+            if (cost == -1.0 && PyErr_Occurred()) {
+                Py_DECREF(costs_seq);
+                return NULL;
+            }
+            if (cost < 1.0) cost = 1.0;
+        }
+        move_costs[code] = cost;
+    }
+    Py_DECREF(costs_seq);
+
+    PyObject *starts_seq = PySequence_Fast(starts_obj, "starts must be a sequence");
+    if (!starts_seq) return NULL;
+    Py_ssize_t start_count = PySequence_Fast_GET_SIZE(starts_seq);
+
+    Py_buffer cells_view = {0};
+    Py_buffer stop_view = {0};
+    int have_cells = 0, have_stop = 0;
+    CampaignStart *starts = (CampaignStart*)malloc(sizeof(CampaignStart) * (start_count > 0 ? start_count : 1));
+    double *costs_out = (double*)malloc(sizeof(double) * map_size * (start_count > 0 ? start_count : 1));
+    int *parents_out = (int*)malloc(sizeof(int) * map_size * (start_count > 0 ? start_count : 1));
+    unsigned char *closed = (unsigned char*)malloc(map_size);
+    // Lazy deletion pushes at most one entry per relaxed edge plus the start
+    MinHeap *queue = create_heap(map_size * 7 + 1);
+    PyObject *result = NULL;
+
+    if (!starts || !costs_out || !parents_out || !closed || !queue || !queue->nodes) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    if (PyObject_GetBuffer(cells_obj, &cells_view, PyBUF_SIMPLE) < 0) goto cleanup;
+    have_cells = 1;
+    if (cells_view.len != map_size) {
+        PyErr_Format(PyExc_ValueError, "cells must have %d bytes, got %zd", map_size, cells_view.len);
+        goto cleanup;
+    }
+    if (stop_obj != Py_None) {
+        if (PyObject_GetBuffer(stop_obj, &stop_view, PyBUF_SIMPLE) < 0) goto cleanup;
+        have_stop = 1;
+        if (stop_view.len != map_size) {
+            PyErr_Format(PyExc_ValueError, "stop mask must have %d bytes, got %zd", map_size, stop_view.len);
+            goto cleanup;
+        }
+    }
+
+    for (Py_ssize_t s = 0; s < start_count; s++) {
+        int x, y;
+        double budget;
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(starts_seq, s), "iid", &x, &y, &budget)) {
+            goto cleanup;
+        }
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            PyErr_Format(PyExc_ValueError, "army at (%d, %d) is off the %dx%d map", x, y, width, height);
+            goto cleanup;
+        }
+        starts[s] = (CampaignStart){y * width + x, budget};
+    }
+
+    const unsigned char *cells = (const unsigned char*)cells_view.buf;
+    const unsigned char *stop = have_stop ? (const unsigned char*)stop_view.buf : NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t s = 0; s < start_count; s++) {
+        campaign_search(width, height, cells, move_costs, stop, starts[s],
+                        costs_out + map_size * s, parents_out + map_size * s, closed, queue);
+    }
+    Py_END_ALLOW_THREADS
+
+    result = PyList_New(start_count);
+    if (!result) goto cleanup;
+    for (Py_ssize_t s = 0; s < start_count; s++) {
+        PyObject *pair = Py_BuildValue("(y#y#)",
+            (const char*)(costs_out + map_size * s), (Py_ssize_t)(sizeof(double) * map_size),
+            (const char*)(parents_out + map_size * s), (Py_ssize_t)(sizeof(int) * map_size));
+        if (!pair) {
+            Py_CLEAR(result);
+            goto cleanup;
+        }
+        PyList_SET_ITEM(result, s, pair);
+    }
+
+cleanup:
+    if (have_cells) PyBuffer_Release(&cells_view);
+    if (have_stop) PyBuffer_Release(&stop_view);
+    if (queue) destroy_heap(queue);
+    free(starts); free(costs_out); free(parents_out); free(closed);
+    Py_DECREF(starts_seq);
+    return result;
+}
+
+// --- Campaign Cities ---
+
+// splitmix64 output mixer; matches _mix64 in game/campaign/city_table.py
+static unsigned long long mix64(unsigned long long x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// One turn of population growth for a whole city column, in place.
+// Row i grows by base_rates[specialization[i]] plus a jitter in
+// [-0.005, 0.005) drawn from the stream keyed by key, and never drops
+// below min_population. Returns the rate used per row as packed doubles.
+static PyObject* c_grow_population(PyObject* self, PyObject* args) {
+    PyObject *population_obj, *specialization_obj, *rates_obj;
+    unsigned long long key;
+    long long min_population;
+
+    if (!PyArg_ParseTuple(args, "OOOKL", &population_obj, &specialization_obj, &rates_obj,
+                          &key, &min_population)) {
+        return NULL;
+    }
+
+    PyObject *rates_seq = PySequence_Fast(rates_obj, "base_rates must be a sequence");
+    if (!rates_seq) return NULL;
+    Py_ssize_t rate_count = PySequence_Fast_GET_SIZE(rates_seq);
+    double *base_rates = (double*)malloc(sizeof(double) * (rate_count > 0 ? rate_count : 1));
+    if (!base_rates) {
+        Py_DECREF(rates_seq);
+        return PyErr_NoMemory();
+    }
+    for (Py_ssize_t i = 0; i < rate_count; i++) {
+        base_rates[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(rates_seq, i));
+        if (base_rates[i] == -1.0 && PyErr_Occurred()) {
+            free(base_rates);
+            Py_DECREF(rates_seq);
+            return NULL;
+        }
+    }
+    Py_DECREF(rates_seq);
+
+    Py_buffer population_view = {0};
+    Py_buffer specialization_view = {0};
+    int have_population = 0, have_specialization = 0;
+    double *rates_out = NULL;
+    PyObject *result = NULL;
+
+    if (PyObject_GetBuffer(population_obj, &population_view, PyBUF_FORMAT | PyBUF_WRITABLE) < 0) goto cleanup;
+    have_population = 1;
+    if (population_view.itemsize != sizeof(long long) || strcmp(population_view.format, "q") != 0) {
+        PyErr_SetString(PyExc_TypeError, "population must be an int64 buffer");
+        goto cleanup;
+    }
+    if (PyObject_GetBuffer(specialization_obj, &specialization_view, PyBUF_FORMAT) < 0) goto cleanup;
+    have_specialization = 1;
+    if (specialization_view.itemsize != sizeof(unsigned short) || strcmp(specialization_view.format, "H") != 0) {
+        PyErr_SetString(PyExc_TypeError, "specialization must be a uint16 buffer");
+        goto cleanup;
+    }
+
+    Py_ssize_t count = population_view.len / (Py_ssize_t)sizeof(long long);
+    if (specialization_view.len / (Py_ssize_t)sizeof(unsigned short) != count) {
+        PyErr_SetString(PyExc_ValueError, "population and specialization columns differ in length");
+        goto cleanup;
+    }
+    long long *population = (long long*)population_view.buf;
+    const unsigned short *specialization = (const unsigned short*)specialization_view.buf;
+    for (Py_ssize_t i = 0; i < count; i++) {
+        if (specialization[i] >= rate_count) {
+            PyErr_Format(PyExc_ValueError, "specialization id %d has no growth rate", (int)specialization[i]);
+            goto cleanup;
+        }
+    }
+
+    rates_out = (double*)malloc(sizeof(double) * (count > 0 ? count : 1));
+    if (!rates_out) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t i = 0; i < count; i++) {
+        unsigned long long draw = mix64(key + (unsigned long long)(i + 1) * 0x9E3779B97F4A7C15ULL);
+        double uniform = (double)(draw >> 11) * (1.0 / 9007199254740992.0);
+        double rate = base_rates[specialization[i]] + (uniform - 0.5) * 0.01;
+        long long current = population[i];
+        long long grown = current + (long long)((double)current * rate);
+        population[i] = grown > min_population ? grown : min_population;
+        rates_out[i] = rate;
+    }
+    Py_END_ALLOW_THREADS
+
+    result = PyBytes_FromStringAndSize((const char*)rates_out, (Py_ssize_t)(sizeof(double) * count));
+
+cleanup:
+    if (have_population) PyBuffer_Release(&population_view);
+    if (have_specialization) PyBuffer_Release(&specialization_view);
+    free(rates_out);
+    free(base_rates);
+    return result;
+}
+
+// Sum an int64 column per uint16 group id. Returns group_count packed int64 totals.
+static PyObject* c_group_sums(PyObject* self, PyObject* args) {
+    PyObject *values_obj, *groups_obj;
+    int group_count;
+
+    if (!PyArg_ParseTuple(args, "OOi", &values_obj, &groups_obj, &group_count)) return NULL;
+    if (group_count < 0) {
+        PyErr_SetString(PyExc_ValueError, "group_count must be non-negative");
+        return NULL;
+    }
+
+    Py_buffer values_view = {0};
+    Py_buffer groups_view = {0};
+    int have_values = 0, have_groups = 0;
+    long long *totals = (long long*)calloc(group_count > 0 ? group_count : 1, sizeof(long long));
+    PyObject *result = NULL;
+    if (!totals) return PyErr_NoMemory();
+
+    if (PyObject_GetBuffer(values_obj, &values_view, PyBUF_FORMAT) < 0) goto cleanup;
+    have_values = 1;
+    if (values_view.itemsize != sizeof(long long) || strcmp(values_view.format, "q") != 0) {
+        PyErr_SetString(PyExc_TypeError, "values must be an int64 buffer");
+        goto cleanup;
+    }
+    if (PyObject_GetBuffer(groups_obj, &groups_view, PyBUF_FORMAT) < 0) goto cleanup;
+    have_groups = 1;
+    if (groups_view.itemsize != sizeof(unsigned short) || strcmp(groups_view.format, "H") != 0) {
+        PyErr_SetString(PyExc_TypeError, "groups must be a uint16 buffer");
+        goto cleanup;
+    }
+
+    Py_ssize_t count = values_view.len / (Py_ssize_t)sizeof(long long);
+    Py_ssize_t group_rows = groups_view.len / (Py_ssize_t)sizeof(unsigned short);
+    if (group_rows < count) count = group_rows;
+    const long long *values = (const long long*)values_view.buf;
+    const unsigned short *groups = (const unsigned short*)groups_view.buf;
+    for (Py_ssize_t i = 0; i < count; i++) {
+        if (groups[i] >= group_count) {
+            PyErr_Format(PyExc_ValueError, "group id %d out of range", (int)groups[i]);
+            goto cleanup;
+        }
+        totals[groups[i]] += values[i];
+    }
+
+    result = PyBytes_FromStringAndSize((const char*)totals, (Py_ssize_t)(sizeof(long long) * group_count));
+
+cleanup:
+    if (have_values) PyBuffer_Release(&values_view);
+    if (have_groups) PyBuffer_Release(&groups_view);
+    free(totals);
+    return result;
+}
+
 static PyMethodDef AlgorithmsMethods[] = {
     {"find_path", c_find_path, METH_VARARGS, "A* pathfinding"},
     {"find_reachable", c_find_reachable, METH_VARARGS, "Dijkstra reachable tiles"},
+    {"compute_threat_map", c_compute_threat_map, METH_VARARGS, "Multi-source threat and influence maps"},
+    {"compute_flee_field", c_compute_flee_field, METH_VARARGS, "Lowest cost any source pays to reach each tile"},
+    {"simulate_battle", c_simulate_battle, METH_VARARGS, "Mean reward of greedy battle playouts"},
+    {"evaluate_combat_batch", c_evaluate_combat_batch, METH_VARARGS, "Expected outcomes of many attacks"},
+    {"noise_map", c_noise_map, METH_VARARGS, "Seeded multi-octave terrain noise"},
+    {"fill_rects", c_fill_rects, METH_VARARGS, "Fill rectangles of a byte grid"},
+    {"campaign_routes", c_campaign_routes, METH_VARARGS, "Campaign movement costs and paths for many armies"},
+    {"grow_population", c_grow_population, METH_VARARGS, "One turn of seeded population growth over a city column"},
+    {"group_sums", c_group_sums, METH_VARARGS, "Sum an int64 column per group id"},
     {NULL, NULL, 0, NULL}
 };
 
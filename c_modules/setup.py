@@ -1,6 +1,12 @@
+import sys
+
 from setuptools import setup, Extension
 
-module = Extension('c_algorithms', sources=['c_modules/c_algorithms.c'])
+# Terrain noise must round exactly like the Python generator: no fused multiply-add
+extra_compile_args = [] if sys.platform == 'win32' else ['-ffp-contract=off']
+
+module = Extension('c_algorithms', sources=['c_modules/c_algorithms.c'],
+                   extra_compile_args=extra_compile_args)
 
 setup(
     name='c_algorithms',
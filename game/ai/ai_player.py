@@ -1,74 +1,162 @@
+import itertools
 import random
+import weakref
 from game.entities.knight import KnightClass
 from game.hex_utils import HexCoord, HexGrid
 from game.components.facing import FacingDirection
 from game.visibility import VisibilityState
+from game.ai.battle_snapshot import BattleSnapshot
+from game.ai.move_cache import MoveGenerationCache
+from game.ai.move_ordering import MoveOrderingHeuristics
+from game.ai.staged_moves import StagedMoveGenerator
+from game.ai.incremental_evaluation import IncrementalEvaluator
+from game.ai.mcts import MonteCarloTreeSearch
+from game.systems.threat_map import ThreatMap
+from game.battle.adapters.shared_battle_state import SharedBattleState
 
 class AIPlayer:
-    def __init__(self, player_id, difficulty='easy'):
+    # Moves examined per interior search node; killer/history ordering keeps
+    # good quiet moves inside this window.
+    SEARCH_WIDTH = 12
+    # Width used when ordering only by attack value
+    UNORDERED_SEARCH_WIDTH = 10
+    # Facing score of a tile within FACING_RANGE that an enemy holds or can
+    # reach next turn, by the arc it lies in; divided by distance plus turns
+    FACING_EXPOSURE = {'rear': -30, 'flank': -15, 'front': 5}
+    FACING_RANGE = 3
+    # Worth of a full-strength unit, also used to score MCTS playouts
+    UNIT_BASE_VALUES = {
+        KnightClass.WARRIOR: 100,
+        KnightClass.ARCHER: 120,
+        KnightClass.CAVALRY: 110,
+        KnightClass.MAGE: 150
+    }
+    # Search depth per alpha-beta difficulty; 'mcts' searches for thinking_time seconds
+    # (or mcts_iterations playouts) instead
+    SEARCH_DEPTHS = {'easy': 1, 'medium': 2, 'hard': 3}
+    # Quiescence search: nodes spent resolving exchanges below one leaf, and
+    # how many alternating attack/charge plies it may follow
+    QUIESCENCE_NODE_BUDGET = 24
+    QUIESCENCE_MAX_PLY = 4
+
+    def __init__(self, player_id, difficulty='easy', use_search_heuristics=True,
+                 use_incremental_evaluation=True, use_quiescence=True, mcts_seed=None):
         self.player_id = player_id
         self.difficulty = difficulty
         self.thinking_time = 0.5
+        # Playouts per MCTS decision; when set, the search ignores thinking_time
+        # and, with mcts_seed, repeats exactly
+        self.mcts_iterations = None
+        self._mcts = MonteCarloTreeSearch(self, seed=mcts_seed)
         self._hex_grid = HexGrid()
+        # Killer/history move ordering; can be disabled for benchmarking
+        self.use_search_heuristics = use_search_heuristics
+        self.search_width = self.SEARCH_WIDTH if use_search_heuristics else self.UNORDERED_SEARCH_WIDTH
+        self._move_ordering = MoveOrderingHeuristics()
+        self.nodes_searched = 0
+        # Units whose reachable tiles the search computed
+        self.units_expanded = 0
+        # Resolve pending attacks and charges at the search horizon
+        self.use_quiescence = use_quiescence
+        self._quiescence_nodes = 0
+        # Per-unit evaluation terms updated along the search tree
+        self.use_incremental_evaluation = use_incremental_evaluation
+        self._evaluator = IncrementalEvaluator(self)
+        # Enemy reach at the root of the current search
+        self._threat_map = None
+        # Move generation cache, only valid for the live state of the current turn
+        self._move_cache = MoveGenerationCache()
+        self._move_cache_state = None
+        # Forked caches for simulated states (MCTS tree nodes)
+        self._search_move_caches = weakref.WeakKeyDictionary()
 
     def evaluate_position(self, game_state):
-        score = 0
-        
         if not hasattr(game_state, 'fog_of_war'):
             raise AttributeError("game_state.fog_of_war is required for AI evaluation")
+
+        if self._threat_map is None:
+            # Outside a search: threats of this position only
+            self._threat_map = self._build_threat_map(game_state)
+            try:
+                return self._evaluate_terms(game_state)
+            finally:
+                self._threat_map = None
+        return self._evaluate_terms(game_state)
+
+    def _evaluate_terms(self, game_state):
+        if self.use_incremental_evaluation:
+            return self._evaluator.evaluate(game_state)
+
+        return self._combine_evaluation_terms(
+            game_state,
+            [self._unit_contribution(knight, game_state) for knight in game_state.knights],
+            [self._castle_range_hits(knight, game_state) for knight in game_state.knights],
+        )
+
+    def _unit_contribution(self, knight, game_state):
+        """Signed value, position and line terms of one knight (0 if not visible)"""
         fog_of_war = game_state.fog_of_war
-        
-        for knight in game_state.knights:
-            # Only evaluate units we can see
-            if fog_of_war and knight.player_id != self.player_id:
-                visibility = fog_of_war.get_visibility_state(self.player_id, knight.x, knight.y)
-                if visibility not in [VisibilityState.VISIBLE, VisibilityState.PARTIAL]:
-                    continue  # Skip invisible units
-            
-            knight_value = self._get_knight_value(knight)
-            position_bonus = self._get_position_bonus(knight, game_state)
-            
-            if knight.player_id == self.player_id:
-                line_bonus = self._get_line_bonus(knight, game_state)
-                score += knight_value + position_bonus + line_bonus
-            else:
-                line_bonus = self._get_line_bonus(knight, game_state)
-                score -= knight_value + position_bonus + line_bonus
-        
+
+        # Only evaluate units we can see
+        if fog_of_war and knight.player_id != self.player_id:
+            visibility = fog_of_war.get_visibility_state(self.player_id, knight.x, knight.y)
+            if visibility not in [VisibilityState.VISIBLE, VisibilityState.PARTIAL]:
+                return 0  # Skip invisible units
+
+        knight_value = self._get_knight_value(knight)
+        position_bonus = self._get_position_bonus(knight, game_state)
+        line_bonus = self._get_line_bonus(knight, game_state)
+
+        if knight.player_id == self.player_id:
+            return knight_value + position_bonus + line_bonus
+        return -(knight_value + position_bonus + line_bonus)
+
+    def _build_threat_map(self, game_state):
+        return ThreatMap.build(game_state, self.player_id, fog_of_war=game_state.fog_of_war)
+
+    def _castle_range_hits(self, knight, game_state):
+        """Indices of enemy castles whose archers cover one of our knights"""
+        if knight.player_id != self.player_id:
+            return ()
+
+        hits = []
+        knight_hex = self._hex_grid.offset_to_axial(knight.x, knight.y)
+        for i, castle in enumerate(game_state.castles):
+            if castle.player_id == self.player_id:
+                continue
+            # Check hex distance to any castle tile
+            min_distance = float('inf')
+            for tile_x, tile_y in castle.occupied_tiles:
+                castle_hex = self._hex_grid.offset_to_axial(tile_x, tile_y)
+                distance = knight_hex.distance_to(castle_hex)
+                min_distance = min(min_distance, distance)
+            if min_distance <= castle.arrow_range and castle.get_total_archer_soldiers() > 0:
+                hits.append(i)
+        return tuple(hits)
+
+    def _combine_evaluation_terms(self, game_state, contributions, castle_hits):
+        """Sum per-knight terms in knight order, then apply castle terms"""
+        score = 0
+        for contribution in contributions:
+            score += contribution
+
         for i, castle in enumerate(game_state.castles):
             castle_value = (castle.health / castle.max_health) * 1000
             if (i == 0 and self.player_id == 1) or (i == 1 and self.player_id == 2):
                 score += castle_value
             else:
                 score -= castle_value
-                
+
             # Penalty for having knights in enemy castle range
             if castle.player_id != self.player_id:
-                for knight in game_state.knights:
-                    if knight.player_id == self.player_id:
-                        # Check hex distance to any castle tile
-                        hex_grid = HexGrid()
-                        knight_hex = hex_grid.offset_to_axial(knight.x, knight.y)
-                        min_distance = float('inf')
-                        
-                        for tile_x, tile_y in castle.occupied_tiles:
-                            castle_hex = hex_grid.offset_to_axial(tile_x, tile_y)
-                            distance = knight_hex.distance_to(castle_hex)
-                            min_distance = min(min_distance, distance)
-                        if min_distance <= castle.arrow_range and castle.get_total_archer_soldiers() > 0:
-                            score -= 15
-        
+                for hits in castle_hits:
+                    if i in hits:
+                        score -= 15
+
         return score
     
     def _get_knight_value(self, knight):
-        base_values = {
-            KnightClass.WARRIOR: 100,
-            KnightClass.ARCHER: 120,
-            KnightClass.CAVALRY: 110,
-            KnightClass.MAGE: 150
-        }
-        
-        base_value = base_values.get(knight.knight_class, 100)
+        base_value = self.UNIT_BASE_VALUES.get(knight.knight_class, 100)
         health_factor = knight.health / knight.max_health
         ap_factor = knight.action_points / knight.max_action_points
         
@@ -87,12 +175,14 @@ class AIPlayer:
         bonus += (10 - distance_to_center) * 2
         
         enemy_castle_idx = 0 if self.player_id == 2 else 1
-        enemy_castle = game_state.castles[enemy_castle_idx]
-        
-        # Calculate distance to enemy castle
-        enemy_castle_hex = hex_grid.offset_to_axial(enemy_castle.center_x, enemy_castle.center_y)
-        distance_to_enemy_castle = knight_hex.distance_to(enemy_castle_hex)
-        bonus += (15 - distance_to_enemy_castle) * 3
+        # Field battles (e.g. most test scenarios) have no castles
+        if enemy_castle_idx < len(game_state.castles):
+            enemy_castle = game_state.castles[enemy_castle_idx]
+            
+            # Calculate distance to enemy castle
+            enemy_castle_hex = hex_grid.offset_to_axial(enemy_castle.center_x, enemy_castle.center_y)
+            distance_to_enemy_castle = knight_hex.distance_to(enemy_castle_hex)
+            bonus += (15 - distance_to_enemy_castle) * 3
         
         # Terrain position bonus
         if hasattr(game_state, 'terrain_map'):
@@ -197,50 +287,35 @@ class AIPlayer:
         return mapping[facing_direction]
     
     def _evaluate_facing_position(self, knight, game_state):
-        """Evaluate how well positioned unit is based on facing"""
+        """Evaluate how well one of our units is positioned based on facing.
+
+        Looks up the search's threat map on the tiles around the unit instead
+        of looping over enemies: a tile a visible enemy stands on or can reach
+        next turn scores by the arc it lies in, less the farther and later it
+        is. The threat map only covers enemies of this AI, so opposing units
+        score 0.
+        """
+        if knight.player_id != self.player_id:
+            return 0
+        threat_map = self._threat_map
+        if threat_map is None:
+            raise ValueError("Facing evaluation needs the threat map of an evaluation in progress")
+
         bonus = 0
-        
-        if not hasattr(game_state, 'fog_of_war'):
-            raise AttributeError("game_state.fog_of_war is required for facing evaluation")
-        fog_of_war = game_state.fog_of_war
-        hex_grid = HexGrid()
+        hex_grid = self._hex_grid
         knight_hex = hex_grid.offset_to_axial(knight.x, knight.y)
-        
-        # Check threats from different directions
-        for enemy in game_state.knights:
-            if enemy.player_id == self.player_id:
+        for tile in knight_hex.get_neighbors_within_range(self.FACING_RANGE):
+            nx, ny = hex_grid.axial_to_offset(tile)
+            if (nx, ny) == (knight.x, knight.y):
                 continue
-                
-            # Only consider visible enemies
-            if fog_of_war:
-                visibility = fog_of_war.get_visibility_state(self.player_id, enemy.x, enemy.y)
-                if visibility not in [VisibilityState.VISIBLE, VisibilityState.PARTIAL]:
-                    continue
-                
-            # Calculate distance using hex grid
-            enemy_hex = hex_grid.offset_to_axial(enemy.x, enemy.y)
-            distance = knight_hex.distance_to(enemy_hex)
-            
-            # Only consider nearby threats (but not on same position)
-            if 0 < distance <= 3:
-                # Check if enemy is behind us
-                if hasattr(knight, 'facing'):
-                    attack_angle = knight.facing.get_attack_angle(enemy.x, enemy.y, knight.x, knight.y)
-                    
-                    if attack_angle.is_rear:
-                        # Heavy penalty for enemies behind us
-                        bonus -= 30 / distance
-                    elif attack_angle.is_flank:
-                        # Moderate penalty for enemies on flank
-                        bonus -= 15 / distance
-                    else:
-                        # Small bonus for facing enemies
-                        bonus += 5 / distance
-                        
-                    # Extra penalty if enemy is cavalry behind us
-                    if attack_angle.is_rear and enemy.knight_class == KnightClass.CAVALRY:
-                        bonus -= 40 / distance
-        
+            if not (0 <= nx < threat_map.width and 0 <= ny < threat_map.height):
+                continue
+            turn = threat_map.earliest_turn(nx, ny)
+            if turn > 1:
+                continue
+            angle = knight.facing.get_attack_angle(nx, ny, knight.x, knight.y)
+            arc = 'rear' if angle.is_rear else 'flank' if angle.is_flank else 'front'
+            bonus += self.FACING_EXPOSURE[arc] / (knight_hex.distance_to(tile) + turn)
         return bonus
     
     def _evaluate_attack(self, attacker, target):
@@ -283,85 +358,120 @@ class AIPlayer:
                 continue
             
             if knight.can_move():
-                terrain_map = game_state.terrain_map if hasattr(game_state, 'terrain_map') else None
-                possible_positions = knight.get_possible_moves(game_state.board_width, game_state.board_height, terrain_map, game_state)
-                for new_x, new_y in possible_positions:
-                    # Check both current positions and pending positions
-                    occupied = False
-                    
-                    # Check if position is currently occupied
-                    if game_state.get_knight_at(new_x, new_y):
-                        occupied = True
-                    
-                    # Check if position will be occupied (pending moves)
-                    if hasattr(game_state, 'pending_positions'):
-                        for pending_knight_id, pending_pos in game_state.pending_positions.items():
-                            if pending_pos == (new_x, new_y) and pending_knight_id != id(knight):
-                                occupied = True
-                                break
-                    
-                    if not occupied:
-                        moves.append(('move', knight, new_x, new_y))
+                moves.extend(self.get_unit_moves(knight, game_state))
             
             if knight.can_attack():
-                attack_range = 1 if knight.knight_class != KnightClass.ARCHER else 3
-                knight_hex = hex_grid.offset_to_axial(knight.x, knight.y)
-                
-                if not hasattr(game_state, 'fog_of_war'):
-                    raise AttributeError("game_state.fog_of_war is required for attack evaluation")
-                fog_of_war = game_state.fog_of_war
-                
-                for enemy in game_state.knights:
-                    if enemy.player_id == self.player_id:
-                        continue
-                    
-                    # Only attack visible enemies
-                    if fog_of_war:
-                        visibility = fog_of_war.get_visibility_state(self.player_id, enemy.x, enemy.y)
-                        if visibility != VisibilityState.VISIBLE:
-                            continue  # Need full visibility to attack
-                    
-                    # Calculate proper hex distance
-                    enemy_hex = hex_grid.offset_to_axial(enemy.x, enemy.y)
-                    distance = knight_hex.distance_to(enemy_hex)
-                    
-                    if distance <= attack_range:
-                        # Calculate attack value considering facing
-                        attack_value = self._evaluate_attack(knight, enemy)
-                        moves.append(('attack', knight, enemy, attack_value))
+                moves.extend(self.get_unit_attacks(knight, game_state, hex_grid))
         
         return moves
-    
-    def minimax(self, game_state, depth, alpha, beta, maximizing_player):
-        if depth == 0:
-            return self.evaluate_position(game_state), None
+
+    def get_unit_moves(self, knight, game_state):
+        """('move', ...) actions for one unit that can move"""
+        moves = []
+        terrain_map = game_state.terrain_map if hasattr(game_state, 'terrain_map') else None
+        cached = self._move_cache_for(game_state)
+        if cached is not None:
+            move_cache, owner_of = cached
+            possible_positions = move_cache.get_moves(
+                knight,
+                lambda: knight.get_possible_moves(game_state.board_width, game_state.board_height, terrain_map, game_state),
+                owner=owner_of(knight) if owner_of else None
+            )
+        else:
+            possible_positions = knight.get_possible_moves(game_state.board_width, game_state.board_height, terrain_map, game_state)
+        for new_x, new_y in possible_positions:
+            # Check both current positions and pending positions
+            occupied = False
+            
+            # Check if position is currently occupied
+            if game_state.get_knight_at(new_x, new_y):
+                occupied = True
+            
+            # Check if position will be occupied (pending moves)
+            if hasattr(game_state, 'pending_positions'):
+                for pending_knight_id, pending_pos in game_state.pending_positions.items():
+                    if pending_pos == (new_x, new_y) and pending_knight_id != id(knight):
+                        occupied = True
+                        break
+            
+            if not occupied:
+                moves.append(('move', knight, new_x, new_y))
+        return moves
+
+    def get_unit_attacks(self, knight, game_state, hex_grid=None):
+        """('attack', ...) actions for one unit that can attack"""
+        moves = []
+        hex_grid = hex_grid or HexGrid()
+        attack_range = 1 if knight.knight_class != KnightClass.ARCHER else 3
+        knight_hex = hex_grid.offset_to_axial(knight.x, knight.y)
         
-        possible_moves = self.get_all_possible_moves(game_state)
+        if not hasattr(game_state, 'fog_of_war'):
+            raise AttributeError("game_state.fog_of_war is required for attack evaluation")
+        fog_of_war = game_state.fog_of_war
         
-        if not possible_moves:
-            return self.evaluate_position(game_state), None
+        for enemy in game_state.knights:
+            if enemy.player_id == self.player_id:
+                continue
             
-        # Move Ordering: Sort moves to improve Alpha-Beta efficiency
-        # 1. Attacks (prioritize higher heuristic value)
-        # 2. Strategic moves
-        def move_priority(m):
-            if m[0] == 'attack':
-                return 1000 + m[3] # Index 3 is attack value
-            return 0
+            # Only attack visible enemies
+            if fog_of_war:
+                visibility = fog_of_war.get_visibility_state(self.player_id, enemy.x, enemy.y)
+                if visibility != VisibilityState.VISIBLE:
+                    continue  # Need full visibility to attack
             
-        possible_moves.sort(key=move_priority, reverse=True)
+            # Calculate proper hex distance
+            enemy_hex = hex_grid.offset_to_axial(enemy.x, enemy.y)
+            distance = knight_hex.distance_to(enemy_hex)
             
-        # Optimization: Prune moves if too many
-        if len(possible_moves) > 10 and depth > 1:
-            possible_moves = possible_moves[:10]
+            if distance <= attack_range:
+                # Calculate attack value considering facing
+                attack_value = self._evaluate_attack(knight, enemy)
+                moves.append(('attack', knight, enemy, attack_value))
         
+        return moves
+    
+    def _move_cache_for(self, game_state):
+        """(cache, owner_of) holding game_state's unit moves, or None if they are not cached"""
+        if game_state is self._move_cache_state:
+            if isinstance(game_state, BattleSnapshot):
+                # Snapshot clones share cache entries with the live unit across actions
+                return self._move_cache, game_state.live_unit
+            return self._move_cache, None
+        return self._search_move_caches.get(game_state)
+
+    def register_move_cache(self, game_state, move_cache, owner_of=None):
+        """Cache moves for a simulated state; owner_of maps its units to stable cache owners"""
+        self._search_move_caches[game_state] = (move_cache, owner_of)
+
+    def unregister_move_cache(self, game_state):
+        self._search_move_caches.pop(game_state, None)
+
+    def minimax(self, game_state, depth, alpha, beta, maximizing_player, ply=0):
+        if depth == 0:
+            if self.use_quiescence:
+                self._quiescence_nodes = 0
+                return self.quiescence(game_state, alpha, beta, maximizing_player), None
+            self.nodes_searched += 1
+            return self.evaluate_position(game_state), None
+        self.nodes_searched += 1
+        
+        # Staged generation: attacks by value, then killer moves for this ply,
+        # then quiet moves unit by unit in history order. Units past a cutoff
+        # or the width limit never run their reachability search.
+        staged_moves = self._staged_moves(game_state, ply)
+        possible_moves = iter(staged_moves)
+        if depth > 1:
+            possible_moves = itertools.islice(possible_moves, self.search_width)
+
         best_move = None
+        searched_any = False
         
         if maximizing_player:
             max_eval = float('-inf')
             for move in possible_moves:
+                searched_any = True
                 game_state_copy = self._simulate_move(game_state, move)
-                eval_score, _ = self.minimax(game_state_copy, depth - 1, alpha, beta, False)
+                eval_score, _ = self.minimax(game_state_copy, depth - 1, alpha, beta, False, ply + 1)
                 
                 if eval_score > max_eval:
                     max_eval = eval_score
@@ -369,14 +479,19 @@ class AIPlayer:
                 
                 alpha = max(alpha, eval_score)
                 if beta <= alpha:
+                    self._record_cutoff(move, ply, depth)
                     break
             
+            self.units_expanded += staged_moves.units_expanded
+            if not searched_any:
+                return self.evaluate_position(game_state), None
             return max_eval, best_move
         else:
             min_eval = float('inf')
             for move in possible_moves:
+                searched_any = True
                 game_state_copy = self._simulate_move(game_state, move)
-                eval_score, _ = self.minimax(game_state_copy, depth - 1, alpha, beta, True)
+                eval_score, _ = self.minimax(game_state_copy, depth - 1, alpha, beta, True, ply + 1)
                 
                 if eval_score < min_eval:
                     min_eval = eval_score
@@ -384,98 +499,138 @@ class AIPlayer:
                 
                 beta = min(beta, eval_score)
                 if beta <= alpha:
+                    self._record_cutoff(move, ply, depth)
                     break
             
+            self.units_expanded += staged_moves.units_expanded
+            if not searched_any:
+                return self.evaluate_position(game_state), None
             return min_eval, best_move
+
+    def quiescence(self, game_state, alpha, beta, maximizing_player, qply=0):
+        """Leaf score once the attacks and charges on the board have played out.
+
+        Only tactical moves are searched. The enemy may stand pat on the
+        static evaluation instead of replying; our side's alternative to
+        attacking is to pass, since the enemy's turn comes either way. Bounded
+        by QUIESCENCE_MAX_PLY and QUIESCENCE_NODE_BUDGET (nodes below the leaf).
+        """
+        self.nodes_searched += 1
+        self._quiescence_nodes += 1
+        if qply >= self.QUIESCENCE_MAX_PLY or self._quiescence_nodes >= self.QUIESCENCE_NODE_BUDGET:
+            return self.evaluate_position(game_state)
+
+        if maximizing_player:
+            best = self.quiescence(game_state, alpha, beta, False, qply + 1)
+            alpha = max(alpha, best)
+        else:
+            best = self.evaluate_position(game_state)
+            if best <= alpha:
+                return best
+            beta = min(beta, best)
+        if beta <= alpha:
+            return best
+
+        for move in self.get_tactical_moves(game_state, own_side=maximizing_player):
+            if self._quiescence_nodes >= self.QUIESCENCE_NODE_BUDGET:
+                break
+            game_state_copy = self._simulate_move(game_state, move)
+            score = self.quiescence(game_state_copy, alpha, beta, not maximizing_player, qply + 1)
+            if maximizing_player:
+                best = max(best, score)
+                alpha = max(alpha, score)
+            else:
+                best = min(best, score)
+                beta = min(beta, score)
+            if beta <= alpha:
+                break
+        return best
+
+    def get_tactical_moves(self, game_state, own_side=True):
+        """Attacks and charges for quiescence search, most valuable first.
+
+        With own_side=False these are the visible enemies' replies against our
+        units. Enemies act on their own turn, so their current AP is ignored.
+        """
+        if not hasattr(game_state, 'fog_of_war'):
+            raise AttributeError("game_state.fog_of_war is required for attack evaluation")
+        fog_of_war = game_state.fog_of_war
+        own_units = [k for k in game_state.knights if k.player_id == self.player_id]
+        moves = []
+        if own_side:
+            for knight in own_units:
+                if knight.can_attack():
+                    moves.extend(self.get_unit_attacks(knight, game_state, self._hex_grid))
+                charge = knight.behaviors.get('cavalry_charge')
+                if charge:
+                    for target in charge.get_valid_targets(knight, game_state):
+                        moves.append(('charge', knight, target, self._evaluate_attack(knight, target)))
+        else:
+            for enemy in game_state.knights:
+                if enemy.player_id == self.player_id or enemy.is_routing:
+                    continue
+                if fog_of_war:
+                    visibility = fog_of_war.get_visibility_state(self.player_id, enemy.x, enemy.y)
+                    if visibility not in [VisibilityState.VISIBLE, VisibilityState.PARTIAL]:
+                        continue
+                moves.extend(self._reply_attacks(enemy, own_units, game_state))
+        moves.sort(key=lambda m: m[3], reverse=True)
+        return moves
+
+    def _reply_attacks(self, enemy, own_units, game_state):
+        """An enemy's attacks and charges on our units at its next turn.
+
+        Attacks use the enemy's own AttackBehavior range and target check
+        (line of sight for archers); its current AP is not checked.
+        """
+        moves = []
+        attack = enemy.behaviors.get('attack')
+        if attack:
+            for target in own_units:
+                if target.is_garrisoned:
+                    continue
+                if attack._is_valid_target(enemy, target, game_state):
+                    moves.append(('attack', enemy, target, self._evaluate_attack(enemy, target)))
+
+        charge = enemy.behaviors.get('cavalry_charge')
+        if (charge and enemy.unit_class == KnightClass.CAVALRY
+                and enemy.stats.stats.will >= charge.will_cost):
+            for target in own_units:
+                dx, dy = abs(enemy.x - target.x), abs(enemy.y - target.y)
+                if dx <= 1 and dy <= 1 and not target.is_garrisoned:
+                    moves.append(('charge', enemy, target, self._evaluate_attack(enemy, target)))
+        return moves
+
+    def _staged_moves(self, game_state, ply):
+        heuristics = self._move_ordering if self.use_search_heuristics else None
+        return StagedMoveGenerator(self, game_state, heuristics, ply)
+
+    def _record_cutoff(self, move, ply, depth):
+        if self.use_search_heuristics:
+            self._move_ordering.record_cutoff(move, ply, depth)
     
     def _simulate_move(self, game_state, move):
-        from game.interfaces.game_state import IGameState
-        
-        # Create a simplified copy without UI elements
-        class SimplifiedGameState(IGameState):
-            def __init__(self):
-                self._knights = []
-                self._castles = []
-                self._board_width = 0
-                self._board_height = 0
-                self._current_player = 1
-                self._terrain_map = None
-                self._fog_of_war = None
-                
-            @property
-            def board_width(self):
-                return self._board_width
-            
-            @property
-            def board_height(self):
-                return self._board_height
-                
-            @property
-            def knights(self):
-                return self._knights
-                
-            @property
-            def castles(self):
-                return self._castles
-                
-            @property
-            def terrain_map(self):
-                return self._terrain_map
-                
-            @property
-            def current_player(self):
-                return self._current_player
-
-            @property
-            def fog_of_war(self):
-                return self._fog_of_war
-                
-            def get_knight_at(self, tile_x, tile_y):
-                for knight in self.knights:
-                    if knight.x == tile_x and knight.y == tile_y:
-                        return knight
-                return None
-        
-        state_copy = SimplifiedGameState()
-        # FAST CLONING instead of deepcopy
-        state_copy._knights = [k.clone_for_simulation() for k in game_state.knights]
-        # Castles are mostly static in simulation, shallow copy is fine for now
-        import copy
-        state_copy._castles = copy.copy(game_state.castles)
-        
-        state_copy._board_width = game_state.board_width
-        state_copy._board_height = game_state.board_height
-        state_copy._current_player = game_state.current_player
-        # Copy terrain_map reference (static)
-        if hasattr(game_state, 'terrain_map'):
-            state_copy._terrain_map = game_state.terrain_map
-        if hasattr(game_state, 'fog_of_war'):
-            state_copy._fog_of_war = game_state.fog_of_war
+        # Copy-on-write: the new state shares every unit record with game_state
+        # and clones only the units this move changes
+        if isinstance(game_state, SharedBattleState):
+            state_copy = game_state.fork()
         else:
-            raise AttributeError("game_state.fog_of_war is required for AI simulation")
+            state_copy = SharedBattleState.share(game_state)
+        self._evaluator.link(state_copy, game_state, state_copy.origin_indices())
         
         move_type = move[0]
-        knight = None
-        original_knight = move[1]
-        
-        for k in state_copy.knights:
-            if k.name == original_knight.name and k.x == original_knight.x and k.y == original_knight.y:
-                knight = k
-                break
+        knight = self._find_simulated_unit(state_copy, move[1])
         
         if not knight:
              return state_copy
+        knight = state_copy.writable(knight)
 
         if move_type == 'move':
             knight.move(move[2], move[3])
         elif move_type == 'attack':
-            target = None
-            target_ref = move[2]
-            for k in state_copy.knights:
-                if k.name == target_ref.name and k.x == target_ref.x and k.y == target_ref.y:
-                    target = k
-                    break
+            target = self._find_simulated_unit(state_copy, move[2])
             if target:
+                target = state_copy.writable(target)
                 attacker_terrain = None
                 target_terrain = None
                 if state_copy.terrain_map:
@@ -486,22 +641,70 @@ class AIPlayer:
                 knight.consume_attack_ap()
                 target.take_casualties(damage, state_copy)
                 if target.soldiers <= 0:
-                    state_copy.knights.remove(target)
+                    state_copy.remove_unit(target)
+        elif move_type == 'charge':
+            target = self._find_simulated_unit(state_copy, move[2])
+            if target:
+                target = state_copy.writable(target)
+                if knight.player_id != self.player_id:
+                    # Enemy charges are replies on their own, fresh turn
+                    knight.action_points = knight.max_action_points
+                    knight.has_used_special = False
+                # Casualties and morale shock only: pushes, collateral damage to
+                # the unit behind and the charge's cohesion loss are not simulated
+                result = knight.behaviors['cavalry_charge'].execute(knight, state_copy, target)
+                if result.get('success'):
+                    target.take_casualties(min(result['damage'], target.soldiers), state_copy)
+                    target.morale = max(0, target.morale - result['morale_damage'])
+                    knight.take_casualties(min(result['self_damage'], knight.soldiers), state_copy)
+                    for unit in (target, knight):
+                        if unit.soldiers <= 0:
+                            state_copy.remove_unit(unit)
+        else:
+            raise ValueError(f"Unknown AI action type: {move_type}")
         
         return state_copy
+
+    @staticmethod
+    def _find_simulated_unit(game_state, unit_ref):
+        """The record of unit_ref in a simulated state: shared records match by identity"""
+        for k in game_state.knights:
+            if k is unit_ref:
+                return k
+        for k in game_state.knights:
+            if k.name == unit_ref.name and k.x == unit_ref.x and k.y == unit_ref.y:
+                return k
+        return None
     
     def choose_action(self, game_state):
-        depth = {'easy': 1, 'medium': 2, 'hard': 3}.get(self.difficulty, 1)
         import time
         t0 = time.time()
         
-        # Log start of thinking
-        print(f"AI Thinking... Depth: {depth}")
-        
-        _, best_move = self.minimax(game_state, depth, float('-inf'), float('inf'), True)
+        if self.difficulty == 'mcts':
+            if self.mcts_iterations is not None:
+                print(f"AI Thinking... MCTS budget: {self.mcts_iterations} playouts")
+                best_move = self._mcts.search(game_state, 0, max_iterations=self.mcts_iterations)
+            else:
+                print(f"AI Thinking... MCTS budget: {self.thinking_time:.2f}s")
+                best_move = self._mcts.search(game_state, self.thinking_time)
+            self.nodes_searched = self._mcts.iterations
+        else:
+            depth = self.SEARCH_DEPTHS.get(self.difficulty, 1)
+            # Log start of thinking
+            print(f"AI Thinking... Depth: {depth}")
+            
+            # Killers are position specific; history carries over within the turn
+            self._move_ordering.reset_killers()
+            self.nodes_searched = 0
+            self.units_expanded = 0
+            self._begin_search(game_state)
+            try:
+                _, best_move = self.minimax(game_state, depth, float('-inf'), float('inf'), True)
+            finally:
+                self._end_search()
         
         dt = time.time() - t0
-        print(f"AI Action Chosen in {dt:.2f}s: {best_move[0] if best_move else 'None'}")
+        print(f"AI Action Chosen in {dt:.2f}s ({self.nodes_searched} nodes): {best_move[0] if best_move else 'None'}")
         
         if best_move:
             return best_move
@@ -524,83 +727,160 @@ class AIPlayer:
         
         return None
     
+    def _begin_search(self, game_state):
+        # Threats are taken from the root; simulated enemy moves don't rebuild them
+        self._threat_map = self._build_threat_map(game_state)
+        self._evaluator.begin_search(game_state)
+
+    def _end_search(self):
+        self._evaluator.end_search()
+        self._threat_map = None
+
     def execute_turn(self, game_state):
-        from game.animation import MoveAnimation, AttackAnimation
-        actions_taken = []
-        
+        self.begin_turn(game_state)
+        try:
+            return self._execute_turn_actions(game_state)
+        finally:
+            self.end_turn()
+
+    def begin_turn(self, game_state):
+        """Reset per-turn search state before the first plan_action call"""
+        self._move_ordering.reset()
+        self._start_move_cache(game_state)
+
+    def end_turn(self):
+        self._clear_move_cache()
+
+    def plan_action(self, game_state, touched_tiles=()):
+        """Choose the next action for game_state, or None when the turn is over.
+
+        touched_tiles are the tiles changed by the previously applied action;
+        game_state may be the live battle or a fresh BattleSnapshot of it.
+        """
+        if touched_tiles:
+            # Units may have moved, routed or changed ZOC; refresh only moves near the action
+            self._move_cache.note_action(touched_tiles)
+        self._move_cache_state = game_state
+        if not self._has_actionable_units(game_state):
+            return None
+        return self.choose_action(game_state)
+
+    def max_turn_actions(self, game_state) -> int:
         # Allow enough actions for all units to move/attack
         # With 10+ units per side, 5 actions is way too few
-        max_actions = max(20, len(game_state.knights) * 2)
-        
-        for _ in range(max_actions):
-            if not self._has_actionable_units(game_state):
-                break
-            action = self.choose_action(game_state)
+        return max(20, len(game_state.knights) * 2)
+
+    def _start_move_cache(self, game_state):
+        self._move_cache.clear()
+        self._move_cache_state = game_state
+
+    def _clear_move_cache(self):
+        self._move_cache.clear()
+        self._move_cache_state = None
+
+    def _action_touched_tiles(self, action, game_state):
+        """Tiles whose occupancy or unit state an action may change"""
+        tiles = []
+        for unit in action[1:3]:
+            if hasattr(unit, 'x') and hasattr(unit, 'y'):
+                tiles.append((unit.x, unit.y))
+                pending = getattr(game_state, 'pending_positions', {}).get(id(unit))
+                if pending is not None:
+                    tiles.append(pending)
+        if action[0] == 'move':
+            tiles.append((action[2], action[3]))
+        return tiles
+
+    def _execute_turn_actions(self, game_state):
+        actions_taken = []
+        touched_tiles = []
+
+        for _ in range(self.max_turn_actions(game_state)):
+            action = self.plan_action(game_state, touched_tiles)
             if not action:
                 break
-            
-            move_type = action[0]
-            knight = action[1]
-            
-            if move_type == 'move':
-                if knight.can_move():
-                    # Select the knight and use the game state's movement method to track paths
-                    game_state.selected_knight = knight
-                    game_state.possible_moves = knight.get_possible_moves(
-                        game_state.board_width, game_state.board_height, 
-                        game_state.terrain_map, game_state
-                    )
-                    
-                    # Use the proper movement method that tracks paths
-                    target_x, target_y = action[2], action[3]
-                    success = game_state.move_selected_knight(target_x * 64, target_y * 64)
-                    
-                    if success:
-                        actions_taken.append(f"{knight.name} moved to ({target_x}, {target_y})")
-                    else:
-                        # Fallback to direct movement if the proper method fails
-                        start_x, start_y = knight.x, knight.y
-                        knight.consume_move_ap()
-                        game_state.pending_positions[id(knight)] = (target_x, target_y)
-                        anim = MoveAnimation(knight, start_x, start_y, target_x, target_y, game_state=game_state)
-                        game_state.animation_coordinator.animation_manager.add_animation(anim)
-                        actions_taken.append(f"{knight.name} moved to ({target_x}, {target_y})")
-            
-            elif move_type == 'attack':
-                attack_behavior = knight.behaviors.get('attack')
-                if not attack_behavior:
-                    continue
-                if not attack_behavior.can_execute(knight, game_state):
-                    continue
 
-                target = action[2]
-                result = attack_behavior.execute(knight, game_state, target)
-                if not result.get('success'):
-                    continue
+            touched_tiles = self._action_touched_tiles(action, game_state)
+            description = self.apply_action(action, game_state)
+            if description:
+                actions_taken.append(description)
+            touched_tiles.extend(self._action_touched_tiles(action, game_state))
+
+        return actions_taken
+
+    def apply_action(self, action, game_state):
+        """Carry out a planned action on the live game state and queue its animation.
+
+        Returns a description of what happened, or None if the action is no
+        longer possible (e.g. the unit or its target died since planning).
+        """
+        from game.animation import MoveAnimation, AttackAnimation
+
+        move_type = action[0]
+        knight = action[1]
+        if knight not in game_state.knights:
+            return None
+
+        if move_type == 'move':
+            if not knight.can_move():
+                return None
+            # Select the knight and use the game state's movement method to track paths
+            game_state.selected_knight = knight
+            game_state.possible_moves = knight.get_possible_moves(
+                game_state.board_width, game_state.board_height,
+                game_state.terrain_map, game_state
+            )
 
-                damage = result.get('damage', 0)
-                counter_damage = result.get('counter_damage', 0)
-                attack_angle = result.get('attack_angle', None)
-                extra_morale_penalty = result.get('extra_morale_penalty', 0)
-                extra_cohesion_penalty = result.get('extra_cohesion_penalty', 0)
-                should_check_routing = result.get('should_check_routing', False)
-
-                anim = AttackAnimation(
-                    knight,
-                    target,
-                    damage,
-                    counter_damage,
-                    attack_angle=attack_angle,
-                    extra_morale_penalty=extra_morale_penalty,
-                    extra_cohesion_penalty=extra_cohesion_penalty,
-                    should_check_routing=should_check_routing,
-                    game_state=game_state,
-                )
+            # Use the proper movement method that tracks paths
+            target_x, target_y = action[2], action[3]
+            success = game_state.move_selected_knight(target_x * 64, target_y * 64)
+
+            if not success:
+                # Fallback to direct movement if the proper method fails
+                start_x, start_y = knight.x, knight.y
+                knight.consume_move_ap()
+                game_state.pending_positions[id(knight)] = (target_x, target_y)
+                anim = MoveAnimation(knight, start_x, start_y, target_x, target_y, game_state=game_state)
                 game_state.animation_coordinator.animation_manager.add_animation(anim)
+            return f"{knight.name} moved to ({target_x}, {target_y})"
 
-                actions_taken.append(f"{knight.name} attacked {target.name} for {damage} damage")
-        
-        return actions_taken
+        if move_type == 'attack':
+            target = action[2]
+            if target not in game_state.knights:
+                return None
+            attack_behavior = knight.behaviors.get('attack')
+            if not attack_behavior:
+                return None
+            if not attack_behavior.can_execute(knight, game_state):
+                return None
+
+            result = attack_behavior.execute(knight, game_state, target)
+            if not result.get('success'):
+                return None
+
+            damage = result.get('damage', 0)
+            counter_damage = result.get('counter_damage', 0)
+            attack_angle = result.get('attack_angle', None)
+            extra_morale_penalty = result.get('extra_morale_penalty', 0)
+            extra_cohesion_penalty = result.get('extra_cohesion_penalty', 0)
+            should_check_routing = result.get('should_check_routing', False)
+
+            anim = AttackAnimation(
+                knight,
+                target,
+                damage,
+                counter_damage,
+                attack_angle=attack_angle,
+                extra_morale_penalty=extra_morale_penalty,
+                extra_cohesion_penalty=extra_cohesion_penalty,
+                should_check_routing=should_check_routing,
+                game_state=game_state,
+            )
+            game_state.animation_coordinator.animation_manager.add_animation(anim)
+
+            return f"{knight.name} attacked {target.name} for {damage} damage"
+
+        raise ValueError(f"Unknown AI action type: {move_type}")
 
     def _has_actionable_units(self, game_state) -> bool:
         for knight in game_state.knights:
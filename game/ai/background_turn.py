@@ -0,0 +1,103 @@
+"""AI turn whose planning runs on a worker thread while animations play"""
+import queue
+import threading
+
+from game.ai.battle_snapshot import BattleSnapshot
+
+
+class BackgroundAITurn:
+    """Plays one AI turn with the search off the main loop.
+
+    The worker thread plans each action against a BattleSnapshot and hands it
+    back through a queue. poll(), called from the main loop, applies a finished
+    action to the live battle (queuing its animation), then snapshots the result
+    and asks for the next action straight away, so planning action n+1 overlaps
+    the animation of action n. All live-state access stays on the main thread.
+    """
+
+    def __init__(self, ai_player, game_state):
+        if ai_player is None:
+            raise ValueError("ai_player is required for a background AI turn")
+        if game_state is None:
+            raise ValueError("game_state is required for a background AI turn")
+        self.ai_player = ai_player
+        self.game_state = game_state
+        self.actions_taken = []
+        self.done = False
+        self._max_actions = ai_player.max_turn_actions(game_state)
+        self._actions_requested = 0
+        self._requests = queue.Queue()
+        self._results = queue.Queue()
+        self._thread = None
+
+    def start(self) -> None:
+        if self._thread is not None:
+            raise ValueError("Background AI turn already started")
+        self.ai_player.begin_turn(self.game_state)
+        self._thread = threading.Thread(target=self._run, name="ai-planner", daemon=True)
+        self._thread.start()
+        self._request_action([])
+
+    def poll(self, block: bool = False, timeout=None) -> bool:
+        """Apply the next planned action if it is ready. Returns True once the turn is over.
+
+        The main loop polls without blocking; headless callers can block until
+        the plan arrives, with the same meaning of timeout as queue.Queue.get.
+        """
+        if self.done:
+            return True
+        if self._thread is None:
+            raise ValueError("Background AI turn has not been started")
+
+        try:
+            snapshot, action, error = self._results.get(block, timeout)
+        except queue.Empty:
+            return False
+
+        if error is not None:
+            self._finish()
+            raise error
+        if action is None:
+            self._finish()
+            return True
+
+        try:
+            live_action = snapshot.to_live_action(action)
+            touched_tiles = self.ai_player._action_touched_tiles(live_action, self.game_state)
+            description = self.ai_player.apply_action(live_action, self.game_state)
+            if description:
+                self.actions_taken.append(description)
+            touched_tiles.extend(self.ai_player._action_touched_tiles(live_action, self.game_state))
+        except Exception:
+            self._finish()
+            raise
+
+        if self._actions_requested >= self._max_actions:
+            self._finish()
+            return True
+        self._request_action(touched_tiles)
+        return False
+
+    def _request_action(self, touched_tiles) -> None:
+        self._actions_requested += 1
+        self._requests.put((BattleSnapshot.capture(self.game_state), touched_tiles))
+
+    def _run(self) -> None:
+        while True:
+            request = self._requests.get()
+            if request is None:
+                return
+            snapshot, touched_tiles = request
+            try:
+                action = self.ai_player.plan_action(snapshot, touched_tiles)
+            except Exception as error:
+                self._results.put((snapshot, None, error))
+                return
+            self._results.put((snapshot, action, None))
+
+    def _finish(self) -> None:
+        self._requests.put(None)
+        self._thread.join()
+        # The worker is gone, so per-turn AI state can be dropped safely
+        self.ai_player.end_turn()
+        self.done = True
@@ -0,0 +1,481 @@
+"""Fast battle playouts for Monte Carlo search"""
+from typing import Dict, List, Optional, Sequence, Tuple
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE, CPathFinder
+from game.combat_config import CombatConfig
+from game.config import USE_C_EXTENSIONS
+from game.systems.combat_batch import (FRONTAGE_FACTORS, UNIT_ARCHER, UNIT_CAVALRY, UNIT_OTHER,
+                                       UNIT_WARRIOR, _UNIT_KINDS)
+from game.terrain import Terrain
+from game.visibility import VisibilityState
+
+if C_EXTENSION_AVAILABLE:
+    import c_algorithms
+
+
+# Chance per decision that a playout deviates from the greedy policy
+ROLLOUT_EPSILON = 0.1
+
+_MASK64 = (1 << 64) - 1
+_DEFAULT_SEED = 0x9E3779B97F4A7C15
+
+# Same row-parity neighbour offsets as the C pathfinder (odd-r layout)
+_EVEN_ROW_DIRS = ((-1, -1), (0, -1), (1, 0), (0, 1), (-1, 1), (-1, 0))
+_ODD_ROW_DIRS = ((0, -1), (1, -1), (1, 0), (1, 1), (0, 1), (-1, 0))
+
+
+class BattleRollout:
+    """Plays a battle forward with a cheap greedy policy and scores the outcome.
+
+    Every unit attacks the weakest enemy in range, otherwise advances towards
+    the nearest enemy while keeping AP for the attack. Damage uses the
+    AttackBehavior.calculate_damage / calculate_counter_damage formulas for a
+    frontal attack (charges, ranged height, matchups and counters included);
+    morale, cohesion and facing stay as they were at the start of the playout.
+
+    Terrain tables and the value each side starts with are taken from the
+    state the instance is built for, so build one per search. The reward is
+    from ``player_id``'s side, in [0, 1]: 0.5 plus half the difference in the
+    fraction of that starting value each side still has, so losses inflicted
+    before the playout (in the search tree) count too.
+    """
+
+    DEFAULT_TURNS = 2
+
+    def __init__(self, game_state, player_id: int, base_values: Dict, use_native: Optional[bool] = None):
+        if game_state is None:
+            raise ValueError("game_state is required for battle rollouts")
+        if use_native is None:
+            use_native = USE_C_EXTENSIONS and C_EXTENSION_AVAILABLE
+        if use_native and not C_EXTENSION_AVAILABLE:
+            raise ValueError("Native rollouts requested but the C extension is not available")
+
+        self.player_id = player_id
+        self.use_native = use_native
+        self._base_values = base_values
+        self.width = game_state.board_width
+        self.height = game_state.board_height
+
+        if getattr(game_state, 'terrain_map', None) is not None:
+            self._grid, self._type_to_id, self._terrain_types = CPathFinder().get_terrain_grid(game_state)
+        else:
+            self._grid, self._type_to_id, self._terrain_types = [-1] * (self.width * self.height), {}, []
+
+        self._terrain_table = []
+        for terrain_type in self._terrain_types:
+            terrain = Terrain(terrain_type)
+            self._terrain_table.append((
+                float(terrain.defense_bonus),
+                FRONTAGE_FACTORS.get(terrain_type.value, 1.0),
+                1 if terrain_type.value.lower() == 'hills' else 0,
+                float(terrain.movement_cost),
+            ))
+
+        self._blockers = []
+        for castle in getattr(game_state, 'castles', None) or []:
+            self._blockers.extend(castle.occupied_tiles)
+
+        self._profile_index = {}
+        self._cost_profiles: List[Dict[int, float]] = []
+        self._combat_profiles: List[Dict[int, float]] = []
+        self._unit_factors = {}
+        self._baseline = _side_strengths(self.unit_inputs(game_state))
+
+    def unit_inputs(self, game_state) -> List[Tuple]:
+        """Rollout tuples for every unit the player knows about in game_state"""
+        fog_of_war = getattr(game_state, 'fog_of_war', None)
+        units = []
+        for unit in game_state.knights:
+            if unit.soldiers <= 0:
+                continue
+            if unit.player_id != self.player_id and fog_of_war:
+                visibility = fog_of_war.get_visibility_state(self.player_id, unit.x, unit.y)
+                if visibility not in [VisibilityState.VISIBLE, VisibilityState.PARTIAL]:
+                    continue
+            units.append(self._unit_tuple(unit))
+        return units
+
+    def play(self, game_state, rollouts: int = 1, turns: int = DEFAULT_TURNS, seed: int = 0) -> float:
+        """Mean reward of `rollouts` playouts of `turns` rounds, starting with player_id's remaining AP"""
+        units = self.unit_inputs(game_state)
+        args = (self.width, self.height, self._grid, self._cost_profiles, self._combat_profiles,
+                self._terrain_table, units, self._blockers, self._baseline, turns, rollouts,
+                seed & _MASK64)
+        if self.use_native:
+            return c_algorithms.simulate_battle(*args)
+        return simulate_battle_python(*args)
+
+    def _profile_for(self, unit) -> int:
+        if unit.unit_class not in self._profile_index:
+            self._profile_index[unit.unit_class] = len(self._cost_profiles)
+            self._cost_profiles.append(CPathFinder.build_cost_map(unit, self._type_to_id, self._terrain_types))
+            # Same call AttackBehavior makes when applying the terrain combat modifier
+            self._combat_profiles.append({
+                self._type_to_id[terrain_type]: float(Terrain(terrain_type).get_combat_modifier_for_unit(unit.unit_class))
+                for terrain_type in self._terrain_types
+            })
+        return self._profile_index[unit.unit_class]
+
+    def _factors_for(self, unit) -> Tuple:
+        key = (unit.name, unit.player_id, unit.stats.stats.morale, unit.cohesion, unit.is_disrupted)
+        factors = self._unit_factors.get(key)
+        if factors is None:
+            if unit.max_cohesion <= 0:
+                raise ValueError("max_cohesion must be positive for damage calculation")
+            defense = unit.stats.stats.base_defense
+            if hasattr(unit, 'generals'):
+                defense *= (1 + unit.generals.get_all_passive_bonuses(unit).get('defense_bonus', 0))
+            factors = (
+                unit.morale / 100,
+                unit.stats.stats.morale / 200,
+                max(CombatConfig.COHESION_DAMAGE_MIN_FACTOR, unit.cohesion / unit.max_cohesion),
+                unit.get_damage_modifier() if hasattr(unit, 'get_damage_modifier') else 1.0,
+                defense,
+            )
+            self._unit_factors[key] = factors
+        return factors
+
+    def _unit_tuple(self, unit) -> Tuple:
+        morale_factor, counter_morale_factor, cohesion_factor, damage_modifier, defense = self._factors_for(unit)
+        attack_behavior = unit.behaviors.get('attack')
+        attack_range = 0
+        attack_cost = 0.0
+        if attack_behavior and not unit.is_routing:
+            attack_range = attack_behavior.attack_range
+            attack_cost = float(attack_behavior.get_ap_cost(unit))
+        return (
+            unit.x,
+            unit.y,
+            0 if unit.player_id == self.player_id else 1,
+            self._profile_for(unit),
+            _UNIT_KINDS.get(unit.unit_class, UNIT_OTHER),
+            unit.soldiers,
+            unit.stats.stats.max_soldiers,
+            float(unit.stats.stats.formation_width),
+            float(unit.stats.stats.attack_per_soldier),
+            morale_factor,
+            counter_morale_factor,
+            cohesion_factor,
+            1 if unit.is_disrupted else 0,
+            float(damage_modifier),
+            float(defense),
+            float(unit.stats.stats.base_defense),
+            1 if unit.is_garrisoned else 0,
+            float(unit.action_points),
+            float(unit.max_action_points),
+            attack_cost,
+            attack_range,
+            float(self._base_values.get(unit.unit_class, 100)),
+        )
+
+
+def _side_strengths(units: Sequence[Tuple]) -> Tuple[float, float]:
+    strengths = [0.0, 0.0]
+    for unit in units:
+        side, soldiers, max_soldiers, value = unit[2], unit[5], unit[6], unit[21]
+        if max_soldiers > 0:
+            strengths[side] += value * soldiers / max_soldiers
+    return strengths[0], strengths[1]
+
+
+class _XorShift64Star:
+    """Bit-exact twin of the C rollout generator"""
+
+    def __init__(self, seed: int):
+        self.state = seed if seed else _DEFAULT_SEED
+
+    def next(self) -> int:
+        x = self.state
+        x ^= x >> 12
+        x ^= (x << 25) & _MASK64
+        x ^= x >> 27
+        self.state = x
+        return (x * 2685821657736338717) & _MASK64
+
+    def below(self, n: int) -> int:
+        return (self.next() >> 33) % n
+
+    def uniform(self) -> float:
+        return (self.next() >> 11) * (1.0 / 9007199254740992.0)
+
+
+class _Unit:
+    __slots__ = ('x', 'y', 'side', 'profile', 'kind', 'soldiers', 'max_soldiers', 'formation_width',
+                 'attack_per_soldier', 'morale_factor', 'counter_morale_factor', 'cohesion_factor',
+                 'disrupted', 'damage_modifier', 'defense', 'base_defense', 'garrisoned',
+                 'action_points', 'max_action_points', 'attack_cost', 'attack_range', 'value')
+
+    def __init__(self, values):
+        for slot, value in zip(self.__slots__, values):
+            setattr(self, slot, value)
+
+
+def _axial(x: int, y: int) -> Tuple[int, int]:
+    return x - (y - (y & 1)) // 2, y
+
+
+def _hex_distance(ax: int, ay: int, bx: int, by: int) -> int:
+    aq, ar = _axial(ax, ay)
+    bq, br = _axial(bx, by)
+    return (abs(aq - bq) + abs(aq + ar - bq - br) + abs(ar - br)) // 2
+
+
+def simulate_battle_python(width: int, height: int, grid: Sequence[int],
+                           cost_profiles: Sequence[Dict[int, float]],
+                           combat_profiles: Sequence[Dict[int, float]],
+                           terrain_table: Sequence[Tuple], units: Sequence[Tuple],
+                           blockers: Sequence[Tuple[int, int]], baseline: Tuple[float, float],
+                           turns: int, rollouts: int, seed: int) -> float:
+    """Pure Python twin of c_algorithms.simulate_battle"""
+    if width <= 0 or height <= 0:
+        raise ValueError("board dimensions must be positive")
+    if turns < 0 or rollouts <= 0:
+        raise ValueError("turns must be >= 0 and rollouts > 0")
+    if len(combat_profiles) != len(cost_profiles):
+        raise ValueError("combat_profiles must match cost_profiles")
+    for unit in units:
+        if not (0 <= unit[3] < len(cost_profiles)):
+            raise ValueError("rollout unit references unknown profile")
+        if unit[2] not in (0, 1):
+            raise ValueError("rollout unit side must be 0 or 1")
+        if not (0 <= unit[0] < width and 0 <= unit[1] < height):
+            raise ValueError("rollout unit is outside the board")
+
+    blocked = bytearray(width * height)
+    for bx, by in blockers:
+        if 0 <= bx < width and 0 <= by < height:
+            blocked[by * width + bx] = 1
+
+    board = _Board(width, height, grid, blocked, cost_profiles, combat_profiles, terrain_table)
+    rng = _XorShift64Star(seed)
+    total = 0.0
+    for _ in range(rollouts):
+        total += board.play([_Unit(unit) for unit in units], turns, baseline, rng)
+    return total / rollouts
+
+
+class _Board:
+    _OPEN_GROUND = (0.0, 1.0, 0, 1.0)
+
+    def __init__(self, width, height, grid, blocked, cost_profiles, combat_profiles, terrain_table):
+        self.width = width
+        self.height = height
+        self.grid = grid
+        self.blocked = blocked
+        self.cost_profiles = cost_profiles
+        self.combat_profiles = combat_profiles
+        self.terrain_table = list(terrain_table)
+
+    def terrain_at(self, x, y):
+        terrain_id = self.grid[y * self.width + x]
+        if 0 <= terrain_id < 100 and terrain_id < len(self.terrain_table):
+            return self.terrain_table[terrain_id]
+        return self._OPEN_GROUND
+
+    def combat_modifier(self, unit):
+        terrain_id = self.grid[unit.y * self.width + unit.x]
+        if not (0 <= terrain_id < 100):
+            return 1.0
+        return self.combat_profiles[unit.profile].get(terrain_id, 1.0)
+
+    @staticmethod
+    def effective_soldiers(unit, terrain):
+        return min(int(unit.formation_width * terrain[1]), unit.soldiers)
+
+    def damage(self, attacker, target, charge):
+        attacker_terrain = self.terrain_at(attacker.x, attacker.y)
+        target_terrain = self.terrain_at(target.x, target.y)
+        attacking_soldiers = self.effective_soldiers(attacker, attacker_terrain)
+
+        base_damage = attacking_soldiers * attacker.attack_per_soldier
+        if charge:
+            base_damage *= 1.3
+        base_damage *= self.combat_modifier(attacker)
+        base_damage *= attacker.morale_factor
+        base_damage *= attacker.cohesion_factor
+        if attacker.disrupted:
+            base_damage *= 0.5
+        base_damage *= attacker.damage_modifier
+
+        if attacker.attack_range > 1:
+            if not attacker_terrain[2] and target_terrain[2]:
+                base_damage = int(base_damage * 0.5)
+            elif attacker_terrain[2] and not target_terrain[2]:
+                base_damage = int(base_damage * 1.5)
+
+        target_defense = target.defense
+        target_defense += target_terrain[0]
+        if target.disrupted:
+            target_defense *= 0.5
+        if target.garrisoned:
+            target_defense += 20
+
+        total = base_damage + target_defense
+        damage_ratio = base_damage / total if total != 0.0 else 0.0
+        casualties = int(damage_ratio * attacking_soldiers * 0.25)
+
+        if attacker.kind == UNIT_CAVALRY and target.kind == UNIT_ARCHER:
+            casualties = int(casualties * 1.5)
+        elif attacker.kind == UNIT_ARCHER and target.kind == UNIT_WARRIOR:
+            casualties = int(casualties * 0.8)
+        return min(casualties, target.soldiers)
+
+    def counter_damage(self, defender, attacker):
+        if defender.kind == UNIT_ARCHER:
+            return 0
+        defender_terrain = self.terrain_at(defender.x, defender.y)
+        attacker_terrain = self.terrain_at(attacker.x, attacker.y)
+        defending_soldiers = self.effective_soldiers(defender, defender_terrain)
+
+        base_damage = defender.attack_per_soldier * defending_soldiers
+        base_damage *= self.combat_modifier(defender)
+        base_damage *= defender.counter_morale_factor
+        base_damage *= defender.cohesion_factor
+
+        attacker_defense = attacker.base_defense + attacker_terrain[0]
+        total = base_damage + attacker_defense
+        damage_ratio = base_damage / total if total != 0.0 else 0.0
+        casualties = int(damage_ratio * defending_soldiers * 0.15)
+
+        if defender.kind == UNIT_WARRIOR and attacker.kind == UNIT_CAVALRY:
+            casualties = int(casualties * 1.2)
+        return min(casualties, attacker.soldiers)
+
+    def attack_cost(self, attacker, target):
+        movement_cost = self.terrain_at(target.x, target.y)[3]
+        cost = attacker.attack_cost
+        if movement_cost > 1.0:
+            cost += int(movement_cost - 1.0) if attacker.attack_range > 1 else int((movement_cost - 1.0) * 2)
+        return cost
+
+    @staticmethod
+    def pick_target(units, unit, rng):
+        candidates = [
+            other for other in units
+            if other.soldiers > 0 and other.side != unit.side
+            and _hex_distance(unit.x, unit.y, other.x, other.y) <= unit.attack_range
+        ]
+        if not candidates:
+            return None
+        if rng.uniform() < ROLLOUT_EPSILON:
+            return candidates[rng.below(len(candidates))]
+        best = candidates[0]
+        for other in candidates[1:]:
+            if other.soldiers < best.soldiers:
+                best = other
+        return best
+
+    def advance(self, units, index, occupied, action_points, rng):
+        unit = units[index]
+        nearest = None
+        nearest_distance = None
+        for other in units:
+            if other.soldiers <= 0 or other.side == unit.side:
+                continue
+            distance = _hex_distance(unit.x, unit.y, other.x, other.y)
+            if nearest is None or distance < nearest_distance:
+                nearest, nearest_distance = other, distance
+        if nearest is None:
+            return action_points
+
+        budget = action_points - unit.attack_cost
+        if budget < 0:
+            budget = action_points
+        costs = self.cost_profiles[unit.profile]
+
+        while nearest_distance > unit.attack_range:
+            steps = []
+            for dx, dy in (_EVEN_ROW_DIRS if unit.y % 2 == 0 else _ODD_ROW_DIRS):
+                nx, ny = unit.x + dx, unit.y + dy
+                if not (0 <= nx < self.width and 0 <= ny < self.height):
+                    continue
+                n_idx = ny * self.width + nx
+                if self.blocked[n_idx] or occupied[n_idx]:
+                    continue
+                terrain_id = self.grid[n_idx]
+                move_cost = costs.get(terrain_id, 1.0) if 0 <= terrain_id < 100 else 1.0
+                if move_cost < 1.0:
+                    move_cost = 1.0
+                if move_cost == float('inf') or move_cost > budget:
+                    continue
+                distance = _hex_distance(nx, ny, nearest.x, nearest.y)
+                if distance >= nearest_distance:
+                    continue
+                steps.append((nx, ny, distance, move_cost))
+            if not steps:
+                break
+
+            if rng.uniform() < ROLLOUT_EPSILON:
+                chosen = steps[rng.below(len(steps))]
+            else:
+                chosen = steps[0]
+                for step in steps[1:]:
+                    if step[2] < chosen[2] or (step[2] == chosen[2] and step[3] < chosen[3]):
+                        chosen = step
+
+            occupied[unit.y * self.width + unit.x] = 0
+            unit.x, unit.y = chosen[0], chosen[1]
+            occupied[unit.y * self.width + unit.x] = index + 1
+            budget -= chosen[3]
+            action_points -= chosen[3]
+            nearest_distance = chosen[2]
+        return action_points
+
+    def resolve_attack(self, attacker, target, occupied):
+        ranged = _hex_distance(attacker.x, attacker.y, target.x, target.y) > 1
+        charge = not ranged and attacker.kind == UNIT_CAVALRY
+
+        damage = self.damage(attacker, target, charge)
+        counter_damage = 0
+        if not ranged:
+            counter_damage = self.counter_damage(target, attacker)
+            if charge:
+                counter_damage = int(counter_damage * 0.75)
+
+        target.soldiers -= damage
+        attacker.soldiers -= counter_damage
+        for unit in (target, attacker):
+            if unit.soldiers <= 0:
+                unit.soldiers = 0
+                occupied[unit.y * self.width + unit.x] = 0
+
+    @staticmethod
+    def strength(units, side):
+        strength = 0.0
+        for unit in units:
+            if unit.side == side and unit.max_soldiers > 0:
+                strength += unit.value * unit.soldiers / unit.max_soldiers
+        return strength
+
+    def play(self, units, turns, baseline, rng):
+        occupied = [0] * (self.width * self.height)
+        for i, unit in enumerate(units):
+            if unit.soldiers > 0:
+                occupied[unit.y * self.width + unit.x] = i + 1
+
+        for half in range(2 * turns):
+            side = half % 2
+            order = [i for i, unit in enumerate(units) if unit.soldiers > 0 and unit.side == side]
+            defenders = sum(1 for unit in units if unit.soldiers > 0 and unit.side != side)
+            if not order or not defenders:
+                break
+            for i in range(len(order) - 1, 0, -1):
+                j = rng.below(i + 1)
+                order[i], order[j] = order[j], order[i]
+
+            for index in order:
+                unit = units[index]
+                if unit.soldiers <= 0 or unit.attack_range <= 0:
+                    continue
+                action_points = unit.action_points if half == 0 else unit.max_action_points
+
+                target = self.pick_target(units, unit, rng)
+                if target is None:
+                    action_points = self.advance(units, index, occupied, action_points, rng)
+                    target = self.pick_target(units, unit, rng)
+                if target is not None and action_points >= self.attack_cost(unit, target):
+                    self.resolve_attack(unit, target, occupied)
+
+        own_ratio = self.strength(units, 0) / baseline[0] if baseline[0] > 0 else 0.0
+        enemy_ratio = self.strength(units, 1) / baseline[1] if baseline[1] > 0 else 0.0
+        return 0.5 + 0.5 * (own_ratio - enemy_ratio)
@@ -0,0 +1,123 @@
+"""Immutable battle snapshots the AI can plan against off the main thread"""
+from typing import Dict, Optional, Tuple
+
+from game.battle.adapters.shared_battle_state import SharedBattleState
+from game.visibility import VisibilityState
+
+
+class FrozenVisibility:
+    """Fog-of-war visibility copied at snapshot time.
+
+    Visibility states are frozen; line-of-sight queries only depend on terrain
+    and are forwarded to the live fog of war.
+    """
+
+    def __init__(self, fog_of_war):
+        if not hasattr(fog_of_war, 'visibility_maps'):
+            raise ValueError("fog_of_war must expose visibility_maps to be frozen")
+        self._fog_of_war = fog_of_war
+        self.width = fog_of_war.width
+        self.height = fog_of_war.height
+        self.num_players = fog_of_war.num_players
+        self.visibility_maps: Dict[int, Dict[Tuple[int, int], VisibilityState]] = {
+            player_id: dict(visibility_map)
+            for player_id, visibility_map in fog_of_war.visibility_maps.items()
+        }
+
+    def get_visibility_state(self, player_id: int, x: int, y: int) -> VisibilityState:
+        if player_id not in self.visibility_maps:
+            return VisibilityState.HIDDEN
+        return self.visibility_maps[player_id].get((x, y), VisibilityState.HIDDEN)
+
+    def is_hex_visible(self, player_id: int, x: int, y: int) -> bool:
+        state = self.get_visibility_state(player_id, x, y)
+        return state in [VisibilityState.VISIBLE, VisibilityState.PARTIAL]
+
+    def can_identify_unit(self, player_id: int, x: int, y: int) -> bool:
+        return self.get_visibility_state(player_id, x, y) == VisibilityState.VISIBLE
+
+    def get_visibility_from_position(self, game_state, unit, origin, target) -> VisibilityState:
+        return self._fog_of_war.get_visibility_from_position(game_state, unit, origin, target)
+
+    def _has_line_of_sight(self, game_state, origin, target, is_elevated: bool) -> bool:
+        return self._fog_of_war._has_line_of_sight(game_state, origin, target, is_elevated)
+
+    def reveal_unit_visibility(self, game_state, unit) -> None:
+        raise ValueError("Battle snapshots are read-only; visibility cannot be revealed")
+
+
+class BattleSnapshot(SharedBattleState):
+    """Point-in-time copy of a battle for AI planning.
+
+    Units are ``clone_for_simulation`` copies, so later changes to the live
+    battle (animations landing, casualties, fog updates) do not leak into a
+    plan in progress. Terrain is shared as it does not change during a battle.
+    Capture on the thread that owns the live state; ``fork`` it for "what if"
+    states, which share these clones until they change a unit.
+    """
+
+    def __init__(self, board_width: int, board_height: int, knights, castles, terrain_map,
+                 current_player: int, fog_of_war, pending_positions, live_units,
+                 fog_view_player: Optional[int] = None):
+        super().__init__(board_width, board_height, knights, castles, terrain_map,
+                         current_player, fog_of_war)
+        self.pending_positions = pending_positions
+        self._live_units = live_units
+        self._fog_view_player = fog_view_player
+
+    @classmethod
+    def capture(cls, game_state) -> 'BattleSnapshot':
+        if game_state is None:
+            raise ValueError("game_state is required to capture a battle snapshot")
+        if not hasattr(game_state, 'fog_of_war'):
+            raise AttributeError("game_state.fog_of_war is required for AI planning")
+
+        live_units = {}
+        knights = []
+        for unit in game_state.knights:
+            clone = unit.clone_for_simulation()
+            live_units[id(clone)] = unit
+            knights.append(clone)
+
+        clone_ids = {id(unit): id(clone) for clone, unit in zip(knights, game_state.knights)}
+        pending_positions = {
+            clone_ids[unit_id]: position
+            for unit_id, position in getattr(game_state, 'pending_positions', {}).items()
+            if unit_id in clone_ids
+        }
+
+        fog_of_war = game_state.fog_of_war
+        return cls(
+            game_state.board_width,
+            game_state.board_height,
+            knights,
+            list(game_state.castles),
+            getattr(game_state, 'terrain_map', None),
+            game_state.current_player,
+            FrozenVisibility(fog_of_war) if fog_of_war else None,
+            pending_positions,
+            live_units,
+            getattr(game_state, 'fog_view_player', None),
+        )
+
+    @property
+    def fog_view_player(self):
+        if self._fog_view_player is None:
+            # Reads as absent so visibility checks fall back to current_player
+            raise AttributeError("snapshot has no fog_view_player")
+        return self._fog_view_player
+
+    def live_unit(self, unit):
+        """The live unit a snapshot clone was copied from"""
+        live = self._live_units.get(id(unit))
+        if live is None:
+            raise ValueError(f"{getattr(unit, 'name', unit)} is not part of this snapshot")
+        return live
+
+    def to_live_action(self, action):
+        """Map an action chosen against the snapshot onto the live units"""
+        if action is None:
+            return None
+        if action[0] == 'attack':
+            return (action[0], self.live_unit(action[1]), self.live_unit(action[2])) + tuple(action[3:])
+        return (action[0], self.live_unit(action[1])) + tuple(action[2:])
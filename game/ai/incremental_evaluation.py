@@ -0,0 +1,177 @@
+"""Incremental position evaluation for AI search"""
+import weakref
+from typing import Dict, List, Optional, Tuple
+
+from game.hex_utils import HexGrid
+from game.visibility import VisibilityState
+
+
+class _UnitTerms:
+    __slots__ = ('signature', 'player_id', 'hex', 'contribution', 'castle_hits', 'nearest_enemy')
+
+    def __init__(self, signature, player_id, hex_coord, contribution, castle_hits, nearest_enemy):
+        self.signature = signature
+        self.player_id = player_id
+        self.hex = hex_coord
+        self.contribution = contribution
+        self.castle_hits = castle_hits
+        self.nearest_enemy = nearest_enemy
+
+
+class _Lineage:
+    __slots__ = ('parent', 'origins', 'terms')
+
+    def __init__(self, parent, origins):
+        self.parent = parent
+        self.origins = origins
+        self.terms = None
+
+
+class IncrementalEvaluator:
+    """Caches per-unit evaluation terms and updates them along the search tree.
+
+    Each simulated state is linked to the state it was derived from together with
+    the parent index of every cloned unit. A child's terms start as a copy of its
+    parent's; only units that changed, or whose neighbourhood contains a tile a
+    changed or removed unit left or entered, are recomputed. The neighbourhood is
+    the facing/line radius; enemy changes also count out to the distance of the
+    unit's nearest visible enemy because the line bonus depends on which one is
+    nearest.
+
+    Terrain, fog of war and castles are static during a search, so terms of the
+    root state are only reused between begin_search() and end_search().
+    """
+
+    # Line bonus counts up to 3 allies per side; facing reads the static root threat map
+    NEIGHBOURHOOD_RADIUS = 3
+
+    def __init__(self, ai_player):
+        self._ai = ai_player
+        self._hex_grid = HexGrid()
+        self._lineage: 'weakref.WeakKeyDictionary' = weakref.WeakKeyDictionary()
+        self._search_root = None
+        self._root_terms: Optional[List[_UnitTerms]] = None
+        self.units_recomputed = 0
+        self.units_reused = 0
+
+    def begin_search(self, root_state):
+        self._search_root = root_state
+        self._root_terms = None
+        self.units_recomputed = 0
+        self.units_reused = 0
+
+    def end_search(self):
+        self._search_root = None
+        self._root_terms = None
+        self._lineage.clear()
+
+    def link(self, child_state, parent_state, origins: Dict[int, int]):
+        """Record that child_state was cloned from parent_state.
+
+        origins maps id() of each unit in child_state to its index in parent_state.knights.
+        """
+        self._lineage[child_state] = _Lineage(parent_state, origins)
+
+    def evaluate(self, game_state) -> float:
+        terms = self._terms_for(game_state)
+        return self._ai._combine_evaluation_terms(
+            game_state,
+            [unit_terms.contribution for unit_terms in terms],
+            [unit_terms.castle_hits for unit_terms in terms],
+        )
+
+    def _terms_for(self, game_state) -> List[_UnitTerms]:
+        lineage = self._lineage.get(game_state)
+        if lineage is not None:
+            if lineage.terms is None:
+                parent_terms = self._terms_for(lineage.parent)
+                lineage.terms = self._derive_terms(game_state, parent_terms, lineage.origins)
+            return lineage.terms
+
+        if game_state is self._search_root:
+            if self._root_terms is None:
+                self._root_terms = [self._compute_unit_terms(k, game_state) for k in game_state.knights]
+            return self._root_terms
+
+        return [self._compute_unit_terms(k, game_state) for k in game_state.knights]
+
+    @staticmethod
+    def _signature(knight) -> Tuple:
+        return (
+            knight.x,
+            knight.y,
+            knight.facing.facing if hasattr(knight, 'facing') else None,
+            knight.health,
+            knight.max_health,
+            knight.action_points,
+            knight.max_action_points,
+            knight.is_garrisoned,
+        )
+
+    def _compute_unit_terms(self, knight, game_state) -> _UnitTerms:
+        self.units_recomputed += 1
+        knight_hex = self._hex_grid.offset_to_axial(knight.x, knight.y)
+        return _UnitTerms(
+            self._signature(knight),
+            knight.player_id,
+            knight_hex,
+            self._ai._unit_contribution(knight, game_state),
+            self._ai._castle_range_hits(knight, game_state),
+            self._nearest_enemy_distance(knight, knight_hex, game_state),
+        )
+
+    def _nearest_enemy_distance(self, knight, knight_hex, game_state) -> float:
+        fog_of_war = game_state.fog_of_war
+        nearest = float('inf')
+        for enemy in game_state.knights:
+            if enemy.player_id == knight.player_id:
+                continue
+            if fog_of_war:
+                visibility = fog_of_war.get_visibility_state(self._ai.player_id, enemy.x, enemy.y)
+                if visibility not in [VisibilityState.VISIBLE, VisibilityState.PARTIAL]:
+                    continue
+            distance = knight_hex.distance_to(self._hex_grid.offset_to_axial(enemy.x, enemy.y))
+            if distance < nearest:
+                nearest = distance
+        return nearest
+
+    def _derive_terms(self, game_state, parent_terms: List[_UnitTerms], origins: Dict[int, int]) -> List[_UnitTerms]:
+        knights = game_state.knights
+        sources = [origins.get(id(knight)) for knight in knights]
+
+        # (hex, player_id) of every tile a changed or removed unit left or entered
+        touched = []
+        changed = set()
+        for index, (knight, source) in enumerate(zip(knights, sources)):
+            if source is None:
+                changed.add(index)
+                touched.append((self._hex_grid.offset_to_axial(knight.x, knight.y), knight.player_id))
+                continue
+            parent = parent_terms[source]
+            if self._signature(knight) != parent.signature:
+                changed.add(index)
+                touched.append((parent.hex, knight.player_id))
+                touched.append((self._hex_grid.offset_to_axial(knight.x, knight.y), knight.player_id))
+
+        surviving = {source for source in sources if source is not None}
+        for source, parent in enumerate(parent_terms):
+            if source not in surviving:
+                touched.append((parent.hex, parent.player_id))
+
+        terms = []
+        for index, (knight, source) in enumerate(zip(knights, sources)):
+            if index not in changed:
+                parent = parent_terms[source]
+                if not any(self._affects(parent, tile_hex, player_id) for tile_hex, player_id in touched):
+                    self.units_reused += 1
+                    terms.append(parent)
+                    continue
+            terms.append(self._compute_unit_terms(knight, game_state))
+        return terms
+
+    def _affects(self, unit_terms: _UnitTerms, tile_hex, player_id) -> bool:
+        distance = unit_terms.hex.distance_to(tile_hex)
+        if distance <= self.NEIGHBOURHOOD_RADIUS:
+            return True
+        # Only enemies can change which enemy is nearest for the line bonus
+        return player_id != unit_terms.player_id and distance <= unit_terms.nearest_enemy
@@ -0,0 +1,205 @@
+"""Monte Carlo tree search over the AI's own unit actions"""
+import math
+import random
+import time
+from typing import List, Optional
+
+from game.ai.battle_rollout import BattleRollout
+from game.ai.move_cache import MoveGenerationCache
+from game.hex_utils import HexGrid
+from game.visibility import VisibilityState
+
+
+class _Node:
+    __slots__ = ('state', 'action', 'parent', 'children', 'candidates', 'pending',
+                 'visits', 'total_reward', 'move_cache')
+
+    def __init__(self, state, move_cache, action=None, parent=None):
+        self.state = state
+        self.move_cache = move_cache
+        self.action = action
+        self.parent = parent
+        self.children: List['_Node'] = []
+        # Actions in prior order, drawn from the pending generator as widening needs them
+        self.candidates = []
+        self.pending = None
+        self.visits = 0
+        self.total_reward = 0.0
+
+
+class MonteCarloTreeSearch:
+    """UCT search whose tree holds the AI's actions for the rest of its turn.
+
+    Each edge is one unit action. Progressive widening keeps the tree narrow
+    however many tiles units can reach: a node with n visits may have
+    ceil(WIDENING_BASE * n ** WIDENING_EXPONENT) children, added in prior order
+    (attacks by value, then the best UNIT_MOVE_WIDTH moves of each unit closest
+    to the enemy first, then everything else). A unit's moves are only
+    generated once widening reaches it. Leaves are scored by native
+    BattleRollout playouts that finish the turn and play out the reply.
+
+    Each node forks its parent's MoveGenerationCache, so only units within
+    reach of the last action regenerate their moves.
+    """
+
+    EXPLORATION = math.sqrt(2)
+    WIDENING_BASE = 2.0
+    WIDENING_EXPONENT = 0.5
+    # AI actions deep the tree may plan within the current turn
+    MAX_TREE_DEPTH = 4
+    ROLLOUTS_PER_LEAF = 4
+    # Moves per unit offered before any unit's weaker moves
+    UNIT_MOVE_WIDTH = 2
+    ROLLOUT_TURNS = BattleRollout.DEFAULT_TURNS
+
+    def __init__(self, ai_player, seed: Optional[int] = None, use_native: Optional[bool] = None):
+        self._ai = ai_player
+        self._rng = random.Random(seed)
+        self._hex_grid = HexGrid()
+        self.use_native = use_native
+        self.iterations = 0
+        self._owner_of = None
+
+    def search(self, game_state, time_budget: float, max_iterations: Optional[int] = None):
+        """Best action for the AI within time_budget seconds (or max_iterations playouts)"""
+        if time_budget <= 0 and not max_iterations:
+            raise ValueError("MCTS needs a positive time budget or an iteration limit")
+
+        rollout = BattleRollout(game_state, self._ai.player_id, self._ai.UNIT_BASE_VALUES,
+                                use_native=self.use_native)
+        root_cache = self._ai._move_cache_for(game_state)
+        registered_root = root_cache is None
+        if registered_root:
+            # Only valid while the search runs; the caller may change game_state afterwards
+            root_cache = (MoveGenerationCache(), None)
+            self._ai.register_move_cache(game_state, *root_cache)
+        try:
+            return self._search(game_state, root_cache, rollout, time_budget, max_iterations)
+        finally:
+            if registered_root:
+                self._ai.unregister_move_cache(game_state)
+
+    def _search(self, game_state, root_cache, rollout, time_budget, max_iterations):
+        move_cache, owner_of = root_cache
+        # Simulated clones file their moves under the root's cache owners
+        owners = {
+            (unit.name, unit.player_id): owner_of(unit) if owner_of else unit
+            for unit in game_state.knights
+        }
+        self._owner_of = lambda unit: owners.get((unit.name, unit.player_id), unit)
+        root = _Node(game_state, move_cache)
+        deadline = time.perf_counter() + time_budget
+        self.iterations = 0
+
+        while True:
+            if max_iterations is not None and self.iterations >= max_iterations:
+                break
+            if self.iterations > 0 and time_budget > 0 and time.perf_counter() >= deadline:
+                break
+
+            node = self._select_and_expand(root)
+            reward = rollout.play(node.state, self.ROLLOUTS_PER_LEAF, self.ROLLOUT_TURNS,
+                                  self._rng.getrandbits(64))
+            while node is not None:
+                node.visits += 1
+                node.total_reward += reward
+                node = node.parent
+            self.iterations += 1
+
+            if root.pending is not None and not root.candidates:
+                break
+
+        if not root.children:
+            return None
+        best = max(root.children, key=lambda child: (child.visits, child.total_reward))
+        return best.action
+
+    def _select_and_expand(self, root: _Node) -> _Node:
+        node = root
+        depth = 0
+        while depth < self.MAX_TREE_DEPTH:
+            allowed = math.ceil(self.WIDENING_BASE * (node.visits + 1) ** self.WIDENING_EXPONENT)
+            action = self._candidate(node, len(node.children)) if len(node.children) < allowed else None
+            if action is not None:
+                child = self._expand(node, action)
+                node.children.append(child)
+                return child
+            if not node.children:
+                return node
+            node = max(node.children, key=lambda child: self._uct(node, child))
+            depth += 1
+        return node
+
+    def _expand(self, node: _Node, action) -> _Node:
+        touched_tiles = self._ai._action_touched_tiles(action, node.state)
+        state = self._ai._simulate_move(node.state, action)
+        move_cache = node.move_cache.fork(touched_tiles)
+        self._ai.register_move_cache(state, move_cache, self._owner_of)
+        return _Node(state, move_cache, action, node)
+
+    def _uct(self, parent: _Node, child: _Node) -> float:
+        return (child.total_reward / child.visits
+                + self.EXPLORATION * math.sqrt(math.log(parent.visits) / child.visits))
+
+    def _candidate(self, node: _Node, index: int):
+        if node.pending is None:
+            node.pending = self._candidate_actions(node.state)
+        while len(node.candidates) <= index:
+            action = next(node.pending, None)
+            if action is None:
+                return None
+            node.candidates.append(action)
+        return node.candidates[index]
+
+    def _candidate_actions(self, game_state):
+        """Yield the AI's actions in prior order, generating moves unit by unit"""
+        own_units = [unit for unit in game_state.knights if unit.player_id == self._ai.player_id]
+
+        attacks = []
+        for unit in own_units:
+            if unit.can_attack():
+                attacks.extend(self._ai.get_unit_attacks(unit, game_state, self._hex_grid))
+        attacks.sort(key=lambda m: m[3], reverse=True)
+        yield from attacks
+
+        enemies = self._known_enemies(game_state)
+        movers = []
+        for unit in own_units:
+            if unit.can_move():
+                attack_behavior = unit.behaviors.get('attack')
+                preferred = attack_behavior.attack_range if attack_behavior else 1
+                movers.append((self._approach_score(unit.x, unit.y, enemies, preferred), preferred, unit))
+        movers.sort(key=lambda entry: entry[0])
+
+        remaining = []
+        for _, preferred, unit in movers:
+            unit_moves = self._ai.get_unit_moves(unit, game_state)
+            unit_moves.sort(key=lambda m: self._approach_score(m[2], m[3], enemies, preferred))
+            yield from unit_moves[:self.UNIT_MOVE_WIDTH]
+            remaining.append(unit_moves[self.UNIT_MOVE_WIDTH:])
+
+        # Round-robin through the weaker moves
+        for rank in range(max((len(moves) for moves in remaining), default=0)):
+            for unit_moves in remaining:
+                if rank < len(unit_moves):
+                    yield unit_moves[rank]
+
+    def _known_enemies(self, game_state):
+        fog_of_war = getattr(game_state, 'fog_of_war', None)
+        enemies = []
+        for unit in game_state.knights:
+            if unit.player_id == self._ai.player_id:
+                continue
+            if fog_of_war:
+                visibility = fog_of_war.get_visibility_state(self._ai.player_id, unit.x, unit.y)
+                if visibility not in [VisibilityState.VISIBLE, VisibilityState.PARTIAL]:
+                    continue
+            enemies.append(self._hex_grid.offset_to_axial(unit.x, unit.y))
+        return enemies
+
+    def _approach_score(self, x, y, enemies, preferred_range) -> int:
+        if not enemies:
+            return 0
+        tile = self._hex_grid.offset_to_axial(x, y)
+        nearest = min(tile.distance_to(enemy) for enemy in enemies)
+        return abs(nearest - preferred_range)
@@ -0,0 +1,112 @@
+"""Per-turn move generation cache for the AI decision loop"""
+from typing import Callable, Dict, Iterable, List, Tuple
+
+from game.hex_utils import HexGrid
+
+
+class _CacheEntry:
+    __slots__ = ('unit', 'key', 'moves', 'center', 'radius')
+
+    def __init__(self, unit, key, moves, center, radius):
+        self.unit = unit
+        self.key = key
+        self.moves = moves
+        self.center = center
+        self.radius = radius
+
+
+class MoveGenerationCache:
+    """Caches each unit's reachable tiles between AI actions within one turn.
+
+    Entries are keyed on the unit's position, AP and movement flags and remember
+    how far their moves reach. Executing an action drops only the entries whose
+    reach covers one of the touched tiles, so units far from the last action
+    keep their moves.
+    """
+
+    # Tiles beyond the reachable frontier that still influence a unit's moves:
+    # one step past the frontier plus the square-neighbourhood ZOC and formation checks.
+    REACH_MARGIN = 3
+
+    def __init__(self):
+        self._hex_grid = HexGrid()
+        self._entries: Dict[int, _CacheEntry] = {}
+        self.hits = 0
+        self.misses = 0
+
+    def clear(self):
+        self._entries.clear()
+        self.hits = 0
+        self.misses = 0
+
+    @staticmethod
+    def _unit_key(unit) -> Tuple:
+        return (
+            unit.x,
+            unit.y,
+            unit.action_points,
+            unit.has_moved,
+            unit.in_enemy_zoc,
+            unit.is_routing,
+        )
+
+    def get_moves(self, unit, compute: Callable[[], List[Tuple[int, int]]], owner=None) -> List[Tuple[int, int]]:
+        """Return cached moves for unit, computing and storing them on a miss.
+
+        owner is the object entries are filed under (defaults to unit); pass the
+        live unit when unit is a snapshot clone so later snapshots still hit.
+        """
+        if owner is None:
+            owner = unit
+        key = self._unit_key(unit)
+        entry = self._entries.get(id(owner))
+        if entry is not None and entry.unit is owner and entry.key == key:
+            self.hits += 1
+            return list(entry.moves)
+
+        self.misses += 1
+        moves = list(compute())
+        center = self._hex_grid.offset_to_axial(unit.x, unit.y)
+        reach = 0
+        for move_x, move_y in moves:
+            distance = center.distance_to(self._hex_grid.offset_to_axial(move_x, move_y))
+            if distance > reach:
+                reach = distance
+        self._entries[id(owner)] = _CacheEntry(
+            owner, key, tuple(moves), center, reach + self.REACH_MARGIN
+        )
+        return moves
+
+    def fork(self, touched_tiles: Iterable[Tuple[int, int]]) -> 'MoveGenerationCache':
+        """A copy for a position one action further on, without entries near touched_tiles.
+
+        Entries are never mutated, so the copy shares them with this cache.
+        """
+        child = MoveGenerationCache()
+        child._entries = dict(self._entries)
+        child.note_action(touched_tiles)
+        return child
+
+    def note_action(self, touched_tiles: Iterable[Tuple[int, int]]) -> int:
+        """Invalidate entries within reach of touched tiles.
+
+        Returns the number of invalidated entries.
+        """
+        touched_hexes = [
+            self._hex_grid.offset_to_axial(tile_x, tile_y)
+            for tile_x, tile_y in set(touched_tiles)
+        ]
+        if not touched_hexes:
+            return 0
+
+        stale = [
+            unit_id
+            for unit_id, entry in self._entries.items()
+            if any(entry.center.distance_to(tile_hex) <= entry.radius for tile_hex in touched_hexes)
+        ]
+        for unit_id in stale:
+            del self._entries[unit_id]
+        return len(stale)
+
+    def __len__(self) -> int:
+        return len(self._entries)
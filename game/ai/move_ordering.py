@@ -0,0 +1,89 @@
+"""Killer-move and history heuristics for AI search move ordering"""
+from typing import Dict, List, Tuple
+
+
+class MoveOrderingHeuristics:
+    """Tracks quiet moves that caused beta cutoffs and ranks moves with them.
+
+    Killer moves are kept per ply (two slots each) and recognised in sibling
+    positions by a signature of unit name and tiles, since simulated states hold
+    cloned units. The history table is keyed on (unit class, from-tile, to-tile)
+    and accumulates depth^2 for every cutoff, so it generalises across units.
+    """
+
+    KILLER_SLOTS = 2
+
+    def __init__(self):
+        self._killers: Dict[int, List[Tuple]] = {}
+        self._history: Dict[Tuple, int] = {}
+        self._origin_best: Dict[Tuple, int] = {}
+
+    def reset_killers(self):
+        self._killers.clear()
+
+    def reset(self):
+        self._killers.clear()
+        self._history.clear()
+        self._origin_best.clear()
+
+    @staticmethod
+    def _target_tile(move) -> Tuple[int, int]:
+        if move[0] == 'attack':
+            return (move[2].x, move[2].y)
+        return (move[2], move[3])
+
+    @classmethod
+    def move_signature(cls, move) -> Tuple:
+        unit = move[1]
+        return (move[0], unit.name, (unit.x, unit.y), cls._target_tile(move))
+
+    @classmethod
+    def history_key(cls, move) -> Tuple:
+        unit = move[1]
+        return (unit.unit_class, (unit.x, unit.y), cls._target_tile(move))
+
+    def get_killers(self, ply: int) -> List[Tuple]:
+        return self._killers.get(ply, [])
+
+    def get_history_score(self, move) -> int:
+        return self._history.get(self.history_key(move), 0)
+
+    def get_origin_score(self, unit) -> int:
+        """Best history score of any quiet move from unit's current tile"""
+        return self._origin_best.get((unit.unit_class, (unit.x, unit.y)), 0)
+
+    def record_cutoff(self, move, ply: int, depth: int):
+        """Remember a quiet move that refuted its siblings"""
+        if move[0] == 'attack':
+            return  # Attacks are already ordered first by their own value
+
+        signature = self.move_signature(move)
+        killers = self._killers.setdefault(ply, [])
+        if signature in killers:
+            killers.remove(signature)
+        killers.insert(0, signature)
+        del killers[self.KILLER_SLOTS:]
+
+        key = self.history_key(move)
+        score = self._history.get(key, 0) + depth * depth
+        self._history[key] = score
+        origin = key[:2]
+        if score > self._origin_best.get(origin, 0):
+            self._origin_best[origin] = score
+
+    def order_moves(self, moves: List, ply: int) -> List:
+        """Sort moves: attacks by value, then killers, then quiet moves by history.
+
+        The sort is stable, so quiet moves without history keep generation order.
+        """
+        killers = self.get_killers(ply)
+
+        def move_priority(move):
+            if move[0] == 'attack':
+                return (3, move[3])  # Index 3 is attack value
+            signature = self.move_signature(move)
+            if signature in killers:
+                return (2, -killers.index(signature))
+            return (1, self.get_history_score(move))
+
+        return sorted(moves, key=move_priority, reverse=True)
@@ -0,0 +1,93 @@
+"""Lazy staged move generation for AI search"""
+from typing import Dict, Iterator, List, Optional, Set, Tuple
+
+from game.ai.move_ordering import MoveOrderingHeuristics
+
+
+class StagedMoveGenerator:
+    """Yields one position's moves in search order, computing quiet moves on demand.
+
+    Stages:
+    1. Attacks, by attack value. These need no reachability search.
+    2. Killer moves for the ply that are still legal here. Only the killer's
+       own unit is expanded to check this.
+    3. Quiet moves, one unit at a time. Units are visited by their best history
+       score from their current tile and each unit's moves by history score.
+
+    A search that stops early (beta cutoff or width limit) never runs
+    reachability for the units it did not reach. Without heuristics, stages 2
+    and 3 keep plain generation order.
+    """
+
+    def __init__(self, ai_player, game_state, heuristics: Optional[MoveOrderingHeuristics] = None, ply: int = 0):
+        self._ai = ai_player
+        self._game_state = game_state
+        self._heuristics = heuristics
+        self._ply = ply
+        self._own_units = [k for k in game_state.knights if k.player_id == ai_player.player_id]
+        self._unit_moves: Dict[int, List[Tuple]] = {}
+        # Units whose reachable tiles were computed
+        self.units_expanded = 0
+
+    def __iter__(self) -> Iterator[Tuple]:
+        yield from self._attacks()
+
+        yielded: Set[Tuple] = set()
+        for move in self._killers():
+            yielded.add(MoveOrderingHeuristics.move_signature(move))
+            yield move
+
+        for unit in self._quiet_unit_order():
+            for move in self._ordered_unit_moves(unit):
+                if yielded and MoveOrderingHeuristics.move_signature(move) in yielded:
+                    continue
+                yield move
+
+    def _attacks(self) -> List[Tuple]:
+        attacks = []
+        for knight in self._own_units:
+            if knight.can_attack():
+                attacks.extend(self._ai.get_unit_attacks(knight, self._game_state, self._ai._hex_grid))
+        attacks.sort(key=lambda m: m[3], reverse=True)  # Index 3 is attack value
+        return attacks
+
+    def _killers(self) -> List[Tuple]:
+        if self._heuristics is None:
+            return []
+
+        moves = []
+        for move_type, name, from_tile, target_tile in self._heuristics.get_killers(self._ply):
+            unit = self._find_unit(name, from_tile)
+            if unit is None or not unit.can_move():
+                continue
+            for move in self._moves_of(unit):
+                if move[0] == move_type and (move[2], move[3]) == target_tile:
+                    moves.append(move)
+                    break
+        return moves
+
+    def _find_unit(self, name, tile):
+        for unit in self._own_units:
+            if unit.name == name and (unit.x, unit.y) == tile:
+                return unit
+        return None
+
+    def _quiet_unit_order(self) -> List:
+        movable = [unit for unit in self._own_units if unit.can_move()]
+        if self._heuristics is None:
+            return movable
+        return sorted(movable, key=self._heuristics.get_origin_score, reverse=True)
+
+    def _ordered_unit_moves(self, unit) -> List[Tuple]:
+        moves = self._moves_of(unit)
+        if self._heuristics is None:
+            return moves
+        return sorted(moves, key=self._heuristics.get_history_score, reverse=True)
+
+    def _moves_of(self, unit) -> List[Tuple]:
+        moves = self._unit_moves.get(id(unit))
+        if moves is None:
+            self.units_expanded += 1
+            moves = self._ai.get_unit_moves(unit, self._game_state)
+            self._unit_moves[id(unit)] = moves
+        return moves
@@ -21,6 +21,14 @@ class BattleContextAdapter:
     def knights(self):
         return self._battle_state.knights
 
+    @property
+    def unit_table(self):
+        return getattr(self._battle_state, 'unit_table', None)
+
+    @property
+    def flee_fields(self):
+        return getattr(self._battle_state, 'flee_fields', None)
+
     @property
     def castles(self):
         return self._battle_state.castles
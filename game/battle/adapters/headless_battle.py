@@ -0,0 +1,228 @@
+"""Headless battle driver: AI players act through the battle command handlers."""
+from __future__ import annotations
+
+import contextlib
+import io
+import time
+from dataclasses import dataclass, field
+
+from game.battle.adapters.battle_context import BattleContextAdapter
+from game.battle.application.commands import AttackUnitCommand, ChargeUnitCommand, MoveUnitCommand
+from game.battle.application.handlers import AttackUnitHandler, ChargeUnitHandler, MoveUnitHandler
+from game.battle.domain.events import AttackResolved, ChargeResolved, UnitMoved
+from game.entities.unit_helpers import check_cavalry_disruption_for_terrain
+
+
+# Phases of an AI turn that are timed separately
+AI_PHASES = ('plan', 'apply', 'end_turn')
+
+
+@dataclass
+class PhaseStats:
+    seconds: float = 0.0
+    calls: int = 0
+    nodes: int = 0
+
+    def merge(self, other: 'PhaseStats') -> None:
+        self.seconds += other.seconds
+        self.calls += other.calls
+        self.nodes += other.nodes
+
+
+@dataclass
+class BattleOutcome:
+    """Result of one headless battle"""
+    winner: int | None
+    turns: int
+    actions: int
+    # Planned actions the command handlers refused
+    rejected: int = 0
+    phases: dict = field(default_factory=lambda: {
+        player_id: {phase: PhaseStats() for phase in AI_PHASES} for player_id in (1, 2)
+    })
+
+
+class HeadlessBattle:
+    """Plays a BattleState between two AIPlayers without a window or animations.
+
+    Actions go through the same command handlers the UI uses. This class is
+    their event sink and applies each event at once: moves land immediately
+    (with the facing and disruption updates the move animations perform), and
+    attack effects were already applied by the handlers.
+    """
+
+    def __init__(self, battle_state, ai_players: dict):
+        if battle_state is None:
+            raise ValueError("battle_state is required for a headless battle")
+        if set(ai_players) != {1, 2}:
+            raise ValueError("ai_players must map player ids 1 and 2 to AIPlayers")
+        for player_id, ai_player in ai_players.items():
+            if ai_player.player_id != player_id:
+                raise ValueError(f"AI for player {player_id} has player_id {ai_player.player_id}")
+        self.battle_state = battle_state
+        self.ai_players = ai_players
+        # AI move generation skips tiles other units are still moving to
+        self.pending_positions = {}
+        self._context = BattleContextAdapter(battle_state)
+
+    # IGameState-style view of the battle for the AI and the handlers
+    @property
+    def board_width(self):
+        return self.battle_state.board_width
+
+    @property
+    def board_height(self):
+        return self.battle_state.board_height
+
+    @property
+    def knights(self):
+        return self.battle_state.knights
+
+    @property
+    def unit_table(self):
+        return getattr(self.battle_state, 'unit_table', None)
+
+    @property
+    def flee_fields(self):
+        return getattr(self.battle_state, 'flee_fields', None)
+
+    @property
+    def castles(self):
+        return self.battle_state.castles
+
+    @property
+    def terrain_map(self):
+        return self.battle_state.terrain_map
+
+    @property
+    def fog_of_war(self):
+        return self.battle_state.fog_of_war
+
+    @property
+    def current_player(self):
+        return self.battle_state.current_player
+
+    @property
+    def fog_view_player(self):
+        # Each AI sees the battle through its own fog
+        return self.battle_state.current_player
+
+    def get_knight_at(self, x, y):
+        return self.battle_state.get_knight_at(x, y)
+
+    def get_unit_at(self, x, y):
+        return self.battle_state.get_unit_at(x, y)
+
+    def play(self, max_turns: int, quiet: bool = True) -> BattleOutcome:
+        """Alternate AI turns until one side wins or max_turns full turns have passed"""
+        if max_turns <= 0:
+            raise ValueError("max_turns must be positive")
+        outcome = BattleOutcome(winner=None, turns=0, actions=0)
+        output = contextlib.redirect_stdout(io.StringIO()) if quiet else contextlib.nullcontext()
+        with output:
+            self.battle_state.update_all_fog_of_war()
+            while self.battle_state.turn_number <= max_turns:
+                outcome.winner = self.battle_state.check_victory()
+                if outcome.winner is not None:
+                    break
+                self.play_turn(outcome)
+        outcome.turns = min(self.battle_state.turn_number, max_turns)
+        if outcome.winner is None:
+            outcome.winner = self.battle_state.check_victory()
+        return outcome
+
+    def play_turn(self, outcome: BattleOutcome) -> None:
+        """Play the current player's turn, adding its actions and timings to outcome"""
+        ai_player = self.ai_players[self.battle_state.current_player]
+        phases = outcome.phases[self.battle_state.current_player]
+        touched_tiles = []
+        ai_player.begin_turn(self)
+        try:
+            for _ in range(ai_player.max_turn_actions(self)):
+                start = time.perf_counter()
+                action = ai_player.plan_action(self, touched_tiles)
+                self._record(phases['plan'], start, ai_player.nodes_searched if action else 0)
+                if not action:
+                    break
+
+                start = time.perf_counter()
+                touched_tiles = ai_player._action_touched_tiles(action, self)
+                if self.apply_action(action):
+                    outcome.actions += 1
+                else:
+                    outcome.rejected += 1
+                touched_tiles.extend(ai_player._action_touched_tiles(action, self))
+                self.battle_state.cleanup_dead_knights()
+                self.battle_state.update_zoc_status()
+                self.battle_state.update_all_fog_of_war()
+                self._record(phases['apply'], start)
+                if self.battle_state.check_victory() is not None:
+                    break
+        finally:
+            ai_player.end_turn()
+
+        start = time.perf_counter()
+        self.battle_state.end_turn()
+        self.battle_state.cleanup_dead_knights()
+        self._record(phases['end_turn'], start)
+
+    def apply_action(self, action) -> bool:
+        """Run an AI action through the matching command handler"""
+        move_type = action[0]
+        unit = action[1]
+        if unit not in self.battle_state.knights:
+            return False
+        self._context.fog_view_player = self.fog_view_player
+        if move_type == 'move':
+            command = MoveUnitCommand(unit_id=id(unit), to_x=action[2], to_y=action[3])
+            return MoveUnitHandler(self._context, self).handle(command)
+        target = action[2]
+        if target not in self.battle_state.knights:
+            return False
+        if move_type == 'attack':
+            command = AttackUnitCommand(
+                attacker_id=id(unit), target_x=target.x, target_y=target.y
+            )
+            return AttackUnitHandler(self._context, self).handle(command)
+        if move_type == 'charge':
+            command = ChargeUnitCommand(attacker_id=id(unit), target_x=target.x, target_y=target.y)
+            return ChargeUnitHandler(self._context, self).handle(command)
+        raise ValueError(f"Unknown AI action type: {move_type}")
+
+    def publish(self, event) -> None:
+        self.battle_state.engagement.publish(event)
+        if isinstance(event, UnitMoved):
+            self._apply_unit_moved(event)
+            return
+        if isinstance(event, (AttackResolved, ChargeResolved)):
+            if isinstance(event, ChargeResolved) and event.attacker_to:
+                attacker = self._unit(event.attacker_id)
+                attacker.x, attacker.y = event.attacker_to
+            return
+        raise ValueError(f"Unsupported event type: {type(event).__name__}")
+
+    def _apply_unit_moved(self, event: UnitMoved) -> None:
+        unit = self._unit(event.unit_id)
+        if hasattr(unit, 'facing'):
+            previous = (event.from_x, event.from_y)
+            for step in event.path or [(event.to_x, event.to_y)]:
+                if step != previous:
+                    unit.facing.update_facing_from_movement(previous[0], previous[1], step[0], step[1])
+                previous = step
+            if event.final_face_target:
+                target_x, target_y = event.final_face_target
+                unit.facing.face_towards(target_x, target_y, event.to_x, event.to_y)
+        unit.x, unit.y = event.to_x, event.to_y
+        check_cavalry_disruption_for_terrain(unit, self.battle_state)
+
+    def _unit(self, unit_id):
+        unit = self._context.get_unit_by_id(unit_id)
+        if unit is None:
+            raise ValueError(f"unit_id not found: {unit_id}")
+        return unit
+
+    @staticmethod
+    def _record(stats: PhaseStats, start: float, nodes: int = 0) -> None:
+        stats.seconds += time.perf_counter() - start
+        stats.calls += 1
+        stats.nodes += nodes
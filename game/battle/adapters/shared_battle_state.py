@@ -0,0 +1,153 @@
+"""
+Copy-on-write battle state for "what if" copies of a battle.
+
+Forking a state is O(1): the child shares its parent's unit records, castles,
+terrain and fog of war. A unit is cloned only when a state first writes to it,
+so a simulated action copies the units it touches and nothing else.
+"""
+from typing import Dict, Optional, Sequence, Tuple
+
+from game.interfaces.game_state import IGameState
+from game.systems.flee_field import FleeFieldCache
+
+
+class SharedBattleState(IGameState):
+    """Battle state whose unit records are shared with the state it was forked from.
+
+    Units reached through ``knights`` may belong to an ancestor state (or, for
+    ``share``, to the live battle) and must be treated as read-only. Mutate a
+    unit only through ``writable`` and remove it with ``remove_unit``.
+    ``knights`` and ``castles`` are tuples so an accidental in-place change to a
+    shared sequence fails loudly. Forks share one FleeFieldCache, whose fields
+    are keyed by the enemy units they were built from.
+    """
+
+    def __init__(self, board_width: int, board_height: int, knights: Sequence, castles: Sequence,
+                 terrain_map, current_player: int, fog_of_war, origins: Optional[Tuple[int, ...]] = None,
+                 flee_fields: Optional[FleeFieldCache] = None):
+        self._board_width = board_width
+        self._board_height = board_height
+        self._knights = tuple(knights)
+        self._castles = tuple(castles)
+        self._terrain_map = terrain_map
+        self._current_player = current_player
+        self._fog_of_war = fog_of_war
+        # Index in the parent state of each unit record; None while they still line up
+        self._origins = origins
+        # id() of units this state cloned and may therefore mutate
+        self._owned_ids = set()
+        self._flee_fields = flee_fields if flee_fields is not None else FleeFieldCache()
+
+    @staticmethod
+    def share(game_state) -> 'SharedBattleState':
+        """A state over game_state's own units, without cloning them.
+
+        Only valid while game_state does not change, e.g. for the duration of a
+        synchronous search; capture a BattleSnapshot for anything longer lived.
+        """
+        if game_state is None:
+            raise ValueError("game_state is required to share a battle state")
+        if not hasattr(game_state, 'fog_of_war'):
+            raise AttributeError("game_state.fog_of_war is required for a shared battle state")
+        return SharedBattleState(
+            game_state.board_width,
+            game_state.board_height,
+            game_state.knights,
+            game_state.castles,
+            getattr(game_state, 'terrain_map', None),
+            game_state.current_player,
+            game_state.fog_of_war,
+            flee_fields=getattr(game_state, 'flee_fields', None),
+        )
+
+    def fork(self) -> 'SharedBattleState':
+        """A child state sharing every unit record with this one"""
+        return SharedBattleState(
+            self._board_width,
+            self._board_height,
+            self._knights,
+            self._castles,
+            self._terrain_map,
+            self._current_player,
+            self._fog_of_war,
+            flee_fields=self._flee_fields,
+        )
+
+    @property
+    def board_width(self):
+        return self._board_width
+
+    @property
+    def board_height(self):
+        return self._board_height
+
+    @property
+    def knights(self):
+        return self._knights
+
+    @property
+    def castles(self):
+        return self._castles
+
+    @property
+    def terrain_map(self):
+        return self._terrain_map
+
+    @property
+    def current_player(self):
+        return self._current_player
+
+    @property
+    def fog_of_war(self):
+        return self._fog_of_war
+
+    @property
+    def flee_fields(self):
+        return self._flee_fields
+
+    def get_knight_at(self, tile_x, tile_y):
+        for knight in self._knights:
+            if knight.x == tile_x and knight.y == tile_y:
+                return knight
+        return None
+
+    def get_unit_at(self, x, y):
+        return self.get_knight_at(x, y)
+
+    def owns(self, unit) -> bool:
+        """Whether unit is this state's private copy"""
+        return id(unit) in self._owned_ids
+
+    def writable(self, unit):
+        """This state's own copy of unit, cloning it on first write.
+
+        unit must be one of this state's records.
+        """
+        if id(unit) in self._owned_ids:
+            return unit
+        index = self._index_of(unit)
+        clone = unit.clone_for_simulation()
+        knights = list(self._knights)
+        knights[index] = clone
+        self._knights = tuple(knights)
+        self._owned_ids.add(id(clone))
+        return clone
+
+    def remove_unit(self, unit) -> None:
+        index = self._index_of(unit)
+        origins = self._origins if self._origins is not None else tuple(range(len(self._knights)))
+        self._knights = self._knights[:index] + self._knights[index + 1:]
+        self._origins = origins[:index] + origins[index + 1:]
+        self._owned_ids.discard(id(unit))
+
+    def origin_indices(self) -> Dict[int, int]:
+        """id() of each unit record mapped to its index in the state it came from"""
+        if self._origins is None:
+            return {id(knight): index for index, knight in enumerate(self._knights)}
+        return {id(knight): origin for knight, origin in zip(self._knights, self._origins)}
+
+    def _index_of(self, unit) -> int:
+        for index, knight in enumerate(self._knights):
+            if knight is unit:
+                return index
+        raise ValueError(f"{getattr(unit, 'name', unit)} is not part of this battle state")
@@ -168,10 +168,10 @@ class AttackBehavior(Behavior):
         should_check_routing = False
         
         if hasattr(target, 'facing'):
-            attack_angle = target.facing.get_attack_angle(unit.x, unit.y, target.x, target.y)
-            extra_morale_penalty = target.facing.get_morale_penalty(attack_angle)
-            if hasattr(target.facing, 'get_cohesion_penalty'):
-                extra_cohesion_penalty = target.facing.get_cohesion_penalty(attack_angle)
+            attack_arc = target.facing.get_attack_arc(unit.x, unit.y, target.x, target.y)
+            attack_angle = attack_arc.angle
+            extra_morale_penalty = attack_arc.morale_penalty
+            extra_cohesion_penalty = attack_arc.cohesion_penalty
 
             # Check for routing on rear/flank attacks
             if attack_angle.is_rear or attack_angle.is_flank:
@@ -264,9 +264,7 @@ class AttackBehavior(Behavior):
             
         # Apply facing modifier
         if hasattr(target, 'facing'):
-            attack_angle = target.facing.get_attack_angle(attacker.x, attacker.y, target.x, target.y)
-            facing_modifier = target.facing.get_damage_modifier(attack_angle)
-            base_damage *= facing_modifier
+            base_damage *= target.facing.get_attack_arc(attacker.x, attacker.y, target.x, target.y).damage_modifier
             
         # Apply height advantage/disadvantage for ranged attacks
         if self.attack_range > 1 and attacker_terrain and target_terrain:
@@ -350,7 +348,7 @@ class AttackBehavior(Behavior):
     def _is_valid_target(self, unit, target, game_state) -> bool:
         """Check if a target is valid for attack"""
         # Check fog of war visibility
-        if hasattr(game_state, 'fog_of_war') and game_state.current_player is not None:
+        if getattr(game_state, 'fog_of_war', None) is not None and game_state.current_player is not None:
             visibility = game_state.fog_of_war.get_visibility_state(
                 game_state.current_player, target.x, target.y
             )
@@ -438,7 +436,7 @@ class ArcherAttackBehavior(AttackBehavior):
         
     def _has_line_of_sight(self, unit, target, game_state) -> bool:
         """Check if archer has line of sight to target"""
-        if not hasattr(game_state, 'fog_of_war'):
+        if getattr(game_state, 'fog_of_war', None) is None:
             return True
             
         # Check if unit has elevated vision
@@ -5,8 +5,42 @@ import math
 from game.components.base import Behavior
 from game.pathfinding import PathFinder, DijkstraPathFinder, AStarPathFinder
 from game.hex_utils import HexGrid
+from game.systems.flee_field import FleeField
 from game.entities.knight import KnightClass
 from game.visibility import VisibilityState
+from game.entities.unit_table import UnitTable, NO_PLAYER, FLAG_ROUTING
+
+# Offset-coordinate square around a tile, as used by formation and ZOC checks
+SQUARE_NEIGHBOURS = ((0, 1), (0, -1), (1, 0), (-1, 0), (1, 1), (1, -1), (-1, 1), (-1, -1))
+
+
+class MovementOccupancy:
+    """Tiles of a moving unit's friends, enemies and enemy ZOC.
+
+    Read once from the unit table so pathfinding cost functions answer
+    formation and ZOC questions with set lookups instead of scanning units
+    per tile.
+    """
+
+    def __init__(self, unit, game_state):
+        units = UnitTable.of(game_state)
+        own = NO_PLAYER if unit.player_id is None else unit.player_id
+        self.friendly_tiles = set()
+        self.enemy_tiles = set()
+        self.zoc_tiles = set()
+        for other, x, y, player, flags in zip(units.units, units.x, units.y, units.player, units.flags):
+            if player == own:
+                if other is not unit and not flags & FLAG_ROUTING:
+                    self.friendly_tiles.add((x, y))
+                continue
+            self.enemy_tiles.add((x, y))
+            if other.has_zone_of_control():
+                self.zoc_tiles.update((x + dx, y + dy) for dx, dy in SQUARE_NEIGHBOURS)
+
+    def has_adjacent_friendly(self, x: int, y: int) -> bool:
+        friendly = self.friendly_tiles
+        return any((x + dx, y + dy) in friendly for dx, dy in SQUARE_NEIGHBOURS)
+
 
 class MovementBehavior(Behavior):
     """Basic movement behavior"""
@@ -28,7 +62,8 @@ class MovementBehavior(Behavior):
         # This allows units to enter ZOC to engage enemies
         return True
         
-    def get_ap_cost(self, from_pos: Tuple[int, int], to_pos: Tuple[int, int], unit, game_state) -> int:
+    def get_ap_cost(self, from_pos: Tuple[int, int], to_pos: Tuple[int, int], unit, game_state,
+                    occupancy: Optional[MovementOccupancy] = None) -> int:
         """Calculate AP cost for movement based on terrain and conditions"""
         # Base movement cost
         terrain_cost = 1.0
@@ -40,7 +75,7 @@ class MovementBehavior(Behavior):
             terrain_cost += 1  # Extra AP to disengage
             
         # Penalty for breaking formation
-        if self._would_break_formation(from_pos, to_pos, unit, game_state):
+        if self._would_break_formation(from_pos, to_pos, unit, game_state, occupancy):
             terrain_cost += 1  # Formation breaking penalty
             
         # Handle impassable terrain
@@ -115,9 +150,11 @@ class MovementBehavior(Behavior):
             return []
             
         # Define custom cost function for ZOC
+        occupancy = MovementOccupancy(unit, game_state)
+
         def custom_get_cost(from_pos, to_pos, game_state, unit):
-            base = self.get_ap_cost(from_pos, to_pos, unit, game_state)
-            if self._zoc_transition_blocked(from_pos, to_pos, unit, game_state):
+            base = self.get_ap_cost(from_pos, to_pos, unit, game_state, occupancy)
+            if self._zoc_transition_blocked(from_pos, to_pos, unit, game_state, occupancy):
                 return float('inf')
             return base
         
@@ -152,9 +189,11 @@ class MovementBehavior(Behavior):
             return self._get_routing_moves(unit, game_state)
             
         # Define custom cost function for ZOC
+        occupancy = MovementOccupancy(unit, game_state)
+
         def custom_get_cost(from_pos, to_pos, game_state, unit):
-            base_cost = self.get_ap_cost(from_pos, to_pos, unit, game_state)
-            if self._zoc_transition_blocked(from_pos, to_pos, unit, game_state):
+            base_cost = self.get_ap_cost(from_pos, to_pos, unit, game_state, occupancy)
+            if self._zoc_transition_blocked(from_pos, to_pos, unit, game_state, occupancy):
                 return float('inf')
             return base_cost
 
@@ -205,15 +244,22 @@ class MovementBehavior(Behavior):
                         moves.append((x, y))
             return moves
         
-    def _would_break_formation(self, from_pos: Tuple[int, int], to_pos: Tuple[int, int], unit, game_state) -> bool:
+    def _would_break_formation(self, from_pos: Tuple[int, int], to_pos: Tuple[int, int], unit, game_state,
+                               occupancy: Optional[MovementOccupancy] = None) -> bool:
         """Check if this move would break formation"""
+        if occupancy is not None:
+            has_adjacent_friendly = occupancy.has_adjacent_friendly
+        else:
+            def has_adjacent_friendly(x, y):
+                return self._has_adjacent_friendly(x, y, unit, game_state)
+
         # Check if we start adjacent to friendly units
-        has_friendly_at_start = self._has_adjacent_friendly(from_pos[0], from_pos[1], unit, game_state)
+        has_friendly_at_start = has_adjacent_friendly(from_pos[0], from_pos[1])
         if not has_friendly_at_start:
             return False  # No formation to break
             
         # Check if we'll still be adjacent to friendlies after move
-        has_friendly_at_end = self._has_adjacent_friendly(to_pos[0], to_pos[1], unit, game_state)
+        has_friendly_at_end = has_adjacent_friendly(to_pos[0], to_pos[1])
         
         return not has_friendly_at_end  # Breaking formation if no longer adjacent
         
@@ -280,49 +326,41 @@ class MovementBehavior(Behavior):
         return in_zoc
 
     def _zoc_transition_blocked(self, from_pos: Tuple[int, int], to_pos: Tuple[int, int],
-                                unit, game_state) -> bool:
+                                unit, game_state, occupancy: Optional[MovementOccupancy] = None) -> bool:
         """Check if moving from one tile to another violates ZOC rules"""
         # Only restrict if unit is currently outside enemy ZOC
         if unit.in_enemy_zoc:
             return False
 
-        from_in_zoc = self._is_enemy_zoc_tile(from_pos[0], from_pos[1], unit, game_state)
-        to_in_zoc = self._is_enemy_zoc_tile(to_pos[0], to_pos[1], unit, game_state)
+        if occupancy is not None:
+            from_in_zoc = from_pos in occupancy.zoc_tiles
+            to_in_zoc = to_pos in occupancy.zoc_tiles
+            enemy_at_target = to_pos in occupancy.enemy_tiles
+        else:
+            from_in_zoc = self._is_enemy_zoc_tile(from_pos[0], from_pos[1], unit, game_state)
+            to_in_zoc = self._is_enemy_zoc_tile(to_pos[0], to_pos[1], unit, game_state)
+            enemy_at_target = self._is_enemy_at(to_pos[0], to_pos[1], unit, game_state)
 
         # Once we enter enemy ZOC we cannot leave in the same movement
-        if from_in_zoc and not to_in_zoc and not self._is_enemy_at(to_pos[0], to_pos[1], unit, game_state):
+        if from_in_zoc and not to_in_zoc and not enemy_at_target:
             return True
 
         return False
         
     def _get_routing_moves(self, unit, game_state) -> List[Tuple[int, int]]:
-        """Get movement options for routing units (away from enemies)"""
-        moves = []
-        board_width = game_state.board_width
-        board_height = game_state.board_height
-        
-        # Find nearest enemies
-        enemies = [k for k in game_state.knights if k.player_id != unit.player_id]
-        if not enemies:
+        """Get movement options for routing units (away from enemies), best first"""
+        if not any(k.player_id != unit.player_id for k in game_state.knights):
             return []
-            
-        # Try to move away from nearest enemy
-        nearest_enemy = min(enemies, key=lambda e: abs(e.x - unit.x) + abs(e.y - unit.y))
-        
-        # Check all 8 directions for routing
-        for dx, dy in [(0, 1), (0, -1), (1, 0), (-1, 0), (1, 1), (1, -1), (-1, 1), (-1, -1)]:
-            new_x, new_y = unit.x + dx, unit.y + dy
-            
-            if not (0 <= new_x < board_width and 0 <= new_y < board_height):
-                continue
-                
-            # Check if this moves away from nearest enemy
-            current_dist = abs(unit.x - nearest_enemy.x) + abs(unit.y - nearest_enemy.y)
-            new_dist = abs(new_x - nearest_enemy.x) + abs(new_y - nearest_enemy.y)
-            
-            if new_dist > current_dist and not self._is_enemy_at(new_x, new_y, unit, game_state):
+
+        # Distance from enemies is the cheapest movement cost any of them pays to
+        # reach a tile; friendly units don't shield the tiles behind them
+        flee_field = FleeField.for_player(game_state, unit.player_id)
+
+        moves = []
+        for new_x, new_y in flee_field.flee_steps(unit.x, unit.y, unit):
+            if not self._is_enemy_at(new_x, new_y, unit, game_state):
                 moves.append((new_x, new_y))
-                
+
         return moves
         
     def get_auto_face_target(self, unit, game_state, x: int, y: int) -> Optional[Tuple[int, int]]:
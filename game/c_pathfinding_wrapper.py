@@ -6,7 +6,8 @@ except ImportError:
 
 from typing import List, Tuple, Optional, Dict
 from game.pathfinding import PathFinder
-from game.terrain import TerrainType, Terrain
+from game.terrain import TERRAIN_TYPE_IDS, TERRAIN_TYPES, TerrainType, Terrain
+from game.entities.unit_table import UnitTable, NO_PLAYER
 
 class CPathFinder(PathFinder):
     """PathFinder implementation using optimized C extension"""
@@ -22,6 +23,12 @@ class CPathFinder(PathFinder):
         map_revision = getattr(map_obj, "revision", None)
         cache_key = (map_id, map_revision, width, height)
 
+        if cache_key not in self._terrain_cache and hasattr(map_obj, 'type_ids'):
+            # Array-backed maps already store these ids, one byte per tile
+            terrain_types = list(TERRAIN_TYPES)
+            self._drop_stale(map_id, cache_key)
+            self._terrain_cache[cache_key] = (map_obj.type_ids(), dict(TERRAIN_TYPE_IDS), terrain_types)
+
         if cache_key not in self._terrain_cache:
             terrain_types = list(TerrainType)
             type_to_id = {t: i for i, t in enumerate(terrain_types)}
@@ -31,18 +38,74 @@ class CPathFinder(PathFinder):
                 for x in range(width):
                     terrain = map_obj.get_terrain(x, y)
                     if terrain:
-                        grid.append(type_to_id[terrain.type])
+                        # Unknown terrain types get the default cost (id -1)
+                        grid.append(type_to_id.get(terrain.type, -1))
                     else:
                         grid.append(-1)
 
-            stale_keys = [key for key in self._terrain_cache if key[0] == map_id and key != cache_key]
-            for stale_key in stale_keys:
-                del self._terrain_cache[stale_key]
-
+            self._drop_stale(map_id, cache_key)
             self._terrain_cache[cache_key] = (grid, type_to_id, terrain_types)
 
         return self._terrain_cache[cache_key]
+
+    def _drop_stale(self, map_id, cache_key) -> None:
+        stale_keys = [key for key in self._terrain_cache if key[0] == map_id and key != cache_key]
+        for stale_key in stale_keys:
+            del self._terrain_cache[stale_key]
+
+    def get_terrain_grid(self, game_state):
+        """Flattened terrain ids for the board: (grid, type_to_id, terrain_types)"""
+        return self._get_or_build_terrain_cache(game_state)
+
+    @staticmethod
+    def build_cost_map(unit, type_to_id, terrain_types) -> Dict[int, float]:
+        """Movement cost per terrain id for a unit"""
+        cost_map = {}
+        for t in terrain_types:
+            # We create a dummy terrain to check cost
+            # This relies on terrain system not needing position for base cost
+            temp_terrain = Terrain(t)
+            cost = temp_terrain.get_movement_cost_for_unit(unit)
+            cost_map[type_to_id[t]] = float(cost)
+        return cost_map
         
+    @staticmethod
+    def build_blocked_mask(game_state, units: Optional[UnitTable], unit) -> bytearray:
+        """Byte per tile, set where enemies of unit stand or a castle stands"""
+        width = game_state.board_width
+        height = game_state.board_height
+        mask = bytearray(width * height)
+        if units is not None:
+            own = NO_PLAYER if unit.player_id is None else unit.player_id
+            for x, y, player in zip(units.x, units.y, units.player):
+                if player != own and 0 <= x < width and 0 <= y < height:
+                    mask[y * width + x] = 1
+
+        if hasattr(game_state, 'castles'):
+            for castle in game_state.castles:
+                if hasattr(castle, 'occupied_tiles'):
+                    for x, y in castle.occupied_tiles:
+                        if 0 <= x < width and 0 <= y < height:
+                            mask[y * width + x] = 1
+        return mask
+
+    @staticmethod
+    def build_zoc_mask(width: int, height: int, units: UnitTable, unit) -> Optional[bytearray]:
+        """Byte per tile, set next to enemies of unit that exert ZOC; None if there are none"""
+        own = NO_PLAYER if unit.player_id is None else unit.player_id
+        mask = None
+        for enemy, ex, ey, player in zip(units.units, units.x, units.y, units.player):
+            if player == own or not enemy.has_zone_of_control():
+                continue
+            if mask is None:
+                mask = bytearray(width * height)
+            for y in range(max(0, ey - 1), min(height, ey + 2)):
+                row = y * width
+                for x in range(max(0, ex - 1), min(width, ex + 2)):
+                    if x != ex or y != ey:
+                        mask[row + x] = 1
+        return mask
+
     def find_path(self, start: Tuple[int, int], end: Tuple[int, int], 
                   game_state, unit=None, max_cost: Optional[float] = None,
                   cost_function=None) -> Optional[List[Tuple[int, int]]]:
@@ -59,27 +122,11 @@ class CPathFinder(PathFinder):
         # 2. Build Cost Map for this Unit
         # We can cache this per unit_class too, but unit behavior might change (items, buffs)
         # So we compute it. It's fast (num_terrain_types is small, ~15).
-        cost_map = {}
-        for t in terrain_types:
-            # We create a dummy terrain to check cost
-            # This relies on terrain system not needing position for base cost
-            temp_terrain = Terrain(t)
-            cost = temp_terrain.get_movement_cost_for_unit(unit)
-            cost_map[type_to_id[t]] = float(cost)
+        cost_map = self.build_cost_map(unit, type_to_id, terrain_types)
             
         # 3. Blockers
-        blockers = []
-        if unit:
-            for knight in game_state.knights:
-                # Block if enemy
-                if knight.player_id != unit.player_id:
-                     blockers.append((knight.x, knight.y))
-        
-        # Add castles to blockers
-        if hasattr(game_state, 'castles'):
-            for castle in game_state.castles:
-                if hasattr(castle, 'occupied_tiles'):
-                    blockers.extend(castle.occupied_tiles)
+        units = UnitTable.of(game_state) if unit else None
+        blockers = self.build_blocked_mask(game_state, units, unit)
         
         # 4. Call C Extension
         try:
@@ -113,49 +160,14 @@ class CPathFinder(PathFinder):
         grid, type_to_id, terrain_types = self._get_or_build_terrain_cache(game_state)
         
         # 2. Build Cost Map for this Unit
-        cost_map = {}
-        for t in terrain_types:
-            temp_terrain = Terrain(t)
-            cost = temp_terrain.get_movement_cost_for_unit(unit)
-            cost_map[type_to_id[t]] = float(cost)
+        cost_map = self.build_cost_map(unit, type_to_id, terrain_types)
             
         # 3. Blockers
-        blockers = []
-        if unit:
-            for knight in game_state.knights:
-                if knight.player_id != unit.player_id:
-                     blockers.append((knight.x, knight.y))
-        
-        # Add castles to blockers
-        if hasattr(game_state, 'castles'):
-            for castle in game_state.castles:
-                if hasattr(castle, 'occupied_tiles'):
-                    blockers.extend(castle.occupied_tiles)
+        units = UnitTable.of(game_state) if unit else None
+        blockers = self.build_blocked_mask(game_state, units, unit)
                     
         # 4. Build ZOC Map (if unit provided)
-        zoc_map = None
-        if unit:
-            zoc_map = []
-            from game.systems.engagement import EngagementSystem
-            
-            # Optimization: Pre-calculate ZOC sources
-            zoc_sources = []
-            for enemy in game_state.knights:
-                if enemy.player_id != unit.player_id and enemy.has_zone_of_control():
-                    zoc_sources.append(enemy)
-            
-            # Only build map if there are enemies with ZOC
-            if zoc_sources:
-                for y in range(height):
-                    for x in range(width):
-                        in_zoc = False
-                        for enemy in zoc_sources:
-                            dx = abs(x - enemy.x)
-                            dy = abs(y - enemy.y)
-                            if dx <= 1 and dy <= 1 and (dx + dy > 0):
-                                in_zoc = True
-                                break
-                        zoc_map.append(1 if in_zoc else 0)
+        zoc_map = self.build_zoc_mask(width, height, units, unit) if unit else None
         
         # 5. Call C Extension
         try:
@@ -0,0 +1,290 @@
+"""Campaign turns for every AI country, planned in parallel against a snapshot."""
+import os
+import time
+from dataclasses import dataclass, field
+from types import MappingProxyType
+from typing import TYPE_CHECKING, Dict, List, Mapping, Optional, Sequence, Tuple
+
+from game.hex_utils import HexCoord
+from .campaign_routing import CampaignRouter
+from .end_turn_steps.processor import shared_pool
+
+if TYPE_CHECKING:
+    from .campaign_state import CampaignState
+
+# Unit prices charged by CampaignState.recruit_units
+UNIT_COSTS = {'knights': 100, 'archers': 80, 'cavalry': 150}
+
+
+def recruitment_cost(knights: int = 0, archers: int = 0, cavalry: int = 0) -> int:
+    return (knights * UNIT_COSTS['knights'] + archers * UNIT_COSTS['archers']
+            + cavalry * UNIT_COSTS['cavalry'])
+
+
+@dataclass(frozen=True)
+class ArmySnapshot:
+    id: str
+    country: str
+    position: HexCoord
+    knights: int
+    archers: int
+    cavalry: int
+    movement_points: int
+
+    @property
+    def strength(self) -> int:
+        return self.knights + self.archers + self.cavalry
+
+
+@dataclass(frozen=True)
+class CitySnapshot:
+    key: str
+    name: str
+    country: str
+    position: HexCoord
+    income: int
+
+
+class CampaignSnapshot:
+    """Read-only copy of the campaign state AI planning looks at.
+
+    Armies, cities and treasuries are copied when captured, so planners on
+    worker threads never touch live state. Terrain is shared as it does not
+    change during a turn. Quacks like a CampaignState for CampaignRouter.
+    """
+
+    def __init__(self, armies: Dict[str, ArmySnapshot], cities: Dict[str, CitySnapshot],
+                 treasury: Dict[str, int], countries: Sequence[str], terrain_map,
+                 map_width: int, map_height: int):
+        self.armies: Mapping[str, ArmySnapshot] = MappingProxyType(armies)
+        self.cities: Mapping[str, CitySnapshot] = MappingProxyType(cities)
+        self.country_treasury: Mapping[str, int] = MappingProxyType(treasury)
+        self.countries: Tuple[str, ...] = tuple(countries)
+        self.terrain_map = terrain_map
+        self.map_width = map_width
+        self.map_height = map_height
+        armies_by_country: Dict[str, List[ArmySnapshot]] = {}
+        for army in armies.values():
+            armies_by_country.setdefault(army.country, []).append(army)
+        cities_by_country: Dict[str, List[CitySnapshot]] = {}
+        for city in cities.values():
+            cities_by_country.setdefault(city.country, []).append(city)
+        self._armies_by_country = {country: tuple(owned) for country, owned in armies_by_country.items()}
+        self._cities_by_country = {country: tuple(owned) for country, owned in cities_by_country.items()}
+
+    @classmethod
+    def capture(cls, campaign: 'CampaignState') -> 'CampaignSnapshot':
+        """Copy a campaign; call on the thread that owns it"""
+        armies = {army_id: ArmySnapshot(army.id, army.country, HexCoord(army.position.q, army.position.r),
+                                        army.knights, army.archers, army.cavalry, army.movement_points)
+                  for army_id, army in campaign.armies.items()}
+        cities = {key: CitySnapshot(key, city.name, city.country,
+                                    HexCoord(city.position.q, city.position.r), city.income)
+                  for key, city in campaign.cities.items()}
+        return cls(armies, cities, dict(campaign.country_treasury), list(campaign.countries),
+                   campaign.terrain_map, campaign.map_width, campaign.map_height)
+
+    def get_country_armies(self, country: str) -> Tuple[ArmySnapshot, ...]:
+        return self._armies_by_country.get(country, ())
+
+    def get_country_cities(self, country: str) -> Tuple[CitySnapshot, ...]:
+        return self._cities_by_country.get(country, ())
+
+
+@dataclass(frozen=True)
+class ArmyOrder:
+    army_id: str
+    country: str
+    start: HexCoord
+    target: HexCoord
+    cost: float
+    strength: int
+
+
+@dataclass(frozen=True)
+class RecruitOrder:
+    country: str
+    city_key: str
+    knights: int = 0
+    archers: int = 0
+    cavalry: int = 0
+
+    @property
+    def cost(self) -> int:
+        return recruitment_cost(self.knights, self.archers, self.cavalry)
+
+
+@dataclass
+class CountryPlan:
+    country: str
+    moves: List[ArmyOrder] = field(default_factory=list)
+    recruits: List[RecruitOrder] = field(default_factory=list)
+    planning_seconds: float = 0.0
+
+
+@dataclass
+class AITurnReport:
+    """What an AI turn planned, what the commit phase applied and how long it took"""
+    plans: Dict[str, CountryPlan] = field(default_factory=dict)
+    applied_moves: List[ArmyOrder] = field(default_factory=list)
+    rejected_moves: List[Tuple[ArmyOrder, str]] = field(default_factory=list)
+    applied_recruits: List[RecruitOrder] = field(default_factory=list)
+    rejected_recruits: List[Tuple[RecruitOrder, str]] = field(default_factory=list)
+    planning_wall_seconds: float = 0.0
+    commit_seconds: float = 0.0
+
+    @property
+    def planning_seconds(self) -> Dict[str, float]:
+        """Planning latency of each country"""
+        return {country: plan.planning_seconds for country, plan in self.plans.items()}
+
+
+def offset_distance(a: HexCoord, b: HexCoord) -> int:
+    """Hex distance between two odd-r offset coordinates of the campaign map"""
+    ax, az = a.q - (a.r - (a.r & 1)) // 2, a.r
+    bx, bz = b.q - (b.r - (b.r & 1)) // 2, b.r
+    dx, dz = ax - bx, az - bz
+    return max(abs(dx), abs(dz), abs(dx + dz))
+
+
+class CampaignAIPlanner:
+    """Decides one country's orders from a CampaignSnapshot.
+
+    Keeps no state between calls, so one planner serves every country at
+    once. Armies of at least min_attack_strength march on the nearest enemy
+    city; weaker ones hold. Gold above reserve_gold buys one levy per city,
+    richest cities first.
+    """
+
+    def __init__(self, reserve_gold: int = 200, min_attack_strength: int = 8,
+                 levy: Optional[Dict[str, int]] = None, use_native: Optional[bool] = None):
+        self.reserve_gold = reserve_gold
+        self.min_attack_strength = min_attack_strength
+        self.levy = dict(levy) if levy is not None else {'knights': 1, 'archers': 2}
+        self.use_native = use_native
+
+    def plan(self, snapshot: CampaignSnapshot, country: str) -> CountryPlan:
+        started = time.perf_counter()
+        plan = CountryPlan(country, self._plan_moves(snapshot, country),
+                           self._plan_recruits(snapshot, country))
+        plan.planning_seconds = time.perf_counter() - started
+        return plan
+
+    def _plan_moves(self, snapshot: CampaignSnapshot, country: str) -> List[ArmyOrder]:
+        enemy_cities = sorted((city for city in snapshot.cities.values() if city.country != country),
+                              key=lambda city: city.key)
+        marching = [army for army in snapshot.get_country_armies(country)
+                    if army.movement_points > 0 and army.strength >= self.min_attack_strength]
+        if not enemy_cities or not marching:
+            return []
+
+        routes = CampaignRouter(snapshot).plan_armies(marching, use_native=self.use_native)
+        orders = []
+        claimed = set()
+        for army in sorted(marching, key=lambda army: army.id):
+            objective = min(enemy_cities, key=lambda city: offset_distance(army.position, city.position)).position
+            best = None
+            for hex_coord, cost in routes[army.id].reachable(army.movement_points).items():
+                if hex_coord in claimed:
+                    continue
+                score = (offset_distance(hex_coord, objective), cost, hex_coord.r, hex_coord.q)
+                if best is None or score < best[0]:
+                    best = (score, hex_coord, cost)
+            if best is None or best[0][0] >= offset_distance(army.position, objective):
+                continue
+            claimed.add(best[1])
+            orders.append(ArmyOrder(army.id, country, army.position, best[1], best[2], army.strength))
+        return orders
+
+    def _plan_recruits(self, snapshot: CampaignSnapshot, country: str) -> List[RecruitOrder]:
+        levy_cost = RecruitOrder(country, '', **self.levy).cost
+        budget = snapshot.country_treasury.get(country, 0) - self.reserve_gold
+        orders = []
+        for city in sorted(snapshot.get_country_cities(country), key=lambda city: (-city.income, city.key)):
+            if levy_cost <= 0 or budget < levy_cost:
+                break
+            orders.append(RecruitOrder(country, city.key, **self.levy))
+            budget -= levy_cost
+        return orders
+
+
+class CampaignAIEngine:
+    """Plays the turn of every AI country in two phases.
+
+    Planning runs each country's CampaignAIPlanner.plan on a thread pool
+    against one CampaignSnapshot; the routing inside releases the GIL.
+    The commit phase then applies the orders to the live campaign on the
+    calling thread, in an order that depends only on the plans: contested
+    target hexes go to the strongest army (then earlier country, then army
+    id), moves apply in country order through CampaignState.move_army, and
+    recruits follow. Orders the live state no longer allows are rejected
+    with a reason rather than applied.
+    """
+
+    def __init__(self, planner: Optional[CampaignAIPlanner] = None, max_workers: Optional[int] = None):
+        if max_workers is not None and max_workers < 1:
+            raise ValueError("max_workers must be at least 1")
+        self.planner = planner or CampaignAIPlanner()
+        self.max_workers = max_workers if max_workers is not None else min(8, os.cpu_count() or 1)
+
+    @staticmethod
+    def ai_countries(campaign: 'CampaignState') -> List[str]:
+        return [country for country in campaign.countries if country != campaign.player_country]
+
+    def plan(self, snapshot: CampaignSnapshot, countries: Sequence[str]) -> Dict[str, CountryPlan]:
+        """Plans of countries, keyed in the order given"""
+        if self.max_workers == 1 or len(countries) <= 1:
+            return {country: self.planner.plan(snapshot, country) for country in countries}
+        pool = shared_pool(self.max_workers, "campaign-ai")
+        futures = [pool.submit(self.planner.plan, snapshot, country) for country in countries]
+        return {country: future.result() for country, future in zip(countries, futures)}
+
+    def commit(self, campaign: 'CampaignState', plans: Dict[str, CountryPlan],
+               report: Optional[AITurnReport] = None) -> AITurnReport:
+        """Apply plans to the live campaign; plans are taken in their key order"""
+        report = report if report is not None else AITurnReport(plans=plans)
+        started = time.perf_counter()
+        country_order = {country: rank for rank, country in enumerate(plans)}
+
+        contenders: Dict[HexCoord, List[ArmyOrder]] = {}
+        for plan in plans.values():
+            for order in plan.moves:
+                contenders.setdefault(order.target, []).append(order)
+        winners = set()
+        for orders in contenders.values():
+            ranked = sorted(orders, key=lambda order: (-order.strength, country_order[order.country], order.army_id))
+            winners.add(id(ranked[0]))
+            report.rejected_moves.extend((order, 'contested') for order in ranked[1:])
+
+        for plan in plans.values():
+            for order in plan.moves:
+                if id(order) not in winners:
+                    continue
+                army = campaign.armies.get(order.army_id)
+                if army is None or army.country != order.country or army.position != order.start:
+                    report.rejected_moves.append((order, 'stale'))
+                elif campaign.move_army(order.army_id, order.target):
+                    report.applied_moves.append(order)
+                else:
+                    report.rejected_moves.append((order, 'blocked'))
+
+        for plan in plans.values():
+            for order in plan.recruits:
+                if campaign.recruit_units(order.country, order.city_key, order.knights,
+                                          order.archers, order.cavalry):
+                    report.applied_recruits.append(order)
+                else:
+                    report.rejected_recruits.append((order, 'unaffordable or lost city'))
+
+        report.commit_seconds = time.perf_counter() - started
+        return report
+
+    def play_turn(self, campaign: 'CampaignState',
+                  countries: Optional[Sequence[str]] = None) -> AITurnReport:
+        """Plan every AI country against one snapshot, then commit the plans"""
+        countries = list(countries) if countries is not None else self.ai_countries(campaign)
+        snapshot = CampaignSnapshot.capture(campaign)
+        started = time.perf_counter()
+        plans = self.plan(snapshot, countries)
+        report = AITurnReport(plans=plans, planning_wall_seconds=time.perf_counter() - started)
+        return self.commit(campaign, plans, report)
@@ -0,0 +1,187 @@
+"""Cities and armies of a campaign, indexed by hex and by owning country."""
+import copy
+from collections.abc import MutableMapping
+from typing import Any, Dict, Iterable, Iterator, List, Optional, Tuple
+
+from game.hex_utils import HexCoord
+
+# Entity fields the index is keyed on
+INDEXED_FIELDS = ('position', 'country')
+
+
+class IndexedEntity:
+    """Mixin for campaign entities held in a CampaignIndex.
+
+    Assigning position or country re-files the entity in the index it was
+    last added to, so the index stays current however the entity is moved
+    or captured. Positions must be replaced, not mutated in place.
+    """
+
+    def __setattr__(self, name, value):
+        if name in INDEXED_FIELDS:
+            entry = self.__dict__.get('_campaign_index')
+            if entry is not None:
+                index, key = entry
+                index._refile(key, self, name, value)
+        object.__setattr__(self, name, value)
+
+    def __deepcopy__(self, memo):
+        # A copy belongs to no index until one adds it
+        clone = object.__new__(type(self))
+        memo[id(self)] = clone
+        for name, value in self.__dict__.items():
+            if name != '_campaign_index':
+                clone.__dict__[name] = copy.deepcopy(value, memo)
+        return clone
+
+
+class CampaignIndex(MutableMapping):
+    """Entities by id, like the dict it replaces, plus a per-hex and a
+    per-country index kept in step with every insert, delete and move.
+
+    at(), owned_by() and in_area() answer in time proportional to what they
+    return instead of scanning every entity.
+    """
+
+    def __init__(self, entities: Optional[Iterable] = None):
+        self._entities: Dict[str, Any] = {}
+        # hex -> ids and country -> ids, each bucket in order of arrival
+        self._by_hex: Dict[HexCoord, Dict[str, None]] = {}
+        self._by_country: Dict[str, Dict[str, None]] = {}
+        if entities is not None:
+            self.update(entities)
+
+    def _add_keys(self, key: str, position, country) -> None:
+        self._by_hex.setdefault(position, {})[key] = None
+        self._by_country.setdefault(country, {})[key] = None
+
+    def _remove_keys(self, key: str, position, country) -> None:
+        for buckets, bucket_key in ((self._by_hex, position), (self._by_country, country)):
+            bucket = buckets.get(bucket_key)
+            if bucket is not None:
+                bucket.pop(key, None)
+                if not bucket:
+                    del buckets[bucket_key]
+
+    def _refile(self, key: str, entity: Any, name: str, value) -> None:
+        if self._entities.get(key) is not entity:
+            return
+        position, country = entity.position, entity.country
+        self._remove_keys(key, position, country)
+        if name == 'position':
+            position = value
+        else:
+            country = value
+        self._add_keys(key, position, country)
+
+    def _release(self, key: str, entity: Any) -> None:
+        entry = entity.__dict__.get('_campaign_index') if isinstance(entity, IndexedEntity) else None
+        if entry is not None and entry[0] is self and entry[1] == key:
+            object.__setattr__(entity, '_campaign_index', None)
+
+    def _detach(self, key: str, entity: Any) -> None:
+        self._remove_keys(key, entity.position, entity.country)
+        self._release(key, entity)
+
+    def __getitem__(self, key: str) -> Any:
+        return self._entities[key]
+
+    def __setitem__(self, key: str, entity: Any) -> None:
+        previous = self._entities.get(key)
+        if previous is not None:
+            self._detach(key, previous)
+        self._entities[key] = entity
+        self._add_keys(key, entity.position, entity.country)
+        if isinstance(entity, IndexedEntity):
+            object.__setattr__(entity, '_campaign_index', (self, key))
+
+    def __delitem__(self, key: str) -> None:
+        entity = self._entities.pop(key)
+        self._detach(key, entity)
+
+    def __contains__(self, key) -> bool:
+        return key in self._entities
+
+    def __iter__(self) -> Iterator[str]:
+        return iter(self._entities)
+
+    def __len__(self) -> int:
+        return len(self._entities)
+
+    def __repr__(self) -> str:
+        return f"{type(self).__name__}({self._entities!r})"
+
+    def keys(self):
+        return self._entities.keys()
+
+    def values(self):
+        return self._entities.values()
+
+    def items(self):
+        return self._entities.items()
+
+    def get(self, key, default=None):
+        return self._entities.get(key, default)
+
+    def clear(self) -> None:
+        for key, entity in self._entities.items():
+            self._release(key, entity)
+        self._entities.clear()
+        self._by_hex.clear()
+        self._by_country.clear()
+
+    def __deepcopy__(self, memo) -> 'CampaignIndex':
+        clone = type(self)()
+        memo[id(self)] = clone
+        for key, entity in self._entities.items():
+            clone[key] = copy.deepcopy(entity, memo)
+        return clone
+
+    def at(self, position: HexCoord) -> List[Any]:
+        """Entities on a hex, in the order they arrived there"""
+        keys = self._by_hex.get(position)
+        return [self._entities[key] for key in keys] if keys else []
+
+    def items_at(self, position: HexCoord) -> List[Tuple[str, Any]]:
+        keys = self._by_hex.get(position)
+        return [(key, self._entities[key]) for key in keys] if keys else []
+
+    def owned_by(self, country: str) -> List[Any]:
+        """Entities of a country, in the order they joined it"""
+        keys = self._by_country.get(country)
+        return [self._entities[key] for key in keys] if keys else []
+
+    def items_owned_by(self, country: str) -> List[Tuple[str, Any]]:
+        keys = self._by_country.get(country)
+        return [(key, self._entities[key]) for key in keys] if keys else []
+
+    def occupied_hexes(self) -> Iterable[HexCoord]:
+        return self._by_hex.keys()
+
+    def countries(self) -> Iterable[str]:
+        return self._by_country.keys()
+
+    def in_area(self, min_q: int, max_q: int, min_r: int, max_r: int) -> List[Any]:
+        """Entities with min_q <= q < max_q and min_r <= r < max_r, probing
+        either every hex of the area or every occupied hex, whichever is fewer"""
+        if max_q <= min_q or max_r <= min_r:
+            return []
+        by_hex, entities = self._by_hex, self._entities
+        if (max_q - min_q) * (max_r - min_r) < len(by_hex):
+            found = []
+            for r in range(min_r, max_r):
+                for q in range(min_q, max_q):
+                    keys = by_hex.get(HexCoord(q, r))
+                    if keys:
+                        found.extend(entities[key] for key in keys)
+            return found
+        return [entities[key] for position, keys in by_hex.items()
+                if min_q <= position.q < max_q and min_r <= position.r < max_r
+                for key in keys]
+
+
+def items_owned_by(entities, country: str) -> List[Tuple[str, Any]]:
+    """(id, entity) pairs of a country from a CampaignIndex, or by scanning a plain mapping"""
+    if isinstance(entities, CampaignIndex):
+        return entities.items_owned_by(country)
+    return [(key, entity) for key, entity in entities.items() if entity.country == country]
@@ -0,0 +1,200 @@
+"""Binary campaign map format (.cmap): a fixed header, then lazily read sections.
+
+Layout, little-endian:
+
+    header   magic, version, dimensions, hex size, geographic bounds, city and
+             country counts, (offset, size) of each section, CRC-32 of the
+             bytes after the header
+    terrain  width * height bytes of CAMPAIGN_TERRAIN_CODES, row-major
+    cities   one CITY_RECORD per city: x, y, income, castle level, population
+    meta     UTF-8 JSON: countries, neutral regions and the text fields of
+             each city, in city record order
+
+Listing maps reads only the header. Loading memory-maps the file; the
+terrain section is copied straight into a CampaignTerrainMap and the other
+sections are decoded on first use.
+"""
+import json
+import math
+import mmap
+import os
+import struct
+import zlib
+from typing import Dict, Iterator, List, NamedTuple, Optional, Tuple
+
+from .campaign_terrain import CampaignTerrainMap, CampaignTerrainType
+
+MAGIC = b'CMAP'
+# Terrain codes are CAMPAIGN_TERRAIN_CODES: reordering CampaignTerrainType needs a version bump
+FORMAT_VERSION = 1
+EXTENSION = '.cmap'
+
+HEADER = struct.Struct('<4sHHIId4dIIIIIIIII')
+CITY_RECORD = struct.Struct('<iiiii')
+
+
+class CampaignMapHeader(NamedTuple):
+    width: int
+    height: int
+    hex_size_km: float
+    # (west, east, south, north) degrees, None when the source map had none
+    bounds: Optional[Tuple[float, float, float, float]]
+    city_count: int
+    country_count: int
+    terrain: Tuple[int, int]
+    cities: Tuple[int, int]
+    meta: Tuple[int, int]
+    checksum: int
+
+
+def _unpack_header(data: bytes, path: str) -> CampaignMapHeader:
+    if len(data) < HEADER.size:
+        raise ValueError(f"{path} is too short to be a campaign map")
+    (magic, version, header_size, width, height, hex_size_km, west, east, south, north,
+     city_count, country_count, terrain_offset, terrain_size, cities_offset, cities_size,
+     meta_offset, meta_size, checksum) = HEADER.unpack_from(data)
+    if magic != MAGIC:
+        raise ValueError(f"{path} is not a campaign map file")
+    if version != FORMAT_VERSION or header_size != HEADER.size:
+        raise ValueError(f"{path} has unsupported campaign map version {version}")
+    bounds = None if math.isnan(west) else (west, east, south, north)
+    return CampaignMapHeader(width, height, hex_size_km, bounds, city_count, country_count,
+                             (terrain_offset, terrain_size), (cities_offset, cities_size),
+                             (meta_offset, meta_size), checksum)
+
+
+def read_header(path: str) -> CampaignMapHeader:
+    """The header of a .cmap file, reading nothing else"""
+    with open(path, 'rb') as f:
+        return _unpack_header(f.read(HEADER.size), path)
+
+
+class CampaignMapFile:
+    """A memory-mapped .cmap file; use as a context manager or call close()"""
+
+    def __init__(self, path: str, verify: bool = True):
+        self.path = path
+        with open(path, 'rb') as f:
+            self._mmap = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        try:
+            self.header = _unpack_header(self._mmap[:HEADER.size], path)
+            for offset, size in (self.header.terrain, self.header.cities, self.header.meta):
+                if offset < HEADER.size or offset + size > len(self._mmap):
+                    raise ValueError(f"{path} is truncated")
+            if self.header.terrain[1] != self.header.width * self.header.height:
+                raise ValueError(f"{path} terrain section does not match the map size")
+            if self.header.cities[1] != self.header.city_count * CITY_RECORD.size:
+                raise ValueError(f"{path} city table does not match the city count")
+            if verify:
+                with memoryview(self._mmap) as view:
+                    checksum = zlib.crc32(view[HEADER.size:])
+                if checksum != self.header.checksum:
+                    raise ValueError(f"{path} failed its checksum")
+        except Exception:
+            self._mmap.close()
+            raise
+        self._meta: Optional[Dict] = None
+
+    def __enter__(self) -> 'CampaignMapFile':
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+    def close(self) -> None:
+        self._mmap.close()
+
+    def _section(self, section: Tuple[int, int]) -> bytes:
+        offset, size = section
+        return self._mmap[offset:offset + size]
+
+    def terrain_map(self) -> CampaignTerrainMap:
+        terrain_map = CampaignTerrainMap(self.header.width, self.header.height)
+        terrain_map.restore(self._section(self.header.terrain))
+        return terrain_map
+
+    @property
+    def meta(self) -> Dict:
+        if self._meta is None:
+            meta = json.loads(self._section(self.header.meta).decode('utf-8'))
+            if len(meta.get('cities', ())) != self.header.city_count:
+                raise ValueError(f"{self.path} city text does not match the city count")
+            self._meta = meta
+        return self._meta
+
+    def cities(self) -> Iterator[Tuple[str, Dict]]:
+        """(city id, city dict in the JSON map layout) per city, in file order"""
+        texts = self.meta['cities']
+        records = CITY_RECORD.iter_unpack(self._section(self.header.cities))
+        for (x, y, income, castle_level, population), text in zip(records, texts):
+            city_id, name, country, city_type, specialization, description = text
+            yield city_id, {
+                'name': name,
+                'country': country,
+                'position': [x, y],
+                'type': city_type,
+                'income': income,
+                'castle_level': castle_level,
+                'population': population,
+                'specialization': specialization,
+                'description': description,
+            }
+
+
+def write_campaign_map(path: str, data: Dict,
+                       bounds: Optional[Tuple[float, float, float, float]] = None) -> None:
+    """Write campaign data in the JSON map layout ('map', 'countries', 'cities',
+    'neutral_regions') as a .cmap file"""
+    map_info = data['map']
+    width, height = map_info['width'], map_info['height']
+    terrain_map = CampaignTerrainMap(width, height)
+    for terrain_name, regions in map_info['terrain'].items():
+        terrain_map.fill_rects(CampaignTerrainType(terrain_name), regions)
+
+    city_records = []
+    city_texts = []
+    for city_id, city in data['cities'].items():
+        x, y = city['position']
+        city_records.append(CITY_RECORD.pack(x, y, city['income'], city['castle_level'], city['population']))
+        city_texts.append([city_id, city['name'], city['country'], city['type'],
+                           city['specialization'], city['description']])
+    meta = json.dumps({
+        'countries': data['countries'],
+        'neutral_regions': data['neutral_regions'],
+        'cities': city_texts,
+    }, ensure_ascii=False, separators=(',', ':')).encode('utf-8')
+
+    sections = [bytes(terrain_map.cells), b''.join(city_records), meta]
+    layout: List[Tuple[int, int]] = []
+    offset = HEADER.size
+    for section in sections:
+        layout.append((offset, len(section)))
+        offset += len(section)
+    payload = b''.join(sections)
+
+    west, east, south, north = bounds if bounds is not None else (math.nan,) * 4
+    header = HEADER.pack(
+        MAGIC, FORMAT_VERSION, HEADER.size, width, height, float(map_info['hex_size_km']),
+        west, east, south, north, len(city_records), len(data['countries']),
+        *layout[0], *layout[1], *layout[2], zlib.crc32(payload))
+
+    os.makedirs(os.path.dirname(path) or '.', exist_ok=True)
+    with open(path, 'wb') as f:
+        f.write(header)
+        f.write(payload)
+
+
+def is_campaign_map_file(path: str) -> bool:
+    return path.endswith(EXTENSION)
+
+
+if __name__ == '__main__':
+    import sys
+
+    if len(sys.argv) not in (3, 4):
+        print("Usage: python -m game.campaign.campaign_map_file <map.json> <map.cmap> [west,east,south,north]")
+        sys.exit(1)
+    with open(sys.argv[1], 'r', encoding='utf-8') as f:
+        source = json.load(f)
+    map_bounds = tuple(float(v) for v in sys.argv[3].split(',')) if len(sys.argv) == 4 else None
+    write_campaign_map(sys.argv[2], source, map_bounds)
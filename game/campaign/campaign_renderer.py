@@ -2,6 +2,7 @@ import pygame
 import math
 from typing import Dict, Optional, Tuple
 from game.campaign.campaign_state import CampaignState, Army, Country, City
+from game.campaign.campaign_terrain import CAMPAIGN_TERRAIN_BY_CODE
 from game.hex_utils import HexCoord, HexGrid
 from game.hex_layout import HexLayout
 from game.terrain import TerrainType
@@ -210,12 +211,12 @@ class CampaignRenderer:
         # Draw hex grid overlay
         self._draw_hex_grid(campaign_state)
         
-        # Draw cities
-        for city in campaign_state.cities.values():
+        # Draw cities and armies on visible hexes only
+        visible_range = self._get_visible_hex_range_cached(campaign_state)
+        for city in campaign_state.cities.in_area(*visible_range):
             self._draw_city_hex(city, campaign_state.hex_layout, campaign_state.countries)
             
-        # Draw armies
-        for army in campaign_state.armies.values():
+        for army in campaign_state.armies.in_area(*visible_range):
             self._draw_army_hex(army, campaign_state.hex_layout, campaign_state.countries)
             
         # Draw UI overlay
@@ -261,11 +262,16 @@ class CampaignRenderer:
         hex_layout = campaign_state.hex_layout
         min_q, max_q, min_r, max_r = self._get_visible_hex_range_cached(campaign_state)
         
+        cells = campaign_state.terrain_map.cells
+        width = campaign_state.terrain_map.width
+        min_q, max_q = max(min_q, 0), min(max_q, width)
+        min_r, max_r = max(min_r, 0), min(max_r, campaign_state.terrain_map.height)
+        
         # Draw terrain for visible hexes only
         for q in range(min_q, max_q):
             for r in range(min_r, max_r):
                 # Get terrain type for this hex
-                terrain_type = campaign_state.terrain_map.get((q, r), None)
+                terrain_type = CAMPAIGN_TERRAIN_BY_CODE[cells[r * width + q]]
                 if terrain_type:
                     pixel_x, pixel_y = self._get_cached_pixel_position(q, r, hex_layout)
                     pixel_x += self.camera_x
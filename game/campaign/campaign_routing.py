@@ -0,0 +1,271 @@
+"""Army movement on the campaign map: terrain costs, enemy blockers and batched routes."""
+import heapq
+import math
+from array import array
+from typing import TYPE_CHECKING, Dict, Iterable, List, Optional, Sequence, Tuple
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.config import USE_C_EXTENSIONS
+from game.hex_utils import HexCoord
+from .campaign_index import CampaignIndex
+from .campaign_terrain import CAMPAIGN_TERRAIN_TYPES, CampaignTerrainMap, CampaignTerrainType
+
+if TYPE_CHECKING:
+    from .campaign_state import Army, CampaignState
+
+if C_EXTENSION_AVAILABLE:
+    import c_algorithms
+
+
+# Movement points an army spends to enter a hex of each terrain
+CAMPAIGN_MOVEMENT_COSTS: Dict[CampaignTerrainType, float] = {
+    CampaignTerrainType.PLAINS: 1,
+    CampaignTerrainType.DESERT: 1,
+    CampaignTerrainType.FOREST: 2,
+    CampaignTerrainType.HILLS: 2,
+    CampaignTerrainType.MOUNTAINS: 2,
+    CampaignTerrainType.SNOW: 2,
+    CampaignTerrainType.DEEP_FOREST: 3,
+    CampaignTerrainType.SWAMP: 3,
+    CampaignTerrainType.WATER: math.inf,
+    CampaignTerrainType.DEEP_WATER: math.inf,
+    CampaignTerrainType.HIGH_MOUNTAINS: math.inf,
+    CampaignTerrainType.GLACIAL: math.inf,
+}
+
+# The same table indexed by CampaignTerrainMap cell code; hexes without terrain cost 1
+CAMPAIGN_MOVEMENT_COSTS_BY_CODE: Tuple[float, ...] = (1.0,) + tuple(
+    float(CAMPAIGN_MOVEMENT_COSTS[terrain_type]) for terrain_type in CAMPAIGN_TERRAIN_TYPES)
+
+# Odd-r offset neighbours, matching HexLayout and the native engine
+_EVEN_ROW_DIRS = ((-1, -1), (0, -1), (1, 0), (0, 1), (-1, 1), (-1, 0))
+_ODD_ROW_DIRS = ((0, -1), (1, -1), (1, 0), (1, 1), (0, 1), (-1, 0))
+
+
+class ArmyRoutes:
+    """Cheapest routes from one army's hex to every hex it can reach this plan.
+
+    Holds a movement cost and a parent index per hex of the map; unreached
+    hexes cost infinity. Paths are walked back through the parents on demand.
+    """
+
+    def __init__(self, army_id: str, start: HexCoord, width: int, height: int,
+                 costs: Sequence[float], parents: Sequence[int]):
+        self.army_id = army_id
+        self.start = start
+        self.width = width
+        self.height = height
+        self._costs = costs
+        self._parents = parents
+
+    def _index(self, target: HexCoord) -> int:
+        if 0 <= target.q < self.width and 0 <= target.r < self.height:
+            return target.r * self.width + target.q
+        return -1
+
+    def cost_to(self, target: HexCoord) -> float:
+        """Movement points needed to reach target, infinity when it is out of reach"""
+        index = self._index(target)
+        return self._costs[index] if index >= 0 else math.inf
+
+    def can_reach(self, target: HexCoord) -> bool:
+        return not math.isinf(self.cost_to(target))
+
+    def path_to(self, target: HexCoord) -> Optional[List[HexCoord]]:
+        """Hexes walked to reach target, excluding the start; None when out of reach"""
+        if not self.can_reach(target):
+            return None
+        width = self.width
+        path = []
+        index = self._index(target)
+        while self._parents[index] >= 0:
+            path.append(HexCoord(index % width, index // width))
+            index = self._parents[index]
+        path.reverse()
+        return path
+
+    def reachable(self, radius: Optional[int] = None) -> Dict[HexCoord, float]:
+        """Every hex in reach other than the start, with its cost.
+
+        Every step costs at least 1, so a route plan with budget b can only
+        reach hexes within b rows and columns of the start; passing
+        radius=b scans that window instead of the whole map.
+        """
+        width = self.width
+        start_index = self._index(self.start)
+        costs = self._costs
+        if radius is None:
+            return {HexCoord(index % width, index // width): cost
+                    for index, cost in enumerate(costs)
+                    if cost != math.inf and index != start_index}
+        radius = max(0, int(radius))
+        min_x, max_x = max(0, self.start.q - radius), min(width, self.start.q + radius + 1)
+        reached = {}
+        for y in range(max(0, self.start.r - radius), min(self.height, self.start.r + radius + 1)):
+            row = y * width
+            for x in range(min_x, max_x):
+                cost = costs[row + x]
+                if cost != math.inf and row + x != start_index:
+                    reached[HexCoord(x, y)] = cost
+        return reached
+
+
+class CampaignRouter:
+    """Plans army movement over a campaign's terrain.
+
+    Enemy armies and cities, and the hexes next to enemy armies (their zone
+    of control), end movement: an army may enter them but not move on. Each
+    plan runs one bounded Dijkstra per army, all of a country's armies in a
+    single native call.
+    """
+
+    def __init__(self, campaign: 'CampaignState'):
+        self.campaign = campaign
+        self._blank_terrain: Optional[CampaignTerrainMap] = None
+
+    def terrain(self) -> CampaignTerrainMap:
+        """The campaign terrain, or a blank grid of the map size when none was loaded"""
+        terrain_map = self.campaign.terrain_map
+        if terrain_map.width and terrain_map.height:
+            return terrain_map
+        size = (self.campaign.map_width, self.campaign.map_height)
+        if self._blank_terrain is None or (self._blank_terrain.width, self._blank_terrain.height) != size:
+            self._blank_terrain = CampaignTerrainMap(*size)
+        return self._blank_terrain
+
+    def stop_mask(self, country: str, width: int, height: int,
+                  area: Optional[Tuple[int, int, int, int]] = None) -> bytearray:
+        """Hexes where movement of country's armies ends: enemy positions and enemy zones of control.
+
+        area (min_q, max_q, min_r, max_r) limits the enemies looked at to
+        those inside it, found through the campaign's hex index.
+        """
+        stop = bytearray(width * height)
+
+        def mark(x: int, y: int) -> None:
+            if 0 <= x < width and 0 <= y < height:
+                stop[y * width + x] = 1
+
+        for city in _entities_in(self.campaign.cities, area):
+            if city.country != country:
+                mark(city.position.q, city.position.r)
+        for army in _entities_in(self.campaign.armies, area):
+            if army.country == country:
+                continue
+            x, y = army.position.q, army.position.r
+            mark(x, y)
+            for dx, dy in (_EVEN_ROW_DIRS if y % 2 == 0 else _ODD_ROW_DIRS):
+                mark(x + dx, y + dy)
+        return stop
+
+    def plan_country(self, country: str, budget: Optional[float] = None,
+                     use_native: Optional[bool] = None) -> Dict[str, ArmyRoutes]:
+        """Routes for every army of country, by army id.
+
+        budget caps the route cost; by default each army's remaining movement points.
+        """
+        return self.plan_armies(self.campaign.get_country_armies(country), budget, use_native)
+
+    def plan_army(self, army: 'Army', budget: Optional[float] = None,
+                  use_native: Optional[bool] = None) -> ArmyRoutes:
+        return self.plan_armies([army], budget, use_native)[army.id]
+
+    def plan_armies(self, armies: Iterable['Army'], budget: Optional[float] = None,
+                    use_native: Optional[bool] = None) -> Dict[str, ArmyRoutes]:
+        """Routes for armies of one country"""
+        armies = list(armies)
+        if not armies:
+            return {}
+        countries = {army.country for army in armies}
+        if len(countries) != 1:
+            raise ValueError(f"armies planned together must share a country, got {sorted(countries)}")
+        if use_native is None:
+            use_native = USE_C_EXTENSIONS and C_EXTENSION_AVAILABLE
+        if use_native and not C_EXTENSION_AVAILABLE:
+            raise ValueError("Native campaign routing requested but the C extension is not available")
+
+        terrain_map = self.terrain()
+        width, height = terrain_map.width, terrain_map.height
+        starts = [(army.position.q, army.position.r,
+                   float(army.movement_points if budget is None else budget)) for army in armies]
+        # Every step costs at least 1 and moves at most one row and column, so
+        # only enemies one hex past the longest reach can stop a route
+        reach = max(start[2] for start in starts)
+        area = None
+        if not math.isinf(reach):
+            margin = max(0, math.floor(reach)) + 1
+            area = (min(x for x, _, _ in starts) - margin, max(x for x, _, _ in starts) + margin + 1,
+                    min(y for _, y, _ in starts) - margin, max(y for _, y, _ in starts) + margin + 1)
+        stop = self.stop_mask(countries.pop(), width, height, area)
+
+        if use_native:
+            planes = []
+            for cost_bytes, parent_bytes in c_algorithms.campaign_routes(
+                    width, height, terrain_map.cells, CAMPAIGN_MOVEMENT_COSTS_BY_CODE, stop, starts):
+                costs, parents = array('d'), array('i')
+                costs.frombytes(cost_bytes)
+                parents.frombytes(parent_bytes)
+                planes.append((costs, parents))
+        else:
+            planes = campaign_routes_python(width, height, terrain_map.cells,
+                                            CAMPAIGN_MOVEMENT_COSTS_BY_CODE, stop, starts)
+
+        return {army.id: ArmyRoutes(army.id, army.position, width, height, costs, parents)
+                for army, (costs, parents) in zip(armies, planes)}
+
+
+def _entities_in(entities, area: Optional[Tuple[int, int, int, int]]):
+    if area is not None and isinstance(entities, CampaignIndex):
+        return entities.in_area(*area)
+    return entities.values()
+
+
+def campaign_routes_python(width: int, height: int, cells: bytes, move_costs: Sequence[float],
+                           stop: Optional[bytes], starts: Sequence[Tuple[int, int, float]]):
+    """Pure Python twin of c_algorithms.campaign_routes, returning (costs, parents) arrays"""
+    if width <= 0 or height <= 0:
+        raise ValueError("campaign map dimensions must be positive")
+    map_size = width * height
+    if len(cells) != map_size:
+        raise ValueError(f"cells must have {map_size} bytes, got {len(cells)}")
+    if stop is not None and len(stop) != map_size:
+        raise ValueError(f"stop mask must have {map_size} bytes, got {len(stop)}")
+    if len(move_costs) > 256:
+        raise ValueError("move_costs can hold at most 256 terrain codes")
+    code_costs = [max(float(cost), 1.0) for cost in move_costs] + [math.inf] * (256 - len(move_costs))
+
+    planes = []
+    for x, y, budget in starts:
+        if not (0 <= x < width and 0 <= y < height):
+            raise ValueError(f"army at ({x}, {y}) is off the {width}x{height} map")
+        start_index = y * width + x
+        costs = array('d', [math.inf]) * map_size
+        parents = array('i', [-1]) * map_size
+        closed = bytearray(map_size)
+        costs[start_index] = 0.0
+        queue = [(0.0, x, y)]
+        while queue:
+            cost, cx, cy = heapq.heappop(queue)
+            c_idx = cy * width + cx
+            if cost > costs[c_idx] or closed[c_idx]:
+                continue
+            closed[c_idx] = 1
+            if stop is not None and stop[c_idx] and c_idx != start_index:
+                continue
+
+            for dx, dy in (_EVEN_ROW_DIRS if cy % 2 == 0 else _ODD_ROW_DIRS):
+                nx, ny = cx + dx, cy + dy
+                if not (0 <= nx < width and 0 <= ny < height):
+                    continue
+                n_idx = ny * width + nx
+                if closed[n_idx]:
+                    continue
+                new_cost = cost + code_costs[cells[n_idx]]
+                if new_cost > budget:
+                    continue
+                if new_cost < costs[n_idx]:
+                    costs[n_idx] = new_cost
+                    parents[n_idx] = c_idx
+                    heapq.heappush(queue, (new_cost, nx, ny))
+        planes.append((costs, parents))
+    return planes
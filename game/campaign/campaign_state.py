@@ -1,9 +1,10 @@
 import pygame
 import json
+import math
+import random
 import os
 from typing import Dict, List, Optional
 from dataclasses import dataclass
-from enum import Enum
 from game.hex_utils import HexCoord, HexGrid
 from game.hex_layout import HexLayout
 from .end_turn_steps import EndTurnProcessor
@@ -12,40 +13,21 @@ from .end_turn_steps.movement_step import MovementResetStep
 from .end_turn_steps.population_step import PopulationCalculationStep
 from .city_specialization import CitySpecialization
 # Campaign module has its own terrain system
-
-
-class CampaignTerrainType(Enum):
-    """Campaign-specific terrain types with elevation-based classification"""
-    # Plains and lowlands (0-200m elevation)
-    PLAINS = "plains"
-    
-    # Forest types
-    FOREST = "forest"           # Regular forest
-    DEEP_FOREST = "deep_forest" # Dense/deep forest
-    
-    # Elevation-based terrain
-    HILLS = "hills"                   # 200-600m elevation
-    MOUNTAINS = "mountains"           # 600-2500m elevation  
-    HIGH_MOUNTAINS = "high_mountains" # 2500m+ elevation
-    
-    # Water bodies
-    WATER = "water"
-    DEEP_WATER = "deep_water"
-    
-    # Wetlands
-    SWAMP = "swamps"  # Note: using plural to match existing JSON structure
-    
-    # Arid regions
-    DESERT = "desert"
-    
-    # Cold regions
-    SNOW = "snow"
-    GLACIAL = "glacial"
+from .campaign_terrain import CampaignTerrainMap, CampaignTerrainType
+from .campaign_map_file import CampaignMapFile, is_campaign_map_file
+from .campaign_routing import CampaignRouter
+from .campaign_ai import AITurnReport, CampaignAIEngine, recruitment_cost
+from .campaign_index import CampaignIndex, IndexedEntity
+from .city_table import CityIndex, CityRow, city_column
 
 
 @dataclass
-class City:
-    """Represents a city on the campaign map"""
+class City(IndexedEntity):
+    """Represents a city on the campaign map.
+    
+    country, income, population and specialization live in a CityTable row;
+    the campaign's CityIndex adopts the row when the city is added.
+    """
     name: str
     country: str
     position: HexCoord
@@ -56,6 +38,17 @@ class City:
     specialization: str  # military, trade, religious, etc.
     description: str
     
+    def __new__(cls, *args, **kwargs):
+        city = super().__new__(cls)
+        object.__setattr__(city, '_row', CityRow.detached())
+        return city
+
+
+City.country = city_column('country', "Id of the owning country")
+City.income = city_column('income', "Gold collected each turn")
+City.population = city_column('population', "Inhabitants")
+City.specialization = city_column('specialization', "CitySpecialization value")
+    
     
 @dataclass
 class Country:
@@ -70,7 +63,7 @@ class Country:
     
     
 @dataclass
-class Army:
+class Army(IndexedEntity):
     """Represents an army on the campaign map"""
     id: str
     country: str
@@ -90,17 +83,21 @@ class CampaignState:
         self.current_country = player_country
         self.turn_number = 1
         self.map_file = map_file
+        # Keys the per-turn random streams of whole-table city steps
+        self.random_seed = random.getrandbits(64)
         
         # Data containers
         self.countries: Dict[str, Country] = {}
-        self.cities: Dict[str, City] = {}
-        self.armies: Dict[str, Army] = {}
+        self.cities: CityIndex = CityIndex()
+        self.armies: CampaignIndex = CampaignIndex()
         self.country_treasury: Dict[str, int] = {}
         self.neutral_regions: List[Dict] = []
         
         # Map data
         self.map_data: Dict = {}
-        self.terrain_map: Dict[tuple, CampaignTerrainType] = {}
+        self.terrain_map = CampaignTerrainMap(0, 0)
+        self.router = CampaignRouter(self)
+        self.ai_engine = CampaignAIEngine()
         
         # End-turn processing
         self.per_country_processor = EndTurnProcessor()  # Runs every country turn
@@ -127,6 +124,24 @@ class CampaignState:
             # Default initialization for testing
             self._init_default_campaign()
     
+    @property
+    def cities(self) -> CityIndex:
+        """Cities by id, also indexed by hex and by owner, with columns in cities.table"""
+        return self._cities
+
+    @cities.setter
+    def cities(self, cities) -> None:
+        self._cities = cities if isinstance(cities, CityIndex) else CityIndex(cities)
+
+    @property
+    def armies(self) -> CampaignIndex:
+        """Armies by id, also indexed by hex and by owner"""
+        return self._armies
+
+    @armies.setter
+    def armies(self, armies) -> None:
+        self._armies = armies if isinstance(armies, CampaignIndex) else CampaignIndex(armies)
+
     def _setup_end_turn_steps(self):
         """Register all end-turn processing steps."""
         # Per-country steps (run every country turn)
@@ -146,6 +161,10 @@ class CampaignState:
         if not os.path.exists(data_path):
             raise FileNotFoundError(f"Campaign map file not found: {data_path}")
 
+        if is_campaign_map_file(data_path):
+            self._load_binary_campaign_data(data_path)
+            return
+
         with open(data_path, 'r', encoding='utf-8') as f:
             data = json.load(f)
 
@@ -168,8 +187,35 @@ class CampaignState:
         # Load terrain
         self._load_terrain_from_data(self.map_data['terrain'])
 
-        # Load countries
-        for country_id, country_info in data['countries'].items():
+        self._load_countries(data['countries'])
+        self._load_cities(data['cities'].items())
+
+        # Load neutral regions
+        self.neutral_regions = data['neutral_regions']
+
+        if not self.cities:
+            raise ValueError("Campaign data must contain at least one city")
+
+    def _load_binary_campaign_data(self, data_path: str):
+        """Load campaign data from a memory-mapped .cmap file"""
+        with CampaignMapFile(data_path) as map_file:
+            header = map_file.header
+            self.map_data = {'width': header.width, 'height': header.height,
+                             'hex_size_km': header.hex_size_km, 'bounds': header.bounds}
+            self.map_width = header.width
+            self.map_height = header.height
+            self.hex_size_km = header.hex_size_km
+            self.terrain_map = map_file.terrain_map()
+
+            self._load_countries(map_file.meta['countries'])
+            self._load_cities(map_file.cities())
+            self.neutral_regions = map_file.meta['neutral_regions']
+
+        if not self.cities:
+            raise ValueError("Campaign data must contain at least one city")
+
+    def _load_countries(self, countries: Dict):
+        for country_id, country_info in countries.items():
             for required in ('name', 'color', 'capital', 'description', 'starting_resources', 'bonuses'):
                 if required not in country_info:
                     raise ValueError(f"Country '{country_id}' missing required field: {required}")
@@ -184,8 +230,9 @@ class CampaignState:
                 bonuses=country_info['bonuses']
             )
 
-        # Load cities
-        for city_id, city_info in data['cities'].items():
+    def _load_cities(self, cities):
+        """Add cities from (city id, city dict) pairs"""
+        for city_id, city_info in cities:
             for required in (
                 'name',
                 'country',
@@ -211,12 +258,6 @@ class CampaignState:
                 specialization=city_info['specialization'],
                 description=city_info['description']
             )
-
-        # Load neutral regions
-        self.neutral_regions = data['neutral_regions']
-
-        if not self.cities:
-            raise ValueError("Campaign data must contain at least one city")
             
     def _load_terrain_from_data(self, terrain_data: Dict):
         """Load terrain from JSON data"""
@@ -235,18 +276,14 @@ class CampaignState:
             'glacial': CampaignTerrainType.GLACIAL
         }
         
-        for terrain_name, regions in terrain_data.items():
+        for terrain_name in terrain_data:
             if terrain_name not in terrain_mapping:
                 raise ValueError(f"Unknown campaign terrain type: {terrain_name}")
-            terrain_type = terrain_mapping[terrain_name]
-            
-            for region in regions:
-                # Each region is [min_x, max_x, min_y, max_y]
-                min_x, max_x, min_y, max_y = region
-                for x in range(min_x, max_x):
-                    for y in range(min_y, max_y):
-                        if 0 <= x < self.map_width and 0 <= y < self.map_height:
-                            self.terrain_map[(x, y)] = terrain_type
+        
+        # Each region is [min_x, max_x, min_y, max_y]; later regions overwrite earlier ones
+        self.terrain_map = CampaignTerrainMap(self.map_width, self.map_height)
+        for terrain_name, regions in terrain_data.items():
+            self.terrain_map.fill_rects(terrain_mapping[terrain_name], regions)
                             
     def _create_minimal_data(self):
         """Create minimal data for testing"""
@@ -333,11 +370,11 @@ class CampaignState:
         
     def get_country_cities(self, country: str) -> List[City]:
         """Get all cities owned by a country"""
-        return [c for c in self.cities.values() if c.country == country]
+        return self.cities.owned_by(country)
         
     def get_country_armies(self, country: str) -> List[Army]:
         """Get all armies belonging to a country"""
-        return [a for a in self.armies.values() if a.country == country]
+        return self.armies.owned_by(country)
         
     def end_turn(self):
         """Process end of turn using the modular step framework."""
@@ -374,6 +411,20 @@ class CampaignState:
             'per_turn': per_turn_context
         }
             
+    def play_ai_turns(self) -> AITurnReport:
+        """Play every AI country's turn at once and end each of them.
+        
+        The AI engine plans all AI countries in parallel and commits their
+        orders; end_turn then runs for each AI country until the player's
+        country is current again.
+        """
+        report = self.ai_engine.play_turn(self)
+        for _ in range(len(self.countries)):
+            if self.current_country == self.player_country:
+                break
+            self.end_turn()
+        return report
+        
     def move_army(self, army_id: str, target_hex: HexCoord) -> bool:
         """Move an army to a new hex position"""
         if army_id not in self.armies:
@@ -381,27 +432,24 @@ class CampaignState:
             
         army = self.armies[army_id]
         
-        # Calculate hex distance
-        distance = army.position.distance_to(target_hex)
+        # Cheapest route over terrain, stopping at enemy armies, cities and zones of control
+        cost = self.router.plan_army(army).cost_to(target_hex)
         
-        if distance > army.movement_points:
+        if math.isinf(cost):
             return False
             
         army.position = target_hex
-        army.movement_points -= distance
+        army.movement_points -= int(cost)
         
         # Check if we're entering enemy city or meeting enemy army
-        for city in self.cities.values():
-            if city.position == target_hex:
-                if city.country != army.country:
-                    # Enemy city - trigger battle
-                    return True
+        for city in self.cities.at(target_hex):
+            if city.country != army.country:
+                # Enemy city - trigger battle
+                return True
                     
         # Check for enemy armies at this position
-        for other_army in self.armies.values():
-            if (other_army.id != army_id and 
-                other_army.position == target_hex and
-                other_army.country != army.country):
+        for other_army in self.armies.at(target_hex):
+            if other_army.id != army_id and other_army.country != army.country:
                 # Enemy army - trigger battle
                 return True
                     
@@ -422,7 +470,7 @@ class CampaignState:
         if not self.can_recruit(country, city_name):
             return False
             
-        total_cost = knights * 100 + archers * 80 + cavalry * 150
+        total_cost = recruitment_cost(knights, archers, cavalry)
         
         if self.country_treasury[country] < total_cost:
             return False
@@ -431,9 +479,8 @@ class CampaignState:
         
         # Find existing army or create new one
         army_at_location = None
-        for army in self.armies.values():
-            if (army.country == country and 
-                army.position == city.position):
+        for army in self.armies.at(city.position):
+            if army.country == country:
                 army_at_location = army
                 break
                 
@@ -0,0 +1,150 @@
+"""Dense storage for campaign map terrain."""
+import operator
+from collections.abc import MutableMapping
+from enum import Enum
+from typing import Iterable, Iterator, Optional, Sequence, Tuple
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.config import USE_C_EXTENSIONS
+
+if C_EXTENSION_AVAILABLE:
+    import c_algorithms
+
+
+class CampaignTerrainType(Enum):
+    """Campaign-specific terrain types with elevation-based classification"""
+    # Plains and lowlands (0-200m elevation)
+    PLAINS = "plains"
+
+    # Forest types
+    FOREST = "forest"           # Regular forest
+    DEEP_FOREST = "deep_forest" # Dense/deep forest
+
+    # Elevation-based terrain
+    HILLS = "hills"                   # 200-600m elevation
+    MOUNTAINS = "mountains"           # 600-2500m elevation
+    HIGH_MOUNTAINS = "high_mountains" # 2500m+ elevation
+
+    # Water bodies
+    WATER = "water"
+    DEEP_WATER = "deep_water"
+
+    # Wetlands
+    SWAMP = "swamps"  # Note: using plural to match existing JSON structure
+
+    # Arid regions
+    DESERT = "desert"
+
+    # Cold regions
+    SNOW = "snow"
+    GLACIAL = "glacial"
+
+
+# Cell codes stored in CampaignTerrainMap: 0 is "no terrain", type i is i + 1
+CAMPAIGN_TERRAIN_TYPES = tuple(CampaignTerrainType)
+CAMPAIGN_TERRAIN_BY_CODE: Tuple[Optional[CampaignTerrainType], ...] = (None,) + CAMPAIGN_TERRAIN_TYPES
+CAMPAIGN_TERRAIN_CODES = {terrain_type: code for code, terrain_type in enumerate(CAMPAIGN_TERRAIN_BY_CODE) if code}
+
+
+class CampaignTerrainMap(MutableMapping):
+    """Campaign terrain as one byte per hex, row-major (see CAMPAIGN_TERRAIN_CODES).
+
+    Reads and writes like the {(x, y): CampaignTerrainType} dict it replaces;
+    hexes without terrain are absent. Keys must lie on the map. Bulk loads go
+    through fill_rects, and hot loops can index ``cells`` directly.
+    """
+
+    def __init__(self, width: int, height: int):
+        if width < 0 or height < 0:
+            raise ValueError(f"campaign map size must be non-negative, got {width}x{height}")
+        self.width = width
+        self.height = height
+        self.cells = bytearray(width * height)
+
+    def _index(self, key) -> int:
+        x, y = key
+        if not (0 <= x < self.width and 0 <= y < self.height):
+            raise KeyError(key)
+        return y * self.width + x
+
+    def __getitem__(self, key) -> CampaignTerrainType:
+        terrain_type = CAMPAIGN_TERRAIN_BY_CODE[self.cells[self._index(key)]]
+        if terrain_type is None:
+            raise KeyError(key)
+        return terrain_type
+
+    def get(self, key, default=None):
+        try:
+            x, y = key
+        except (TypeError, ValueError):
+            return default
+        if 0 <= x < self.width and 0 <= y < self.height:
+            terrain_type = CAMPAIGN_TERRAIN_BY_CODE[self.cells[y * self.width + x]]
+            if terrain_type is not None:
+                return terrain_type
+        return default
+
+    def __setitem__(self, key, terrain_type: CampaignTerrainType) -> None:
+        if terrain_type not in CAMPAIGN_TERRAIN_CODES:
+            raise ValueError(f"terrain must be a CampaignTerrainType, got {terrain_type!r}")
+        self.cells[self._index(key)] = CAMPAIGN_TERRAIN_CODES[terrain_type]
+
+    def __delitem__(self, key) -> None:
+        index = self._index(key)
+        if not self.cells[index]:
+            raise KeyError(key)
+        self.cells[index] = 0
+
+    def __contains__(self, key) -> bool:
+        return self.get(key) is not None
+
+    def __iter__(self) -> Iterator[Tuple[int, int]]:
+        width = self.width
+        for index, code in enumerate(self.cells):
+            if code:
+                yield (index % width, index // width)
+
+    def __len__(self) -> int:
+        return len(self.cells) - self.cells.count(0)
+
+    def clear(self) -> None:
+        self.cells[:] = bytes(len(self.cells))
+
+    def snapshot(self) -> bytes:
+        """Copy of the cells, for restore()"""
+        return bytes(self.cells)
+
+    def restore(self, cells: bytes) -> None:
+        if len(cells) != len(self.cells):
+            raise ValueError(f"snapshot has {len(cells)} cells, map has {len(self.cells)}")
+        self.cells[:] = cells
+
+    def fill_rects(self, terrain_type: CampaignTerrainType, rects: Iterable[Sequence[int]],
+                   use_native: Optional[bool] = None) -> None:
+        """Set terrain on every [min_x, max_x, min_y, max_y) rectangle, clipped to the map"""
+        if terrain_type not in CAMPAIGN_TERRAIN_CODES:
+            raise ValueError(f"terrain must be a CampaignTerrainType, got {terrain_type!r}")
+        code = CAMPAIGN_TERRAIN_CODES[terrain_type]
+        if use_native is None:
+            use_native = USE_C_EXTENSIONS and C_EXTENSION_AVAILABLE
+        if use_native and not C_EXTENSION_AVAILABLE:
+            raise ValueError("Native rasteriser requested but the C extension is not available")
+        if use_native:
+            c_algorithms.fill_rects(self.width, self.height, self.cells, code, rects)
+        else:
+            fill_rects_python(self.width, self.height, self.cells, code, rects)
+
+
+def fill_rects_python(width: int, height: int, cells: bytearray, code: int,
+                      rects: Iterable[Sequence[int]]) -> None:
+    """Pure Python twin of c_algorithms.fill_rects"""
+    for rect in rects:
+        if len(rect) != 4:
+            raise ValueError(f"rectangle must be [min_x, max_x, min_y, max_y], got {rect!r}")
+        min_x, max_x, min_y, max_y = (operator.index(v) for v in rect)
+        min_x, max_x = max(min_x, 0), min(max_x, width)
+        if min_x >= max_x:
+            continue
+        run = bytes([code]) * (max_x - min_x)
+        for y in range(max(min_y, 0), min(max_y, height)):
+            cells[y * width + min_x:y * width + max_x] = run
@@ -0,0 +1,346 @@
+"""Columnar storage for the city fields end-turn steps sweep every turn."""
+from array import array
+from collections.abc import Mapping
+from typing import Dict, Iterator, List, Optional, Sequence
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.config import USE_C_EXTENSIONS
+from .campaign_index import CampaignIndex
+from .city_specialization import CitySpecialization
+
+if C_EXTENSION_AVAILABLE:
+    import c_algorithms
+
+# Numeric columns hold the value; interned columns hold an id into the table's name list
+NUMERIC_COLUMNS = ('population', 'income')
+INTERNED_COLUMNS = ('country', 'specialization')
+MIN_POPULATION = 1000
+# Growth rate spread around a specialization's base rate: +/- 0.5%
+GROWTH_JITTER = 0.01
+
+_MASK64 = (1 << 64) - 1
+_GOLDEN_GAMMA = 0x9E3779B97F4A7C15
+_TURN_GAMMA = 0xD1B54A32D192ED03
+
+
+class CityRow:
+    """Handle to one row of a CityTable; a City reads its columns through it"""
+    __slots__ = ('table', 'index')
+
+    def __init__(self, table: 'CityTable', index: int):
+        self.table = table
+        self.index = index
+
+    @classmethod
+    def detached(cls, values=(0, 0, '', '')) -> 'CityRow':
+        """A row in a private one-row table, for cities outside any campaign"""
+        table = CityTable(private=True)
+        table._append(values)
+        return cls(table, 0)
+
+    def values(self) -> tuple:
+        return self.table.row_values(self.index)
+
+    def __deepcopy__(self, memo) -> 'CityRow':
+        # A copied city keeps its values but not its place in a shared table;
+        # a copied CityIndex adopts the copies into its own table
+        return CityRow.detached(self.values())
+
+
+def city_column(column: str, doc: str) -> property:
+    """City attribute stored in the city's CityTable row"""
+    if column in NUMERIC_COLUMNS:
+        def get(self):
+            row = self._row
+            return getattr(row.table, column)[row.index]
+
+        def set(self, value):
+            row = self._row
+            getattr(row.table, column)[row.index] = value
+    else:
+        def get(self):
+            row = self._row
+            table = row.table
+            return table.names[column][getattr(table, column)[row.index]]
+
+        def set(self, value):
+            row = self._row
+            getattr(row.table, column)[row.index] = row.table.intern(column, value)
+
+    return property(get, set, doc=doc)
+
+
+class CityTable:
+    """Struct-of-arrays store of city population, income, country and specialization.
+
+    population and income are array('q') columns; country and
+    specialization are array('H') ids into per-table name lists, so a whole
+    column can be handed to the C kernels. Like UnitTable, a shared table
+    keeps its rows dense: row i belongs to cities[i] under keys[i], and
+    removing a city moves the last row into its slot.
+    """
+
+    def __init__(self, private: bool = False):
+        self.population = array('q')
+        self.income = array('q')
+        self.country = array('H')
+        self.specialization = array('H')
+        self.names: Dict[str, List[str]] = {column: [] for column in INTERNED_COLUMNS}
+        self._name_ids: Dict[str, Dict[str, int]] = {column: {} for column in INTERNED_COLUMNS}
+        self._private = private
+        self.keys: List[str] = []
+        self.cities: List = []
+
+    def __len__(self) -> int:
+        return len(self.population)
+
+    def intern(self, column: str, name: str) -> int:
+        ids = self._name_ids[column]
+        name_id = ids.get(name)
+        if name_id is None:
+            if not isinstance(name, str):
+                raise ValueError(f"city {column} must be a string, got {name!r}")
+            name_id = len(self.names[column])
+            if name_id > 0xFFFF:
+                raise ValueError(f"too many distinct city {column} values")
+            ids[name] = name_id
+            self.names[column].append(name)
+        return name_id
+
+    def name_id(self, column: str, name: str) -> Optional[int]:
+        """Id of an interned name, None when no city ever used it"""
+        return self._name_ids[column].get(name)
+
+    def row_values(self, index: int) -> tuple:
+        return (self.population[index], self.income[index],
+                self.names['country'][self.country[index]],
+                self.names['specialization'][self.specialization[index]])
+
+    def _append(self, values) -> int:
+        population, income, country, specialization = values
+        self.population.append(population)
+        self.income.append(income)
+        self.country.append(self.intern('country', country))
+        self.specialization.append(self.intern('specialization', specialization))
+        return len(self.population) - 1
+
+    def _pop_row(self, index: int) -> None:
+        last = len(self.population) - 1
+        if index != last:
+            for column in (self.population, self.income, self.country, self.specialization):
+                column[index] = column[last]
+            self.cities[index] = self.cities[last]
+            self.keys[index] = self.keys[last]
+            self.cities[index]._row.index = index
+        for column in (self.population, self.income, self.country, self.specialization):
+            column.pop()
+        self.cities.pop()
+        self.keys.pop()
+
+    def adopt(self, key: str, city) -> int:
+        """Move a city's row into this table under key; the city becomes a view of it"""
+        if self._private:
+            raise ValueError("cannot adopt cities into a private row table")
+        row = city._row
+        if row.table is self:
+            self.keys[row.index] = key
+            return row.index
+        values = row.values()
+        row.table._release_row(row)
+        row.table = self
+        row.index = self._append(values)
+        self.cities.append(city)
+        self.keys.append(key)
+        return row.index
+
+    def release(self, city) -> None:
+        """Move a city's row out to a private table, keeping its values"""
+        row = city._row
+        if row.table is not self:
+            return
+        detached = CityRow.detached(row.values())
+        self._release_row(row)
+        row.table = detached.table
+        row.index = 0
+
+    def _release_row(self, row: CityRow) -> None:
+        if not self._private:
+            self._pop_row(row.index)
+
+    @classmethod
+    def gather(cls, cities) -> 'CityTable':
+        """Copy the population and specialization of a plain {key: city}
+        mapping into a new table without rebinding the cities.
+
+        For states that do not keep a CityIndex (test mocks); write results
+        back to the cities afterwards.
+        """
+        table = cls(private=True)
+        for key, city in cities.items():
+            table._append((city.population, 0, '', city.specialization))
+            table.keys.append(key)
+            table.cities.append(city)
+        return table
+
+    @classmethod
+    def of(cls, cities) -> 'CityTable':
+        """The table of a CityIndex, else a gathered copy"""
+        if isinstance(cities, CityIndex):
+            return cities.table
+        return cls.gather(cities)
+
+    def growth_rates(self) -> List[float]:
+        """Base growth rate per interned specialization id"""
+        return [CitySpecialization.get_growth_rate(CitySpecialization.from_string(name))
+                for name in self.names['specialization']]
+
+    def grow_population(self, seed: int, turn_number: int,
+                        use_native: Optional[bool] = None) -> array:
+        """Apply one turn of population growth to every row in place.
+
+        Each row's rate is its specialization's base rate plus a jitter drawn
+        from a counter-based stream keyed by (seed, turn_number, row), so the
+        result does not depend on how or where the kernel runs. Returns the
+        growth rate used for each row.
+        """
+        if use_native is None:
+            use_native = USE_C_EXTENSIONS and C_EXTENSION_AVAILABLE
+        if use_native and not C_EXTENSION_AVAILABLE:
+            raise ValueError("Native city kernels requested but the C extension is not available")
+        key = turn_stream_key(seed, turn_number)
+        if use_native:
+            rates = array('d')
+            rates.frombytes(c_algorithms.grow_population(
+                self.population, self.specialization, self.growth_rates(), key, MIN_POPULATION))
+            return rates
+        return grow_population_python(self.population, self.specialization,
+                                      self.growth_rates(), key, MIN_POPULATION)
+
+    def income_by_country(self, use_native: Optional[bool] = None) -> List[int]:
+        """Total income of each interned country id"""
+        if use_native is None:
+            use_native = USE_C_EXTENSIONS and C_EXTENSION_AVAILABLE
+        if use_native and not C_EXTENSION_AVAILABLE:
+            raise ValueError("Native city kernels requested but the C extension is not available")
+        count = len(self.names['country'])
+        if use_native:
+            totals = array('q')
+            totals.frombytes(c_algorithms.group_sums(self.income, self.country, count))
+            return totals.tolist()
+        return group_sums_python(self.income, self.country, count)
+
+
+class CityIndex(CampaignIndex):
+    """CampaignIndex of cities that also keeps their columns in a CityTable"""
+
+    def __init__(self, cities=None):
+        self.table = CityTable()
+        super().__init__(cities)
+
+    def __setitem__(self, key: str, city) -> None:
+        previous = self._entities.get(key)
+        super().__setitem__(key, city)
+        if previous is not None and previous is not city:
+            self.table.release(previous)
+        self.table.adopt(key, city)
+
+    def __delitem__(self, key: str) -> None:
+        city = self._entities[key]
+        super().__delitem__(key)
+        self.table.release(city)
+
+    def clear(self) -> None:
+        for city in list(self.table.cities):
+            self.table.release(city)
+        super().clear()
+
+
+class PopulationChanges(Mapping):
+    """Per-city population results of one growth step, built on first access.
+
+    Reads like the {city id: {old_population, new_population, change,
+    growth_rate, specialization}} dict it replaces.
+    """
+
+    def __init__(self, keys: Sequence[str], old: array, new: array, rates: array,
+                 specializations: Sequence[str]):
+        self._keys = keys
+        self._old = old
+        self._new = new
+        self._rates = rates
+        self._specializations = specializations
+        self._rows: Optional[Dict[str, int]] = None
+
+    def _row_of(self, key: str) -> int:
+        if self._rows is None:
+            self._rows = {k: row for row, k in enumerate(self._keys)}
+        return self._rows[key]
+
+    def __getitem__(self, key: str) -> Dict:
+        row = self._row_of(key)
+        old, rate = self._old[row], self._rates[row]
+        return {
+            'old_population': old,
+            'new_population': self._new[row],
+            'change': int(old * rate),
+            'growth_rate': rate,
+            'specialization': self._specializations[row],
+        }
+
+    def __contains__(self, key) -> bool:
+        try:
+            self._row_of(key)
+        except KeyError:
+            return False
+        return True
+
+    def __iter__(self) -> Iterator[str]:
+        return iter(self._keys)
+
+    def __len__(self) -> int:
+        return len(self._keys)
+
+    def total_change(self) -> int:
+        return sum(self._new) - sum(self._old)
+
+
+def turn_stream_key(seed: int, turn_number: int) -> int:
+    """Key of a turn's random stream: the seed stepped by turn, then mixed"""
+    return _mix64((seed + turn_number * _TURN_GAMMA) & _MASK64)
+
+
+def stream_uniform(key: int, index: int) -> float:
+    """Draw index of the splitmix64 stream keyed by key, uniform in [0, 1)"""
+    return (_mix64((key + (index + 1) * _GOLDEN_GAMMA) & _MASK64) >> 11) * (1.0 / (1 << 53))
+
+
+def _mix64(x: int) -> int:
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9 & _MASK64
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EB & _MASK64
+    return x ^ (x >> 31)
+
+
+def grow_population_python(population: array, specialization: array, base_rates: Sequence[float],
+                           key: int, min_population: int) -> array:
+    """Pure Python twin of c_algorithms.grow_population"""
+    if len(population) != len(specialization):
+        raise ValueError("population and specialization columns differ in length")
+    rates = array('d', bytes(8 * len(population)))
+    for row, spec in enumerate(specialization):
+        if spec >= len(base_rates):
+            raise ValueError(f"specialization id {spec} has no growth rate")
+        rate = base_rates[spec] + (stream_uniform(key, row) - 0.5) * GROWTH_JITTER
+        current = population[row]
+        population[row] = max(min_population, current + int(current * rate))
+        rates[row] = rate
+    return rates
+
+
+def group_sums_python(values: Sequence[int], groups: Sequence[int], group_count: int) -> List[int]:
+    """Pure Python twin of c_algorithms.group_sums"""
+    totals = [0] * group_count
+    for value, group in zip(values, groups):
+        if group >= group_count:
+            raise ValueError(f"group id {group} out of range")
+        totals[group] += value
+    return totals
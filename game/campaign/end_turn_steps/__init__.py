@@ -1,4 +1,4 @@
-from .base import EndTurnStep, EndTurnContext, StepPriority
+from .base import ALL_RESOURCES, EndTurnStep, EndTurnContext, StepPriority
 from .processor import EndTurnProcessor
 
-__all__ = ['EndTurnStep', 'EndTurnContext', 'StepPriority', 'EndTurnProcessor']
\ No newline at end of file
+__all__ = ['ALL_RESOURCES', 'EndTurnStep', 'EndTurnContext', 'StepPriority', 'EndTurnProcessor']
\ No newline at end of file
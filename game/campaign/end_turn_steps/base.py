@@ -1,7 +1,7 @@
 from abc import ABC, abstractmethod
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from enum import IntEnum
-from typing import Optional, List, Dict, Any
+from typing import Optional, List, Dict, Any, FrozenSet
 
 class StepPriority(IntEnum):
     """Priority levels for end-turn steps. Lower values execute first."""
@@ -14,6 +14,10 @@ class StepPriority(IntEnum):
     EVENTS = 700
     CLEANUP = 800
 
+# Resource set of a step that has not declared what it touches: it conflicts
+# with every other step, so it never runs concurrently with one
+ALL_RESOURCES: FrozenSet[str] = frozenset({'*'})
+
 @dataclass
 class EndTurnContext:
     """Context passed to each end-turn step containing campaign state and results from previous steps."""
@@ -21,6 +25,7 @@ class EndTurnContext:
     current_country_id: int
     turn_number: int
     step_results: Dict[str, Any]  # Results from previous steps
+    step_timings: Dict[str, float] = field(default_factory=dict)  # Seconds each executed step took
     
     def get_result(self, step_name: str, default: Any = None) -> Any:
         """Get the result from a previous step."""
@@ -55,6 +60,27 @@ class EndTurnStep(ABC):
         """List of step names that must execute before this step."""
         return []
     
+    @property
+    def reads(self) -> FrozenSet[str]:
+        """
+        Campaign state this step reads, as 'collection.field' names
+        (e.g. 'cities.income'). Steps run concurrently only when neither
+        writes what the other reads or writes. Results of other steps must
+        only be read through declared dependencies.
+        """
+        return ALL_RESOURCES
+    
+    @property
+    def writes(self) -> FrozenSet[str]:
+        """Campaign state this step modifies; 'random' for the global random stream."""
+        return ALL_RESOURCES
+    
+    def conflicts_with(self, other: 'EndTurnStep') -> bool:
+        """Whether running this step and other in either order could change the outcome."""
+        if ALL_RESOURCES <= (self.reads | self.writes | other.reads | other.writes):
+            return True
+        return bool(self.writes & (other.reads | other.writes) or other.writes & self.reads)
+    
     def should_execute(self, context: EndTurnContext) -> bool:
         """
         Determine if this step should execute for the current context.
@@ -1,4 +1,4 @@
-from typing import Dict, Any, Optional
+from typing import Dict, Any, FrozenSet, Optional
 from .base import EndTurnStep, EndTurnContext, StepPriority
 
 class IncomeCollectionStep(EndTurnStep):
@@ -16,6 +16,14 @@ class IncomeCollectionStep(EndTurnStep):
     def description(self) -> str:
         return "Collects income from all cities belonging to the current country"
     
+    @property
+    def reads(self) -> FrozenSet[str]:
+        return frozenset({'cities.country', 'cities.income'})
+    
+    @property
+    def writes(self) -> FrozenSet[str]:
+        return frozenset({'treasury'})
+    
     def execute(self, context: EndTurnContext) -> Optional[Dict[str, Any]]:
         """Execute income collection for the current country."""
         campaign_state = context.campaign_state
@@ -23,10 +31,8 @@ class IncomeCollectionStep(EndTurnStep):
         total_income = 0
         city_incomes = {}
         
-        # Get cities belonging to current country
-        current_country_cities = campaign_state.get_country_cities(current_country)
-        
-        for city in current_country_cities:
+        # Only the country's own rows: owned_by is indexed, so other countries' cities are never read
+        for city in campaign_state.get_country_cities(current_country):
             campaign_state.country_treasury[current_country] += city.income
             city_incomes[city.name] = city.income
             total_income += city.income
@@ -35,4 +41,5 @@ class IncomeCollectionStep(EndTurnStep):
             'total_income': total_income,
             'city_incomes': city_incomes,
             'treasury_after': campaign_state.country_treasury.get(current_country, 0)
-        }
\ No newline at end of file
+        }
+
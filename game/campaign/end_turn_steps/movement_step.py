@@ -1,5 +1,6 @@
-from typing import Dict, Any, Optional
+from typing import Dict, Any, FrozenSet, Optional
 from .base import EndTurnStep, EndTurnContext, StepPriority
+from ..campaign_index import items_owned_by
 
 class MovementResetStep(EndTurnStep):
     """Resets movement points for all armies belonging to the current country."""
@@ -16,20 +17,27 @@ class MovementResetStep(EndTurnStep):
     def description(self) -> str:
         return "Resets movement points for all armies of the current country"
     
+    @property
+    def reads(self) -> FrozenSet[str]:
+        return frozenset({'armies.country', 'armies.max_movement_points'})
+    
+    @property
+    def writes(self) -> FrozenSet[str]:
+        return frozenset({'armies.movement_points'})
+    
     def execute(self, context: EndTurnContext) -> Optional[Dict[str, Any]]:
         """Execute movement reset for the current country's armies."""
         campaign_state = context.campaign_state
         current_country = context.current_country_id
         reset_armies = {}
         
-        for army_id, army in campaign_state.armies.items():
-            if army.country == current_country:
-                old_movement = army.movement_points
-                army.movement_points = army.max_movement_points
-                reset_armies[army_id] = {
-                    'old_movement': old_movement,
-                    'new_movement': army.movement_points
-                }
+        for army_id, army in items_owned_by(campaign_state.armies, current_country):
+            old_movement = army.movement_points
+            army.movement_points = army.max_movement_points
+            reset_armies[army_id] = {
+                'old_movement': old_movement,
+                'new_movement': army.movement_points
+            }
         
         return {
             'armies_reset': len(reset_armies),
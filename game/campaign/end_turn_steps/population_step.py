@@ -1,7 +1,7 @@
-import random
-from typing import Dict, Any, Optional
+from array import array
+from typing import Dict, Any, FrozenSet, Optional
 from .base import EndTurnStep, EndTurnContext, StepPriority
-from ..city_specialization import CitySpecialization
+from ..city_table import CityIndex, CityTable, PopulationChanges
 
 class PopulationCalculationStep(EndTurnStep):
     """Calculates population growth/decline for all cities."""
@@ -18,39 +18,36 @@ class PopulationCalculationStep(EndTurnStep):
     def description(self) -> str:
         return "Calculates population growth/decline based on city specialization and random factors"
     
+    @property
+    def reads(self) -> FrozenSet[str]:
+        return frozenset({'cities.population', 'cities.specialization'})
+    
+    @property
+    def writes(self) -> FrozenSet[str]:
+        # Draws come from the campaign's seeded stream, not the shared random module
+        return frozenset({'cities.population'})
+    
     def execute(self, context: EndTurnContext) -> Optional[Dict[str, Any]]:
-        """Execute population calculation for all cities."""
+        """Execute population calculation for all cities.
+        
+        Growth runs over the whole population column at once; the per-city
+        result dicts are only built when a caller looks one up.
+        """
         campaign_state = context.campaign_state
-        population_changes = {}
+        seed = getattr(campaign_state, 'random_seed', None)
+        if not isinstance(seed, int):
+            raise ValueError("campaign_state.random_seed is required for population growth")
         
-        for city_name, city in campaign_state.cities.items():
-            old_population = city.population
-            
-            # Calculate base growth rate based on specialization
-            specialization_enum = CitySpecialization.from_string(city.specialization)
-            base_growth_rate = CitySpecialization.get_growth_rate(specialization_enum)
-            
-            # Add random factor (-0.5% to +0.5%)
-            random_factor = (random.random() - 0.5) * 0.01
-            
-            # Calculate actual growth rate
-            growth_rate = base_growth_rate + random_factor
-            
-            # Apply growth
-            population_change = int(city.population * growth_rate)
-            new_population = max(1000, city.population + population_change)  # Minimum 1000 population
-            
-            # Update city population
-            city.population = new_population
-            
-            # Track changes
-            population_changes[city_name] = {
-                'old_population': old_population,
-                'new_population': new_population,
-                'change': population_change,
-                'growth_rate': growth_rate,
-                'specialization': city.specialization
-            }
+        table = CityTable.of(campaign_state.cities)
+        old_population = array('q', table.population)
+        growth_rates = table.grow_population(seed, context.turn_number)
         
-        return population_changes
-    
+        # A gathered table is a copy; write the results back to the cities
+        if not isinstance(campaign_state.cities, CityIndex):
+            for city, population in zip(table.cities, table.population):
+                city.population = population
+        
+        specialization_names = table.names['specialization']
+        return PopulationChanges(
+            list(table.keys), old_population, array('q', table.population), growth_rates,
+            [specialization_names[spec] for spec in table.specialization])
@@ -1,15 +1,65 @@
-from typing import List, Dict, Set
+from concurrent.futures import FIRST_COMPLETED, ThreadPoolExecutor, wait
+from typing import Any, List, Dict, Optional, Set, Tuple
 import logging
+import os
+import threading
+import time
 from .base import EndTurnStep, EndTurnContext
 
 logger = logging.getLogger(__name__)
 
+# Worker pools shared across the campaign, by thread name prefix and size
+_pools: Dict[Tuple[str, int], ThreadPoolExecutor] = {}
+_pools_lock = threading.Lock()
+
+
+def shared_pool(max_workers: int, name: str = "end-turn") -> ThreadPoolExecutor:
+    with _pools_lock:
+        pool = _pools.get((name, max_workers))
+        if pool is None:
+            pool = ThreadPoolExecutor(max_workers=max_workers, thread_name_prefix=name)
+            _pools[(name, max_workers)] = pool
+        return pool
+
+
+class ExecutionPlan:
+    """Steps in sequential order, plus the earlier steps each one must wait for.
+
+    A step waits for its declared dependencies and for every earlier step it
+    conflicts with (see EndTurnStep.conflicts_with), so any schedule that
+    honours the waits produces the sequential results.
+    """
+    
+    def __init__(self, order: List[EndTurnStep]):
+        self.order = order
+        self.waits_for: Dict[str, List[str]] = {step.name: [] for step in order}
+        self.unblocks: Dict[str, List[str]] = {step.name: [] for step in order}
+        for j, step in enumerate(order):
+            dependencies = set(step.dependencies)
+            for earlier in order[:j]:
+                if earlier.name in dependencies or earlier.conflicts_with(step):
+                    self.waits_for[step.name].append(earlier.name)
+                    self.unblocks[earlier.name].append(step.name)
+        
+        # Longest chain of waits ending at each step; steps on one level never wait for each other
+        levels: Dict[str, int] = {}
+        for step in order:
+            levels[step.name] = 1 + max((levels[name] for name in self.waits_for[step.name]), default=-1)
+        self.width = max((list(levels.values()).count(level) for level in set(levels.values())), default=0)
+
+
 class EndTurnProcessor:
-    """Manages and executes end-turn steps in the correct order."""
+    """Manages and executes end-turn steps in the correct order.
+    
+    Steps that neither depend on nor conflict with each other run concurrently
+    on a shared worker pool; max_workers=1 runs every step in sequence.
+    """
     
-    def __init__(self):
+    def __init__(self, max_workers: Optional[int] = None):
         self._steps: List[EndTurnStep] = []
         self._step_map: Dict[str, EndTurnStep] = {}
+        self._plan: Optional[ExecutionPlan] = None
+        self.max_workers = max_workers if max_workers is not None else min(8, os.cpu_count() or 1)
     
     def register_step(self, step: EndTurnStep) -> None:
         """Register a new end-turn step."""
@@ -18,6 +68,7 @@ class EndTurnProcessor:
         
         self._steps.append(step)
         self._step_map[step.name] = step
+        self._plan = None
         logger.info(f"Registered end-turn step: {step.name} (priority: {step.priority})")
     
     def unregister_step(self, step_name: str) -> None:
@@ -26,6 +77,7 @@ class EndTurnProcessor:
             step = self._step_map[step_name]
             self._steps.remove(step)
             del self._step_map[step_name]
+            self._plan = None
             logger.info(f"Unregistered end-turn step: {step_name}")
     
     def get_execution_order(self) -> List[EndTurnStep]:
@@ -33,6 +85,15 @@ class EndTurnProcessor:
         Get the steps in execution order, respecting priorities and dependencies.
         Uses topological sort to handle dependencies correctly.
         """
+        return list(self.get_execution_plan().order)
+    
+    def get_execution_plan(self) -> ExecutionPlan:
+        """The execution plan, rebuilt only after steps are registered or removed."""
+        if self._plan is None:
+            self._plan = ExecutionPlan(self._sort_steps())
+        return self._plan
+    
+    def _sort_steps(self) -> List[EndTurnStep]:
         # First sort by priority
         sorted_steps = sorted(self._steps, key=lambda s: s.priority)
         
@@ -75,7 +136,7 @@ class EndTurnProcessor:
     
     def execute(self, campaign_state, current_country_id: int, turn_number: int) -> EndTurnContext:
         """
-        Execute all registered end-turn steps in order.
+        Execute all registered end-turn steps, running independent ones concurrently.
         
         Args:
             campaign_state: The current campaign state
@@ -83,7 +144,7 @@ class EndTurnProcessor:
             turn_number: Current turn number
             
         Returns:
-            The context with all step results
+            The context with all step results, in execution order
         """
         context = EndTurnContext(
             campaign_state=campaign_state,
@@ -92,30 +153,66 @@ class EndTurnProcessor:
             step_results={}
         )
         
-        execution_order = self.get_execution_order()
-        logger.info(f"Executing {len(execution_order)} end-turn steps for country {current_country_id}")
+        plan = self.get_execution_plan()
+        logger.info(f"Executing {len(plan.order)} end-turn steps for country {current_country_id}")
+        
+        if self.max_workers <= 1 or plan.width <= 1:
+            for step in plan.order:
+                self._run_step(step, context)
+        else:
+            self._run_concurrently(plan, context)
+            # Report results and timings in the order sequential execution would
+            for results in (context.step_results, context.step_timings):
+                ordered = {step.name: results[step.name] for step in plan.order if step.name in results}
+                results.clear()
+                results.update(ordered)
         
-        for step in execution_order:
+        logger.info("End-turn processing complete")
+        return context
+    
+    def _run_concurrently(self, plan: ExecutionPlan, context: EndTurnContext) -> None:
+        pool = shared_pool(self.max_workers)
+        position = {step.name: index for index, step in enumerate(plan.order)}
+        waiting = {name: len(earlier) for name, earlier in plan.waits_for.items()}
+        ready = [step for step in plan.order if not waiting[step.name]]
+        running: Dict[Any, EndTurnStep] = {}
+        
+        while ready or running:
+            for step in ready:
+                running[pool.submit(self._run_step, step, context)] = step
+            ready = []
+            done, _ = wait(running, return_when=FIRST_COMPLETED)
+            for future in done:
+                step = running.pop(future)
+                future.result()
+                for name in plan.unblocks[step.name]:
+                    waiting[name] -= 1
+                    if not waiting[name]:
+                        ready.append(self._step_map[name])
+            ready.sort(key=lambda s: position[s.name])
+    
+    def _run_step(self, step: EndTurnStep, context: EndTurnContext) -> None:
+        try:
+            # Check dependencies
+            if not step.validate_dependencies(context):
+                logger.error(f"Step {step.name} missing dependencies: {step.dependencies}")
+                return
+            
+            # Check if step should execute
+            if not step.should_execute(context):
+                logger.debug(f"Skipping step {step.name} (should_execute returned False)")
+                return
+            
+            logger.debug(f"Executing step: {step.name}")
+            started = time.perf_counter()
             try:
-                # Check dependencies
-                if not step.validate_dependencies(context):
-                    logger.error(f"Step {step.name} missing dependencies: {step.dependencies}")
-                    continue
-                
-                # Check if step should execute
-                if not step.should_execute(context):
-                    logger.debug(f"Skipping step {step.name} (should_execute returned False)")
-                    continue
-                
-                logger.debug(f"Executing step: {step.name}")
                 result = step.execute(context)
+            finally:
+                context.step_timings[step.name] = time.perf_counter() - started
+            
+            if result is not None:
+                context.set_result(step.name, result)
                 
-                if result is not None:
-                    context.set_result(step.name, result)
-                    
-            except Exception as e:
-                logger.error(f"Error executing step {step.name}: {e}", exc_info=True)
-                # Continue with other steps even if one fails
-        
-        logger.info("End-turn processing complete")
-        return context
\ No newline at end of file
+        except Exception as e:
+            logger.error(f"Error executing step {step.name}: {e}", exc_info=True)
+            # Continue with other steps even if one fails
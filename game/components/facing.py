@@ -4,6 +4,9 @@ from typing import Tuple, Optional
 import math
 from dataclasses import dataclass
 
+from game.combat_config import CombatConfig
+from game.entities.unit_table import UnitRow
+
 class FacingDirection(Enum):
     """Six possible facing directions in a hex grid"""
     NORTH_EAST = 0      # Top-right
@@ -23,7 +26,23 @@ class FacingDirection(Enum):
         right = FacingDirection((self.value + 1) % 6)
         return left, right
 
-@dataclass
+_DIRECTIONS = tuple(FacingDirection(value) for value in range(6))
+
+# Screen angle of each facing (0 = east, clockwise)
+FACING_ANGLES = {
+    FacingDirection.EAST: 0,
+    FacingDirection.SOUTH_EAST: 60,
+    FacingDirection.SOUTH_WEST: 120,
+    FacingDirection.WEST: 180,
+    FacingDirection.NORTH_WEST: 240,
+    FacingDirection.NORTH_EAST: 300
+}
+
+# Attacker offsets (dx, dy in offset coordinates) covered by the attack arc table
+ATTACK_TABLE_RADIUS = 6
+
+
+@dataclass(frozen=True)
 class AttackAngle:
     """Result of calculating attack angle"""
     is_frontal: bool
@@ -32,12 +51,48 @@ class AttackAngle:
     angle_degrees: float
     description: str
 
+
+@dataclass(frozen=True)
+class AttackArc:
+    """Attack angle together with the combat modifiers it implies"""
+    angle: AttackAngle
+    damage_modifier: float
+    morale_penalty: int
+    cohesion_penalty: float
+
 class FacingComponent:
     """Component that handles unit facing and directional combat"""
     
     def __init__(self, initial_facing: FacingDirection = FacingDirection.NORTH_EAST):
+        # Facing lives in the owning unit's table row once bound to a unit
+        self._row = UnitRow.detached()
         self.facing = initial_facing
         self._last_move_direction = None
+
+    @property
+    def facing(self) -> FacingDirection:
+        row = self._row
+        return _DIRECTIONS[row.table.facing[row.index]]
+
+    @facing.setter
+    def facing(self, value: FacingDirection):
+        row = self._row
+        row.table.facing[row.index] = value.value
+
+    def bind_row(self, row: UnitRow) -> None:
+        """Store the facing in a unit's row from now on"""
+        row.table.facing[row.index] = self._row.table.facing[self._row.index]
+        self._row = row
+
+    def with_row(self, row: UnitRow) -> 'FacingComponent':
+        """Copy of this component reading its facing from row as it is"""
+        clone = FacingComponent.__new__(FacingComponent)
+        clone.__dict__.update(self.__dict__)
+        clone._row = row
+        return clone
+
+    def __copy__(self) -> 'FacingComponent':
+        return self.with_row(self._row.copy())
         
     def update_facing_from_movement(self, from_x: int, from_y: int, to_x: int, to_y: int):
         """Update facing based on movement direction (Odd-R Flat-Top Layout)"""
@@ -83,60 +138,15 @@ class FacingComponent:
     def get_attack_angle(self, attacker_x: int, attacker_y: int, 
                         defender_x: int, defender_y: int) -> AttackAngle:
         """Determine if an attack is frontal, rear, or flank"""
-        # Calculate relative position of attacker from defender's perspective
-        dx = attacker_x - defender_x
-        dy = attacker_y - defender_y
-        
-        # Convert to angle (0-360 degrees)
-        angle_rad = math.atan2(dy, dx)
-        angle_deg = (math.degrees(angle_rad) + 360) % 360
-        
-        # Get facing angle
-        facing_angles = {
-            FacingDirection.EAST: 0,
-            FacingDirection.SOUTH_EAST: 60,
-            FacingDirection.SOUTH_WEST: 120,
-            FacingDirection.WEST: 180,
-            FacingDirection.NORTH_WEST: 240,
-            FacingDirection.NORTH_EAST: 300
-        }
-        
-        facing_angle = facing_angles[self.facing]
-        
-        # Calculate relative angle
-        relative_angle = (angle_deg - facing_angle + 360) % 360
-        
-        # Determine attack type based on relative angle
-        # Front arc: 300-360 and 0-60 degrees (120 degree arc)
-        # Rear arc: 120-240 degrees (120 degree arc)
-        # Flank arcs: 60-120 and 240-300 degrees (60 degrees each)
-        
-        if relative_angle <= 60 or relative_angle >= 300:
-            return AttackAngle(
-                is_frontal=True, 
-                is_rear=False, 
-                is_flank=False,
-                angle_degrees=relative_angle,
-                description="Frontal attack"
-            )
-        elif 120 <= relative_angle <= 240:
-            return AttackAngle(
-                is_frontal=False, 
-                is_rear=True, 
-                is_flank=False,
-                angle_degrees=relative_angle,
-                description="Rear attack"
-            )
-        else:
-            return AttackAngle(
-                is_frontal=False, 
-                is_rear=False, 
-                is_flank=True,
-                angle_degrees=relative_angle,
-                description="Flank attack"
-            )
-    
-    def get_damage_modifier(self, attack_angle: AttackAngle) -> float:
+        return attack_arc(self.facing, attacker_x - defender_x, attacker_y - defender_y).angle
+
+    def get_attack_arc(self, attacker_x: int, attacker_y: int,
+                       defender_x: int, defender_y: int) -> AttackArc:
+        """Attack angle plus its damage, morale and cohesion modifiers"""
+        return attack_arc(self.facing, attacker_x - defender_x, attacker_y - defender_y)
+
+    @staticmethod
+    def get_damage_modifier(attack_angle: AttackAngle) -> float:
         """Get damage modifier based on attack angle"""
         if attack_angle.is_rear:
             return 1.5  # 50% more damage from rear
@@ -145,7 +155,8 @@ class FacingComponent:
         else:
             return 1.0  # Normal damage from front
     
-    def get_morale_penalty(self, attack_angle: AttackAngle) -> int:
+    @staticmethod
+    def get_morale_penalty(attack_angle: AttackAngle) -> int:
         """Get additional morale penalty for being attacked from bad angle"""
         if attack_angle.is_rear:
             return 15  # Extra morale loss from rear attacks
@@ -154,9 +165,9 @@ class FacingComponent:
         else:
             return 0
 
-    def get_cohesion_penalty(self, attack_angle: AttackAngle) -> float:
+    @staticmethod
+    def get_cohesion_penalty(attack_angle: AttackAngle) -> float:
         """Get cohesion penalty for being attacked from bad angle"""
-        from game.combat_config import CombatConfig
         if attack_angle.is_rear:
             return CombatConfig.COHESION_REAR_PENALTY
         if attack_angle.is_flank:
@@ -208,16 +219,7 @@ class FacingComponent:
                                length: float = 20) -> Tuple[Tuple[float, float], Tuple[float, float]]:
         """Get coordinates for drawing facing arrow"""
         # Calculate arrow endpoint based on facing
-        facing_angles = {
-            FacingDirection.EAST: 0,
-            FacingDirection.SOUTH_EAST: 60,
-            FacingDirection.SOUTH_WEST: 120,
-            FacingDirection.WEST: 180,
-            FacingDirection.NORTH_WEST: 240,
-            FacingDirection.NORTH_EAST: 300
-        }
-        
-        angle_deg = facing_angles[self.facing]
+        angle_deg = FACING_ANGLES[self.facing]
         angle_rad = math.radians(angle_deg)
         
         # Calculate arrow endpoint
@@ -238,3 +240,64 @@ class FacingComponent:
         """Face towards a specific hex coordinate"""
         # Use the same logic as movement
         self.update_facing_from_movement(unit_x, unit_y, target_x, target_y)
+
+
+def _classify_attack(facing: FacingDirection, dx: int, dy: int) -> AttackArc:
+    """Geometric attack arc for an attacker at offset (dx, dy) from the defender"""
+    angle_deg = (math.degrees(math.atan2(dy, dx)) + 360) % 360
+    relative_angle = (angle_deg - FACING_ANGLES[facing] + 360) % 360
+
+    # Front arc: 300-360 and 0-60 degrees (120 degree arc)
+    # Rear arc: 120-240 degrees (120 degree arc)
+    # Flank arcs: 60-120 and 240-300 degrees (60 degrees each)
+    if relative_angle <= 60 or relative_angle >= 300:
+        angle = AttackAngle(is_frontal=True, is_rear=False, is_flank=False,
+                            angle_degrees=relative_angle, description="Frontal attack")
+    elif 120 <= relative_angle <= 240:
+        angle = AttackAngle(is_frontal=False, is_rear=True, is_flank=False,
+                            angle_degrees=relative_angle, description="Rear attack")
+    else:
+        angle = AttackAngle(is_frontal=False, is_rear=False, is_flank=True,
+                            angle_degrees=relative_angle, description="Flank attack")
+
+    return AttackArc(
+        angle=angle,
+        damage_modifier=FacingComponent.get_damage_modifier(angle),
+        morale_penalty=FacingComponent.get_morale_penalty(angle),
+        cohesion_penalty=FacingComponent.get_cohesion_penalty(angle),
+    )
+
+
+def _build_attack_table():
+    size = 2 * ATTACK_TABLE_RADIUS + 1
+    table = [None] * (len(FacingDirection) * size * size)
+    for facing in FacingDirection:
+        for dy in range(-ATTACK_TABLE_RADIUS, ATTACK_TABLE_RADIUS + 1):
+            for dx in range(-ATTACK_TABLE_RADIUS, ATTACK_TABLE_RADIUS + 1):
+                index = (facing.value * size + dy + ATTACK_TABLE_RADIUS) * size + dx + ATTACK_TABLE_RADIUS
+                table[index] = _classify_attack(facing, dx, dy)
+    return table
+
+
+# Attack arc tables by the (flank, rear) cohesion penalties they were built with
+_ATTACK_TABLES = {}
+
+
+def attack_arc(facing: FacingDirection, dx: int, dy: int) -> AttackArc:
+    """Attack arc for an attacker at offset (dx, dy) from a defender facing `facing`.
+
+    The classification only depends on the facing and the offset, so offsets
+    within ATTACK_TABLE_RADIUS (every attack range and the AI's threat checks)
+    come from a table built on first use; farther ones are classified directly.
+    Tables are kept per CombatConfig cohesion penalties, so changing those
+    takes effect on the next lookup.
+    """
+    radius = ATTACK_TABLE_RADIUS
+    if -radius <= dx <= radius and -radius <= dy <= radius:
+        penalties = (CombatConfig.COHESION_FLANK_PENALTY, CombatConfig.COHESION_REAR_PENALTY)
+        table = _ATTACK_TABLES.get(penalties)
+        if table is None:
+            table = _ATTACK_TABLES[penalties] = _build_attack_table()
+        size = 2 * radius + 1
+        return table[(facing.value * size + dy + radius) * size + dx + radius]
+    return _classify_attack(facing, dx, dy)
@@ -2,10 +2,15 @@
 from dataclasses import dataclass
 from typing import Dict, Any
 from game.components.base import Component
+from game.entities.unit_table import COLUMN_INDEX, UnitRow
 
 @dataclass
 class UnitStats:
-    """Data class for unit statistics"""
+    """Data class for unit statistics.
+
+    current_soldiers, current_cohesion and morale are stored in a UnitTable
+    row, shared with the owning unit once bound to it.
+    """
     max_soldiers: int
     current_soldiers: int
     attack_per_soldier: float
@@ -18,6 +23,44 @@ class UnitStats:
     will: float = 100.0
     max_will: float = 100.0
 
+    def bind_row(self, row: UnitRow) -> None:
+        """Store the row-backed fields in a unit's row from now on"""
+        soldiers, morale, cohesion = self.current_soldiers, self.morale, self.current_cohesion
+        self._row = row
+        self.current_soldiers, self.morale, self.current_cohesion = soldiers, morale, cohesion
+
+    def with_row(self, row: UnitRow) -> 'UnitStats':
+        """Copy of these stats reading its row-backed fields from row as they are"""
+        clone = UnitStats.__new__(UnitStats)
+        clone.__dict__.update(self.__dict__)
+        clone._row = row
+        return clone
+
+    def __copy__(self) -> 'UnitStats':
+        return self.with_row(self._row.copy())
+
+
+def _row_backed(column: str, doc: str) -> property:
+    position = COLUMN_INDEX[column]
+
+    def get(self):
+        row = self._row
+        return row.table.columns[position][row.index]
+
+    def set(self, value):
+        row = self.__dict__.get('_row')
+        if row is None:
+            # First assignment from the dataclass __init__
+            row = self._row = UnitRow.detached()
+        row.table.columns[position][row.index] = value
+
+    return property(get, set, doc=doc)
+
+
+UnitStats.current_soldiers = _row_backed('soldiers', "Soldiers still in the ranks")
+UnitStats.current_cohesion = _row_backed('cohesion', "Current formation integrity")
+UnitStats.morale = _row_backed('morale', "Base morale, before general bonuses")
+
 class StatsComponent(Component):
     """Component for managing unit statistics"""
     
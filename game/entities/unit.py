@@ -1,6 +1,5 @@
 """Refactored unit class using components and behaviors"""
 from typing import Dict, List, Optional, Any, Tuple
-from dataclasses import dataclass
 from game.components.stats import StatsComponent, UnitStats
 from game.components.base import Behavior
 from game.components.generals import GeneralRoster
@@ -10,11 +9,43 @@ from game.entities.quality import UnitQuality
 from game.combat_config import CombatConfig
 from game.hex_utils import HexGrid
 from game.behaviors.movement_service import MovementService
+from game.entities.unit_table import (
+    UnitRow, FLAG_HAS_MOVED, FLAG_HAS_ACTED, FLAG_HAS_USED_SPECIAL, FLAG_ROUTING,
+    FLAG_DISRUPTED, FLAG_GARRISONED, FLAG_IN_ENEMY_ZOC, FLAG_ENGAGED, NO_PLAYER, COLUMN_INDEX,
+)
+
+
+def _column_property(column: str, doc: str) -> property:
+    """Unit attribute stored in the unit's UnitTable row"""
+    position = COLUMN_INDEX[column]
+
+    def get(self):
+        row = self._row
+        return row.table.columns[position][row.index]
+
+    def set(self, value):
+        row = self._row
+        row.table.columns[position][row.index] = value
+
+    return property(get, set, doc=doc)
+
+
+def _flag_property(bit: int, doc: str) -> property:
+    """Boolean unit attribute packed into the row's flags column"""
+    def get(self) -> bool:
+        row = self._row
+        return (row.table.flags[row.index] & bit) != 0
+
+    def set(self, value: bool):
+        row = self._row
+        flags = row.table.flags
+        if value:
+            flags[row.index] |= bit
+        else:
+            flags[row.index] &= ~bit
+
+    return property(get, set, doc=doc)
 
-@dataclass
-class UnitPosition:
-    x: int
-    y: int
 
 class Unit:
     """Base unit class using component architecture"""
@@ -28,14 +59,18 @@ class Unit:
             raise ValueError("x and y must be integers")
         if not isinstance(quality, UnitQuality):
             raise ValueError(f"quality must be UnitQuality, got {type(quality).__name__}")
+        # Hot per-unit fields live in a UnitTable row; a BattleState adopts
+        # the row into its own table when the unit joins the battle
+        self._row = UnitRow.detached()
         self.name = name
         self.unit_class = unit_class
         self.quality = quality
         self.times_routed = 0
-        self.position = UnitPosition(x, y)
+        self.x = x
+        self.y = y
         
         # Core properties
-        self.player_id: Optional[int] = None
+        self.player_id = None
         self.selected = False
         self.has_moved = False
         self.has_acted = False
@@ -47,6 +82,7 @@ class Unit:
         
         # Components
         self.stats = StatsComponent(self._create_unit_stats())
+        self.stats.stats.bind_row(self._row)
         self.stats.attach(self)
         
         # General roster
@@ -54,6 +90,7 @@ class Unit:
         
         # Facing component
         self.facing = FacingComponent()
+        self.facing.bind_row(self._row)
         
         # Behaviors
         self.behaviors: Dict[str, Behavior] = {}
@@ -75,21 +112,29 @@ class Unit:
         self.temp_damage_multiplier = 1.0
         self.temp_vulnerability = 1.0
         
+    x = _column_property('x', "Column on the battle map")
+    y = _column_property('y', "Row on the battle map")
+    action_points = _column_property('action_points', "Action points left this turn")
+
+    has_moved = _flag_property(FLAG_HAS_MOVED, "Moved this turn")
+    has_acted = _flag_property(FLAG_HAS_ACTED, "Attacked or acted this turn")
+    has_used_special = _flag_property(FLAG_HAS_USED_SPECIAL, "Used a special ability this turn")
+    is_routing = _flag_property(FLAG_ROUTING, "Fleeing and out of command")
+    is_disrupted = _flag_property(FLAG_DISRUPTED, "Formation broken by terrain")
+    is_garrisoned = _flag_property(FLAG_GARRISONED, "Inside a castle")
+    in_enemy_zoc = _flag_property(FLAG_IN_ENEMY_ZOC, "Inside an enemy zone of control")
+    is_engaged_in_combat = _flag_property(FLAG_ENGAGED, "Locked in melee with engaged_with")
+
     @property
-    def x(self) -> int:
-        return self.position.x
-        
-    @x.setter
-    def x(self, value: int):
-        self.position.x = value
-        
-    @property
-    def y(self) -> int:
-        return self.position.y
-        
-    @y.setter  
-    def y(self, value: int):
-        self.position.y = value
+    def player_id(self) -> Optional[int]:
+        row = self._row
+        player = row.table.player[row.index]
+        return None if player == NO_PLAYER else player
+
+    @player_id.setter
+    def player_id(self, value: Optional[int]):
+        row = self._row
+        row.table.player[row.index] = NO_PLAYER if value is None else value
         
     @property
     def soldiers(self) -> int:
@@ -301,23 +346,9 @@ class Unit:
         if not routing_moves:
             return False
             
-        # Choose the best routing move (furthest from nearest enemy)
-        enemies = [k for k in game_state.knights if k.player_id != self.player_id]
-        if not enemies:
-            return False
-            
-        nearest_enemy = min(enemies, key=lambda e: abs(e.x - self.x) + abs(e.y - self.y))
-        
-        # Find the move that gets furthest from nearest enemy
-        best_move = None
-        best_distance = 0
-        
-        for move_x, move_y in routing_moves:
-            distance = abs(move_x - nearest_enemy.x) + abs(move_y - nearest_enemy.y)
-            if distance > best_distance:
-                best_distance = distance
-                best_move = (move_x, move_y)
-        
+        # Routing moves come farthest from the enemies first; take the first free one
+        best_move = next((move for move in routing_moves if not game_state.get_knight_at(*move)), None)
+
         # Execute the routing movement if we found a good move
         if best_move:
             old_x, old_y = self.x, self.y
@@ -449,7 +480,7 @@ class Unit:
     def _create_unit_stats(self) -> UnitStats:
         """Create stats based on unit class"""
         stats_by_class = {
-            KnightClass.WARRIOR: UnitStats(
+            KnightClass.WARRIOR: dict(
                 max_soldiers=100,
                 current_soldiers=100,
                 attack_per_soldier=1.0,
@@ -458,7 +489,7 @@ class Unit:
                 max_cohesion=100.0,
                 current_cohesion=100.0
             ),
-            KnightClass.ARCHER: UnitStats(
+            KnightClass.ARCHER: dict(
                 max_soldiers=80,
                 current_soldiers=80,
                 attack_per_soldier=1.5,
@@ -467,7 +498,7 @@ class Unit:
                 max_cohesion=85.0,
                 current_cohesion=85.0
             ),
-            KnightClass.CAVALRY: UnitStats(
+            KnightClass.CAVALRY: dict(
                 max_soldiers=50,
                 current_soldiers=50,
                 attack_per_soldier=2.0,
@@ -476,7 +507,7 @@ class Unit:
                 max_cohesion=90.0,
                 current_cohesion=90.0
             ),
-            KnightClass.MAGE: UnitStats(
+            KnightClass.MAGE: dict(
                 max_soldiers=30,
                 current_soldiers=30,
                 attack_per_soldier=3.0,
@@ -486,7 +517,7 @@ class Unit:
                 current_cohesion=75.0
             )
         }
-        stats = stats_by_class[self.unit_class]
+        stats = UnitStats(**stats_by_class[self.unit_class])
         
         # Apply Quality Modifiers
         stats.max_morale = max(10, stats.max_morale + self.quality.morale_modifier)
@@ -1068,30 +1099,19 @@ class Unit:
         cls = self.__class__
         clone = cls.__new__(cls)
         
+        # One row copy carries position, player, AP, strength, facing and
+        # the turn/ZOC/engagement flags
+        clone._row = self._row.copy()
+
         # Copy essential primitive state
         clone.name = self.name
         clone.unit_class = self.unit_class
-        clone.position = UnitPosition(self.x, self.y)
-        clone.player_id = self.player_id
         clone.quality = self.quality
         clone.times_routed = self.times_routed
-        clone.action_points = self.action_points
         clone.max_action_points = self.max_action_points
-        
-        # Copy turn state flags
-        clone.has_moved = self.has_moved
-        clone.has_acted = self.has_acted
-        clone.has_used_special = self.has_used_special
         clone.selected = False # AI clones shouldn't be selected
         
-        # Copy essential flags
-        clone.is_routing = self.is_routing
-        clone.is_disrupted = self.is_disrupted
-        clone.is_garrisoned = self.is_garrisoned
-        clone.is_engaged_in_combat = self.is_engaged_in_combat
-        
         # Copy ZOC and engagement state
-        clone.in_enemy_zoc = self.in_enemy_zoc
         clone.engaged_with = self.engaged_with # Reference to original unit (acceptable for simulation checks)
         clone.zoc_enemy = self.zoc_enemy
         clone.garrison_location = self.garrison_location
@@ -1105,12 +1125,12 @@ class Unit:
         clone.stats = copy.copy(self.stats)
         # Stats inside StatsComponent also needs to be cloned
         if hasattr(self.stats, 'stats'):
-            clone.stats.stats = copy.copy(self.stats.stats)
+            clone.stats.stats = self.stats.stats.with_row(clone._row)
             
         # Behaviors and Generals can be shared (read-only in simulation usually)
         # but we need to ensure they point to the NEW unit
         clone.behaviors = self.behaviors.copy()
         clone.generals = self.generals # Shared for speed
-        clone.facing = copy.copy(self.facing) if hasattr(self, 'facing') else None
+        clone.facing = self.facing.with_row(clone._row) if getattr(self, 'facing', None) is not None else None
         
         return clone
@@ -0,0 +1,233 @@
+"""Columnar storage for the per-unit fields that hot loops read"""
+from array import array
+from typing import Iterable, List, Optional
+
+# Flag bits packed into the 'flags' column
+FLAG_HAS_MOVED = 1 << 0
+FLAG_HAS_ACTED = 1 << 1
+FLAG_HAS_USED_SPECIAL = 1 << 2
+FLAG_ROUTING = 1 << 3
+FLAG_DISRUPTED = 1 << 4
+FLAG_GARRISONED = 1 << 5
+FLAG_IN_ENEMY_ZOC = 1 << 6
+FLAG_ENGAGED = 1 << 7
+
+# Column name -> array typecode. Player -1 means "no player"; facing is the
+# FacingDirection value.
+COLUMNS = (
+    ('x', 'i'),
+    ('y', 'i'),
+    ('player', 'b'),
+    ('soldiers', 'i'),
+    ('morale', 'd'),
+    ('cohesion', 'd'),
+    ('action_points', 'd'),
+    ('facing', 'b'),
+    ('flags', 'H'),
+)
+COLUMN_NAMES = tuple(name for name, _ in COLUMNS)
+# Position of each column in UnitTable.columns
+COLUMN_INDEX = {name: index for index, name in enumerate(COLUMN_NAMES)}
+NO_PLAYER = -1
+DEFAULT_ROW = (0, 0, NO_PLAYER, 0, 100.0, 0.0, 0.0, 0, 0)
+
+
+class UnitRow:
+    """Handle to one row of a UnitTable.
+
+    A unit, its UnitStats and its FacingComponent share one handle, so moving
+    the row to another table rebinds all three views at once.
+    """
+    __slots__ = ('table', 'index')
+
+    def __init__(self, table: 'UnitTable', index: int):
+        self.table = table
+        self.index = index
+
+    @classmethod
+    def detached(cls, values=DEFAULT_ROW) -> 'UnitRow':
+        """A row in a private one-row table, for units outside any battle"""
+        table = UnitTable(private=True)
+        table._append(values)
+        return cls(table, 0)
+
+    def values(self) -> tuple:
+        return self.table.row_values(self.index)
+
+    def copy(self) -> 'UnitRow':
+        """A detached row holding the same values"""
+        return UnitRow.detached(self.values())
+
+
+class UnitTable:
+    """Struct-of-arrays store of unit positions, strength, AP, facing and flags.
+
+    Each column is an array.array, so it can be iterated cheaply or passed to
+    the C extension through the buffer protocol. A shared table (the one a
+    BattleState owns) keeps its rows dense: row i belongs to units[i], and
+    removing a unit moves the last row into its slot.
+    """
+
+    def __init__(self, private: bool = False):
+        for name, typecode in COLUMNS:
+            setattr(self, name, array(typecode))
+        # Same arrays by position, for views that index a column per access
+        self.columns = tuple(getattr(self, name) for name in COLUMN_NAMES)
+        # Private tables are never shared: a detached unit's own row, or a
+        # gathered read-only copy. Units are not moved in or out of them.
+        self._private = private
+        self.units: List = []
+        self._rows: List[UnitRow] = []
+
+    def __len__(self) -> int:
+        return len(self.x)
+
+    def row_values(self, index: int) -> tuple:
+        return (self.x[index], self.y[index], self.player[index], self.soldiers[index],
+                self.morale[index], self.cohesion[index], self.action_points[index],
+                self.facing[index], self.flags[index])
+
+    def _append(self, values) -> int:
+        for name, value in zip(COLUMN_NAMES, values):
+            getattr(self, name).append(value)
+        return len(self.x) - 1
+
+    def _pop_row(self, index: int) -> None:
+        """Remove a row of a shared table, moving the last row into its place"""
+        last = len(self.x) - 1
+        if index != last:
+            for name in COLUMN_NAMES:
+                column = getattr(self, name)
+                column[index] = column[last]
+            moved = self._rows[last]
+            moved.index = index
+            self._rows[index] = moved
+            self.units[index] = self.units[last]
+        for name in COLUMN_NAMES:
+            getattr(self, name).pop()
+        self._rows.pop()
+        self.units.pop()
+
+    def adopt(self, unit) -> int:
+        """Move a unit's row into this table; the unit becomes a view of it"""
+        if self._private:
+            raise ValueError("cannot adopt units into a private row table")
+        row = unit._row
+        if row.table is self:
+            return row.index
+        values = row.values()
+        row.table._release_row(row)
+        row.table = self
+        row.index = self._append(values)
+        self._rows.append(row)
+        self.units.append(unit)
+        return row.index
+
+    def release(self, unit) -> None:
+        """Move a unit's row out to a private table, keeping its values"""
+        row = unit._row
+        if row.table is not self:
+            raise ValueError(f"{unit.name} has no row in this table")
+        detached = UnitRow.detached(row.values())
+        self._release_row(row)
+        row.table = detached.table
+        row.index = 0
+
+    def _release_row(self, row: UnitRow) -> None:
+        if not self._private:
+            self._pop_row(row.index)
+
+    def sync(self, units: Iterable) -> 'UnitTable':
+        """Make the table hold exactly these units' rows"""
+        units = list(units)
+        if len(units) == len(self.units) and all(unit._row.table is self for unit in units):
+            return self
+        keep = {id(unit) for unit in units}
+        for unit in [u for u in self.units if id(u) not in keep]:
+            self.release(unit)
+        for unit in units:
+            self.adopt(unit)
+        return self
+
+    def index_of(self, unit) -> Optional[int]:
+        row = unit._row
+        return row.index if row.table is self else None
+
+    @classmethod
+    def gather(cls, units: Iterable) -> 'UnitTable':
+        """Copy units' rows into a new table without rebinding the units.
+
+        For states that do not own a table (AI search states, test mocks).
+        """
+        table = cls(private=True)
+        for unit in units:
+            table._append(unit._row.values())
+            table.units.append(unit)
+        return table
+
+    @classmethod
+    def of(cls, game_state) -> 'UnitTable':
+        """The unit table of a game state: its own if it has one, else a gathered copy"""
+        table = getattr(game_state, 'unit_table', None)
+        if table is not None:
+            return table
+        return cls.gather(game_state.knights)
+
+
+class UnitList(list):
+    """A list of units whose UnitTable holds exactly its units' rows.
+
+    Adding or removing units syncs the table, so readers of the table never
+    have to. Copies and pickles are plain lists.
+    """
+    __slots__ = ('table',)
+
+    def __init__(self, table: UnitTable, units: Iterable = ()):
+        super().__init__(units)
+        self.table = table
+        table.sync(self)
+
+    def __reduce_ex__(self, protocol):
+        return list, (list(self),)
+
+    def append(self, unit) -> None:
+        super().append(unit)
+        self.table.adopt(unit)
+
+    def extend(self, units: Iterable) -> None:
+        super().extend(units)
+        self.table.sync(self)
+
+    def insert(self, index: int, unit) -> None:
+        super().insert(index, unit)
+        self.table.adopt(unit)
+
+    def remove(self, unit) -> None:
+        super().remove(unit)
+        self.table.sync(self)
+
+    def pop(self, index: int = -1):
+        unit = super().pop(index)
+        self.table.sync(self)
+        return unit
+
+    def clear(self) -> None:
+        super().clear()
+        self.table.sync(self)
+
+    def __setitem__(self, index, value) -> None:
+        super().__setitem__(index, value)
+        self.table.sync(self)
+
+    def __delitem__(self, index) -> None:
+        super().__delitem__(index)
+        self.table.sync(self)
+
+    def __iadd__(self, units: Iterable) -> 'UnitList':
+        self.extend(units)
+        return self
+
+    def __imul__(self, count: int) -> 'UnitList':
+        super().__imul__(count)
+        self.table.sync(self)
+        return self
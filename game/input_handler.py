@@ -49,6 +49,7 @@ class InputHandler:
                     if game_state.attack_with_selected_knight_hex(attack_tile_x, attack_tile_y):
                         game_state.current_action = None
                         game_state.attack_targets = []
+                        game_state.attack_previews = {}
                     else:
                         # Show attack failure feedback
                         target = game_state.get_knight_at(attack_tile_x, attack_tile_y)
@@ -69,6 +70,7 @@ class InputHandler:
                     if game_state.charge_with_selected_knight_hex(charge_tile_x, charge_tile_y):
                         game_state.current_action = None
                         game_state.attack_targets = []
+                        game_state.attack_previews = {}
                     else:
                         # Show charge failure feedback
                         charge_info = game_state.get_charge_info_at(charge_tile_x, charge_tile_y)
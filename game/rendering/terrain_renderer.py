@@ -235,5 +235,11 @@ class TerrainRenderer:
                 screen_x, screen_y = game_state.world_to_screen(pixel_x, pixel_y)
                 corners = self.hex_layout.get_hex_corners(screen_x, screen_y)
                 pygame.draw.polygon(self.screen, (255, 100, 100), corners, 3)
+
+                # Expected casualties dealt / taken
+                preview = getattr(game_state, 'attack_previews', {}).get((target_x, target_y))
+                if preview:
+                    preview_text = self.font.render(f"-{preview[0]} / -{preview[1]}", True, (255, 230, 230))
+                    self.screen.blit(preview_text, preview_text.get_rect(center=(screen_x, screen_y)))
         
         # Note: Selected unit highlight is now handled by unit renderer
@@ -8,8 +8,11 @@ from game.components.facing import FacingDirection
 from game.entities.castle import Castle
 from game.entities.knight import KnightClass
 from game.entities.unit_factory import UnitFactory
+from game.entities.unit_table import UnitList, UnitTable
 from game.interfaces.game_state import IGameState
 from game.state.victory_manager import VictoryManager
+from game.systems.engagement import EngagementTracker
+from game.systems.flee_field import FleeFieldCache
 from game.terrain import TerrainMap
 from game.visibility import FogOfWar
 
@@ -64,7 +67,10 @@ class BattleState(IGameState):
             raise ValueError("campaign_battle requires attacker_army and defender_army")
 
         self.castles = []
+        self._unit_table = UnitTable()
         self.knights = []
+        self.engagement = EngagementTracker()
+        self.flee_fields = FleeFieldCache()
         self.current_player = 1
         self.player_count = 2
         self.turn_number = 1
@@ -380,6 +386,20 @@ class BattleState(IGameState):
 
         return True
 
+    @property
+    def knights(self) -> UnitList:
+        return self._knights
+
+    @knights.setter
+    def knights(self, units) -> None:
+        # Adding or removing knights moves their rows in or out of unit_table
+        self._knights = UnitList(self._unit_table, units)
+
+    @property
+    def unit_table(self) -> UnitTable:
+        """Columnar view of the knights, kept in step as knights are added and removed"""
+        return self._unit_table
+
     def cleanup_dead_knights(self) -> bool:
         had_dead_knights = any(k.soldiers <= 0 for k in self.knights)
         self.knights = [k for k in self.knights if k.soldiers > 0]
@@ -390,9 +410,7 @@ class BattleState(IGameState):
         return had_dead_knights
 
     def update_zoc_status(self) -> None:
-        from game.systems.engagement import EngagementSystem
-
-        EngagementSystem.update_zoc_and_engagement(self)
+        self.engagement.update(self)
 
     def end_turn(self) -> EndTurnResult:
         rallied_units = []
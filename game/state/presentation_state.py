@@ -4,6 +4,7 @@ from __future__ import annotations
 from typing import Optional
 
 from game.ai.ai_player import AIPlayer
+from game.ai.background_turn import BackgroundAITurn
 from game.battle.adapters.battle_context import BattleContextAdapter
 from game.battle.application.commands import AttackUnitCommand, ChargeUnitCommand, MoveUnitCommand
 from game.battle.application.handlers import AttackUnitHandler, ChargeUnitHandler, MoveUnitHandler
@@ -15,6 +16,7 @@ from game.hex_utils import HexGrid
 from game.state.animation_coordinator import AnimationCoordinator
 from game.state.camera_manager import CameraManager
 from game.state.message_system import MessageSystem
+from game.systems.combat_batch import BatchCombatEvaluator
 from game.ui.context_menu import ContextMenu
 from game.visibility import VisibilityState
 from game.animation import MoveAnimation, AttackAnimation, ArrowAnimation, PathMoveAnimation
@@ -58,6 +60,8 @@ class PresentationState:
         self.context_menu = ContextMenu()
         self.current_action = None
         self.attack_targets = []
+        # (x, y) -> (expected casualties, expected counter casualties) for attack_targets
+        self.attack_previews = {}
         self.enemy_info_unit = None
         self.terrain_info = None
 
@@ -68,6 +72,9 @@ class PresentationState:
         self.ai_player = AIPlayer(2, 'medium') if vs_ai else None
         self.ai_thinking = False
         self.ai_turn_delay = 0
+        # Plan AI actions on a worker thread so frames keep rendering while it thinks
+        self.ai_background_planning = True
+        self._ai_turn = None
 
         self.show_coordinates = False
         self.show_enemy_paths = True
@@ -96,6 +103,7 @@ class PresentationState:
         return self._game_state
 
     def publish(self, event) -> None:
+        self.battle_state.engagement.publish(event)
         if isinstance(event, UnitMoved):
             self._handle_unit_moved(event)
             return
@@ -166,6 +174,7 @@ class PresentationState:
         )
         self.animation_coordinator.animation_manager.add_animation(anim)
         self.attack_targets = []
+        self.attack_previews = {}
 
     def _handle_charge_resolved(self, event: ChargeResolved) -> None:
         attacker = self._get_unit_by_id(event.attacker_id)
@@ -196,6 +205,14 @@ class PresentationState:
     def knights(self):
         return self.battle_state.knights
 
+    @property
+    def unit_table(self):
+        return self.battle_state.unit_table
+
+    @property
+    def flee_fields(self):
+        return self.battle_state.flee_fields
+
     @property
     def castles(self):
         return self.battle_state.castles
@@ -263,6 +280,14 @@ class PresentationState:
         self.battle_state.cleanup_dead_knights()
         self.battle_state.update_zoc_status()
 
+        if self._ai_turn is not None:
+            # Apply finished plans even while earlier actions are still animating
+            turn_over = self._ai_turn.poll()
+            if not turn_over or self.animation_coordinator.is_animating():
+                return
+            self._finish_ai_turn()
+            return
+
         if self.animation_coordinator.is_animating():
             return
 
@@ -277,8 +302,11 @@ class PresentationState:
         if self.ai_thinking:
             self.ai_turn_delay -= dt
             if self.ai_turn_delay <= 0:
-                self._execute_ai_turn()
-                self.ai_thinking = False
+                if self.ai_background_planning:
+                    self._start_ai_turn()
+                else:
+                    self._execute_ai_turn()
+                    self.ai_thinking = False
 
     def _execute_ai_turn(self) -> None:
         if self.ai_player is None:
@@ -294,6 +322,26 @@ class PresentationState:
         print("AI Turn End")
         self._game_state.end_turn()
 
+    def _start_ai_turn(self) -> None:
+        if self.ai_player is None:
+            raise ValueError("AI player is not configured")
+        if self._game_state is None:
+            raise ValueError("PresentationState is not bound to GameState")
+
+        print(
+            f"AI Turn Start (Player {self.ai_player.player_id}, "
+            f"Difficulty: {self.ai_player.difficulty})"
+        )
+        self._ai_turn = BackgroundAITurn(self.ai_player, self._game_state)
+        self._ai_turn.start()
+
+    def _finish_ai_turn(self) -> None:
+        # Only once the last animation has landed, as end_turn resets the units
+        self._ai_turn = None
+        self.ai_thinking = False
+        print("AI Turn End")
+        self._game_state.end_turn()
+
     def set_camera_position(self, x, y) -> None:
         if hasattr(self, 'camera_manager'):
             self.camera_manager.set_camera_position(x, y)
@@ -376,6 +424,7 @@ class PresentationState:
         self.possible_moves = []
         self.current_action = None
         self.attack_targets = []
+        self.attack_previews = {}
         self.context_menu.hide()
 
     def _filter_valid_moves(self, moves):
@@ -482,6 +531,7 @@ class PresentationState:
         elif action == 'attack' and self.selected_knight and self.selected_knight.can_attack():
             self.current_action = 'attack'
             self.attack_targets = self._get_attack_targets()
+            self.attack_previews = self._get_attack_previews(self.attack_targets)
             self.add_message(
                 f"Attack mode: {len(self.attack_targets)} targets available",
                 priority=1,
@@ -489,6 +539,7 @@ class PresentationState:
         elif action == 'charge' and self.selected_knight:
             self.current_action = 'charge'
             self.attack_targets = self._get_charge_targets()
+            self.attack_previews = {}
         elif action == 'enter_garrison':
             self._enter_garrison()
         elif action == 'exit_garrison':
@@ -570,6 +621,29 @@ class PresentationState:
 
         return targets
 
+    def _get_attack_previews(self, targets):
+        """Expected outcome of attacking each target, evaluated in one batch"""
+        if not self.selected_knight or not targets:
+            return {}
+
+        attacker = self.selected_knight
+        attack_behavior = attacker.behaviors.get('attack')
+        if attack_behavior is None:
+            return {}
+        target_tiles = set(targets)
+        pairs = []
+        for knight in self.knights:
+            if (knight.x, knight.y) in target_tiles and knight.player_id != attacker.player_id:
+                # Same distance AttackBehavior.execute uses to pick the combat mode
+                distance = max(abs(attacker.x - knight.x), abs(attacker.y - knight.y))
+                pairs.append((attacker, knight, attack_behavior.determine_combat_mode(attacker, knight, distance)))
+
+        outcomes = BatchCombatEvaluator(self._require_game_state()).evaluate(pairs)
+        return {
+            (target.x, target.y): (outcomes.damage[i], outcomes.counter_damage[i])
+            for i, (_, target, _) in enumerate(pairs)
+        }
+
     def _get_charge_targets(self):
         if not self.selected_knight or self.selected_knight.knight_class != KnightClass.CAVALRY:
             return []
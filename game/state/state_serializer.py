@@ -21,22 +21,21 @@ class StateSerializer:
         if hasattr(game_state, 'animation_coordinator'):
             game_state.animation_coordinator.clear_animations()
     
-    def serialize_game_state(self, game_state) -> Dict[str, Any]:
+    def serialize_game_state(self, game_state, battle=None) -> Dict[str, Any]:
         """
         Convert game state to serializable dictionary.
         
         Args:
             game_state: The GameState instance to serialize
+            battle: Optional IGameState to take the battle itself from, e.g. a
+                BattleSnapshot captured at save time; defaults to game_state
             
         Returns:
             Dictionary containing all serializable game state data
         """
-        return {
+        save_data = {
             # Basic game properties
-            'board_width': game_state.board_width,
-            'board_height': game_state.board_height,
             'tile_size': game_state.tile_size,
-            'current_player': game_state.current_player,
             'turn_number': game_state.turn_number,
             'vs_ai': game_state.vs_ai,
             'ai_difficulty': game_state.ai_player.difficulty if game_state.ai_player else None,
@@ -48,14 +47,30 @@ class StateSerializer:
             # Messages and history
             'messages': getattr(game_state, 'messages', []),
             'movement_history': getattr(game_state, 'movement_history', []),
+        }
+        save_data.update(self.serialize_battle(battle if battle is not None else game_state))
+        return save_data
+    
+    def serialize_battle(self, battle) -> Dict[str, Any]:
+        """
+        Serialize the board, units, castles, terrain and fog of any IGameState.
+        
+        Works on a live battle as well as on a BattleSnapshot or
+        SharedBattleState, so a save can be taken from a snapshot while the
+        live battle keeps changing.
+        """
+        return {
+            'board_width': battle.board_width,
+            'board_height': battle.board_height,
+            'current_player': battle.current_player,
             
             # Game entities
-            'knights': self._serialize_units(game_state.knights),
-            'castles': self._serialize_castles(game_state.castles),
+            'knights': self._serialize_units(battle.knights),
+            'castles': self._serialize_castles(battle.castles),
             
             # World state
-            'terrain_map': self._serialize_terrain_map(game_state.terrain_map),
-            'fog_of_war': self._serialize_fog_of_war(game_state.fog_of_war)
+            'terrain_map': self._serialize_terrain_map(battle.terrain_map),
+            'fog_of_war': self._serialize_fog_of_war(battle.fog_of_war)
         }
     
     def deserialize_game_state(self, save_data: Dict[str, Any], game_state) -> None:
@@ -129,17 +144,17 @@ class StateSerializer:
                 'y': unit.y,
                 'player_id': unit.player_id,
                 'has_moved': unit.has_moved,
-                'has_attacked': unit.has_attacked,
+                'has_acted': unit.has_acted,
                 'action_points': unit.action_points,
                 'max_action_points': unit.max_action_points,
                 'health': unit.health,
                 'max_health': unit.max_health,
                 'morale': unit.morale,
-                'max_morale': unit.max_morale,
+                'max_morale': unit.stats.stats.max_morale,
                 'cohesion': unit.cohesion,
                 'max_cohesion': unit.max_cohesion,
                 'is_routing': unit.is_routing,
-                'facing_direction': unit.facing.direction.value if hasattr(unit, 'facing') else 0,
+                'facing_direction': unit.facing.facing.value if hasattr(unit, 'facing') else 0,
                 'garrison_location': unit.garrison_location.center_x if unit.garrison_location else None,
                 'generals': []
             }
@@ -149,7 +164,7 @@ class StateSerializer:
                 for general in unit.generals.generals:
                     general_data = {
                         'name': general.name,
-                        'general_type': general.general_type.value,
+                        'title': general.title,
                         'level': general.level,
                         'experience': general.experience
                     }
@@ -240,13 +255,13 @@ class StateSerializer:
             # Restore unit properties
             unit.player_id = unit_data['player_id']
             unit.has_moved = unit_data['has_moved']
-            unit.has_attacked = unit_data['has_attacked']
+            unit.has_acted = unit_data['has_acted']
             unit.action_points = unit_data['action_points']
             unit.max_action_points = unit_data['max_action_points']
             unit.health = unit_data['health']
             unit.max_health = unit_data['max_health']
             unit.morale = unit_data['morale']
-            unit.max_morale = unit_data['max_morale']
+            unit.stats.stats.max_morale = unit_data['max_morale']
             if 'cohesion' not in unit_data or 'max_cohesion' not in unit_data:
                 raise ValueError("Serialized unit data missing cohesion values")
             unit.cohesion = unit_data['cohesion']
@@ -255,7 +270,7 @@ class StateSerializer:
             
             # Restore facing direction
             if hasattr(unit, 'facing') and 'facing_direction' in unit_data:
-                unit.facing.direction = FacingDirection(unit_data['facing_direction'])
+                unit.facing.facing = FacingDirection(unit_data['facing_direction'])
             
             # Restore generals
             if 'generals' in unit_data:
@@ -309,13 +324,14 @@ class StateSerializer:
         
         if terrain_data:
             game_state.terrain_map = TerrainMap(game_state.board_width, game_state.board_height)
-            for terrain_entry in terrain_data:
-                terrain_type = TerrainType(terrain_entry['type'])
-                game_state.terrain_map.set_terrain(
-                    terrain_entry['x'],
-                    terrain_entry['y'],
-                    terrain_type
-                )
+            with game_state.terrain_map.batch():
+                for terrain_entry in terrain_data:
+                    terrain_type = TerrainType(terrain_entry['type'])
+                    game_state.terrain_map.set_terrain(
+                        terrain_entry['x'],
+                        terrain_entry['y'],
+                        terrain_type
+                    )
         else:
             game_state.terrain_map = TerrainMap(game_state.board_width, game_state.board_height)
     
@@ -0,0 +1,357 @@
+"""Expected attack outcomes for many attacker/target pairs in one call."""
+import math
+from array import array
+from typing import List, Optional, Sequence, Tuple
+
+from game.behaviors.combat import CombatMode
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE, CPathFinder
+from game.combat_config import CombatConfig
+from game.config import USE_C_EXTENSIONS
+from game.entities.knight import KnightClass
+from game.terrain import Terrain
+
+if C_EXTENSION_AVAILABLE:
+    import c_algorithms
+
+
+UNIT_WARRIOR = 0
+UNIT_ARCHER = 1
+UNIT_CAVALRY = 2
+UNIT_OTHER = 3
+
+_UNIT_KINDS = {
+    KnightClass.WARRIOR: UNIT_WARRIOR,
+    KnightClass.ARCHER: UNIT_ARCHER,
+    KnightClass.CAVALRY: UNIT_CAVALRY,
+}
+
+# Frontage narrowing used by StatsComponent.get_effective_soldiers
+FRONTAGE_FACTORS = {"Forest": 0.7, "Hills": 0.7, "Bridge": 0.5}
+
+# Mode codes shared with the C evaluator; None is the mode-less calculate_damage call
+COMBAT_MODE_CODES = {
+    None: 0,
+    CombatMode.RANGED: 1,
+    CombatMode.MELEE: 2,
+    CombatMode.SKIRMISH: 3,
+    CombatMode.CHARGE: 4,
+}
+
+# Arc modifiers (damage, morale, cohesion) of a target without facing
+NO_ARC = (1.0, 0.0, 0.0)
+
+
+class CombatOutcomes:
+    """Per-pair results of a batch, one array per quantity.
+
+    ``damage`` and ``counter_damage`` are what AttackBehavior.calculate_damage
+    and calculate_counter_damage return (the counter scaled by combat mode as
+    in AttackBehavior.execute). The deltas are the change in each unit's raw
+    morale and cohesion once CombatResolver has applied the casualties, facing
+    penalties and mode shock, before any routing check.
+    """
+
+    def __init__(self, damage, counter_damage, target_morale_delta, target_cohesion_delta,
+                 attacker_morale_delta, attacker_cohesion_delta):
+        self.damage = damage
+        self.counter_damage = counter_damage
+        self.target_morale_delta = target_morale_delta
+        self.target_cohesion_delta = target_cohesion_delta
+        self.attacker_morale_delta = attacker_morale_delta
+        self.attacker_cohesion_delta = attacker_cohesion_delta
+
+    def __len__(self) -> int:
+        return len(self.damage)
+
+    def __getitem__(self, index: int) -> Tuple[int, int, float, float, float, float]:
+        return (self.damage[index], self.counter_damage[index],
+                self.target_morale_delta[index], self.target_cohesion_delta[index],
+                self.attacker_morale_delta[index], self.attacker_cohesion_delta[index])
+
+
+class BatchCombatEvaluator:
+    """Evaluates attacks in bulk from flat unit snapshots.
+
+    Generals' bonuses, terrain frontage and combat modifiers are read once
+    per unit and terrain type rather than once per pair, facing modifiers come
+    from the attack arc table, and the pairs run
+    natively (GIL released) when the C extension is available. Build one per
+    game state: the terrain tables are captured at construction.
+    """
+
+    def __init__(self, game_state, use_native: Optional[bool] = None):
+        if game_state is None:
+            raise ValueError("game_state is required for batch combat evaluation")
+        if use_native is None:
+            use_native = USE_C_EXTENSIONS and C_EXTENSION_AVAILABLE
+        if use_native and not C_EXTENSION_AVAILABLE:
+            raise ValueError("Native combat evaluation requested but the C extension is not available")
+
+        self.use_native = use_native
+        self.width = game_state.board_width
+        self.height = game_state.board_height
+        if getattr(game_state, 'terrain_map', None) is not None:
+            self._grid, self._type_to_id, self._terrain_types = CPathFinder().get_terrain_grid(game_state)
+        else:
+            self._grid, self._type_to_id, self._terrain_types = [-1] * (self.width * self.height), {}, []
+
+        self._terrain_table = []
+        for terrain_type in self._terrain_types:
+            terrain = Terrain(terrain_type)
+            self._terrain_table.append((
+                float(terrain.defense_bonus),
+                FRONTAGE_FACTORS.get(terrain_type.value, 1.0),
+                1 if terrain_type.value.lower() == 'hills' else 0,
+                float(terrain.movement_cost),
+            ))
+        self._profile_index = {}
+        self._combat_profiles: List[dict] = []
+        self._rules = (
+            float(CombatConfig.COHESION_DAMAGE_MIN_FACTOR),
+            float(CombatConfig.MORALE_CASUALTY_SCALE),
+            float(CombatConfig.MORALE_CASUALTY_RATIO_SCALE),
+            float(CombatConfig.COHESION_CASUALTY_SCALE),
+            float(CombatConfig.COHESION_CASUALTY_RATIO_SCALE),
+            (float(CombatConfig.MORALE_SHOCK_RANGED), float(CombatConfig.MORALE_SHOCK_MELEE),
+             float(CombatConfig.MORALE_SHOCK_SKIRMISH), float(CombatConfig.MORALE_SHOCK_CHARGE)),
+            (float(CombatConfig.COHESION_SHOCK_RANGED), float(CombatConfig.COHESION_SHOCK_MELEE),
+             float(CombatConfig.COHESION_SHOCK_SKIRMISH), float(CombatConfig.COHESION_SHOCK_CHARGE)),
+        )
+
+    def snapshot(self, unit) -> Tuple:
+        """Flat combat stats for one unit, as the C evaluator reads them"""
+        if unit.max_cohesion <= 0:
+            raise ValueError("max_cohesion must be positive for damage calculation")
+        stats = unit.stats.stats
+        defense = stats.base_defense
+        morale_bonus = 0.0
+        if hasattr(unit, 'generals'):
+            bonuses = unit.generals.get_all_passive_bonuses(unit)
+            defense *= (1 + bonuses.get('defense_bonus', 0))
+            morale_bonus = bonuses.get('morale_bonus', 0)
+        attack_behavior = unit.behaviors.get('attack')
+        return (
+            unit.x,
+            unit.y,
+            _UNIT_KINDS.get(unit.unit_class, UNIT_OTHER),
+            self._profile_for(unit),
+            stats.current_soldiers,
+            float(stats.formation_width),
+            float(stats.attack_per_soldier),
+            float(unit.morale),
+            float(stats.morale),
+            float(morale_bonus),
+            float(unit.cohesion),
+            float(unit.max_cohesion),
+            1 if getattr(unit, 'is_disrupted', False) else 0,
+            float(unit.get_damage_modifier()) if hasattr(unit, 'get_damage_modifier') else 1.0,
+            float(defense),
+            float(stats.base_defense),
+            1 if getattr(unit, 'is_garrisoned', False) else 0,
+            1 if unit.is_routing else 0,
+            attack_behavior.attack_range if attack_behavior else 1,
+        )
+
+    @staticmethod
+    def arc_modifiers(attacker, target) -> Tuple[float, float, float]:
+        """Damage modifier, morale and cohesion penalty of attacking target from attacker's tile"""
+        facing = getattr(target, 'facing', None)
+        if facing is None:
+            return NO_ARC
+        arc = facing.get_attack_arc(attacker.x, attacker.y, target.x, target.y)
+        return (float(arc.damage_modifier), float(arc.morale_penalty), float(arc.cohesion_penalty))
+
+    def terrain_id(self, x: int, y: int) -> int:
+        if not (0 <= x < self.width and 0 <= y < self.height):
+            raise ValueError(f"Tile ({x}, {y}) is outside the {self.width}x{self.height} board")
+        return self._grid[y * self.width + x]
+
+    def evaluate(self, pairs: Sequence[Tuple]) -> CombatOutcomes:
+        """Outcomes for (attacker, target) or (attacker, target, combat_mode) pairs.
+
+        Units are snapshotted once however many pairs they appear in; the
+        facing modifiers of each pair come from the target's attack arc table.
+        """
+        snapshots = {}
+        attackers, targets, attacker_terrain, target_terrain, modes, arcs = [], [], [], [], [], []
+        for pair in pairs:
+            attacker, target = pair[0], pair[1]
+            mode = pair[2] if len(pair) > 2 else None
+            if mode not in COMBAT_MODE_CODES:
+                raise ValueError(f"Unsupported combat mode: {mode}")
+            for unit in (attacker, target):
+                if id(unit) not in snapshots:
+                    snapshots[id(unit)] = self.snapshot(unit)
+            attackers.append(snapshots[id(attacker)])
+            targets.append(snapshots[id(target)])
+            attacker_terrain.append(self.terrain_id(attacker.x, attacker.y))
+            target_terrain.append(self.terrain_id(target.x, target.y))
+            modes.append(COMBAT_MODE_CODES[mode])
+            arcs.append(self.arc_modifiers(attacker, target))
+        return self.evaluate_snapshots(attackers, targets, attacker_terrain, target_terrain, modes, arcs)
+
+    def evaluate_snapshots(self, attackers: Sequence[Tuple], targets: Sequence[Tuple],
+                           attacker_terrain: Sequence[int], target_terrain: Sequence[int],
+                           modes: Sequence[int], arcs: Sequence[Tuple[float, float, float]]) -> CombatOutcomes:
+        """Outcomes for parallel arrays of snapshots, terrain ids, mode codes and arc modifiers"""
+        args = (self._terrain_table, self._combat_profiles, self._rules,
+                attackers, targets, attacker_terrain, target_terrain, modes, arcs)
+        if self.use_native:
+            columns = []
+            for typecode, raw in zip('iidddd', c_algorithms.evaluate_combat_batch(*args)):
+                column = array(typecode)
+                column.frombytes(raw)
+                columns.append(column)
+            return CombatOutcomes(*columns)
+        return CombatOutcomes(*evaluate_combat_batch_python(*args))
+
+    def _profile_for(self, unit) -> int:
+        if unit.unit_class not in self._profile_index:
+            self._profile_index[unit.unit_class] = len(self._combat_profiles)
+            # Same call AttackBehavior makes when applying the terrain combat modifier
+            self._combat_profiles.append({
+                self._type_to_id[terrain_type]: float(Terrain(terrain_type).get_combat_modifier_for_unit(unit.unit_class))
+                for terrain_type in self._terrain_types
+            })
+        return self._profile_index[unit.unit_class]
+
+
+def _effective_soldiers(unit, terrain) -> int:
+    width = unit[5] * (terrain[1] if terrain else 1.0)
+    return min(int(width), unit[4])
+
+
+def _damage(terrain_table, combat_profiles, rules, attacker, target, attacker_tid, target_tid, mode, arc) -> int:
+    attacker_terrain = terrain_table[attacker_tid] if attacker_tid >= 0 else None
+    target_terrain = terrain_table[target_tid] if target_tid >= 0 else None
+    attacking_soldiers = _effective_soldiers(attacker, attacker_terrain)
+
+    base_damage = attacking_soldiers * attacker[6]
+    if mode == COMBAT_MODE_CODES[CombatMode.CHARGE]:
+        base_damage *= 1.3
+    elif mode == COMBAT_MODE_CODES[CombatMode.SKIRMISH]:
+        base_damage *= 0.8
+    if attacker_terrain:
+        base_damage *= combat_profiles[attacker[3]].get(attacker_tid, 1.0)
+    base_damage *= (attacker[7] / 100)
+    base_damage *= max(rules[0], attacker[10] / attacker[11])
+    if attacker[12]:
+        base_damage *= 0.5
+    base_damage *= attacker[13]
+
+    base_damage *= arc[0]
+
+    if attacker[18] > 1 and attacker_terrain and target_terrain:
+        if not attacker_terrain[2] and target_terrain[2]:
+            base_damage = int(base_damage * 0.5)
+        elif attacker_terrain[2] and not target_terrain[2]:
+            base_damage = int(base_damage * 1.5)
+
+    target_defense = target[14]
+    if target_terrain:
+        target_defense += target_terrain[0]
+    if target[12]:
+        target_defense *= 0.5
+    if target[16]:
+        target_defense += 20
+
+    total = base_damage + target_defense
+    damage_ratio = base_damage / total if total != 0 else 0.0
+    casualties = int(damage_ratio * attacking_soldiers * 0.25)
+
+    if attacker[2] == UNIT_CAVALRY and target[2] == UNIT_ARCHER:
+        casualties = int(casualties * 1.5)
+    elif attacker[2] == UNIT_ARCHER and target[2] == UNIT_WARRIOR:
+        casualties = int(casualties * 0.8)
+    return min(casualties, target[4])
+
+
+def _counter_damage(terrain_table, combat_profiles, rules, attacker, defender, attacker_tid, defender_tid, mode) -> int:
+    if mode == COMBAT_MODE_CODES[CombatMode.RANGED] or defender[2] == UNIT_ARCHER:
+        return 0
+    defender_terrain = terrain_table[defender_tid] if defender_tid >= 0 else None
+    attacker_terrain = terrain_table[attacker_tid] if attacker_tid >= 0 else None
+    defending_soldiers = _effective_soldiers(defender, defender_terrain)
+
+    base_damage = defender[6] * defending_soldiers
+    if defender_terrain:
+        base_damage *= combat_profiles[defender[3]].get(defender_tid, 1.0)
+    base_damage *= (defender[8] / 200)
+    base_damage *= max(rules[0], defender[10] / defender[11])
+
+    attacker_defense = attacker[15]
+    if attacker_terrain:
+        attacker_defense += attacker_terrain[0]
+
+    total = base_damage + attacker_defense
+    damage_ratio = base_damage / total if total != 0 else 0.0
+    casualties = int(damage_ratio * defending_soldiers * 0.15)
+    if defender[2] == UNIT_WARRIOR and attacker[2] == UNIT_CAVALRY:
+        casualties = int(casualties * 1.2)
+    casualties = min(casualties, attacker[4])
+
+    if mode == COMBAT_MODE_CODES[CombatMode.SKIRMISH]:
+        return int(casualties * 0.5)
+    if mode == COMBAT_MODE_CODES[CombatMode.CHARGE]:
+        return int(casualties * 0.75)
+    return casualties
+
+
+def _casualty_losses(rules, unit, damage) -> Tuple[float, float]:
+    morale, cohesion = unit[8], unit[10]
+    if damage <= 0 or unit[4] <= 0:
+        return morale, cohesion
+    amount = int(damage * 0.7) if unit[17] else damage
+    casualty_ratio = amount / unit[4]
+    morale_loss = rules[1] * (1 - math.exp(-casualty_ratio / rules[2]))
+    cohesion_loss = rules[3] * (1 - math.exp(-casualty_ratio / rules[4]))
+    return max(0, morale - morale_loss), max(0, cohesion - cohesion_loss)
+
+
+def evaluate_combat_batch_python(terrain_table: Sequence[Tuple], combat_profiles: Sequence[dict],
+                                 rules: Tuple, attackers: Sequence[Tuple], targets: Sequence[Tuple],
+                                 attacker_terrain: Sequence[int], target_terrain: Sequence[int],
+                                 modes: Sequence[int], arcs: Sequence[Tuple[float, float, float]]):
+    """Pure Python twin of c_algorithms.evaluate_combat_batch"""
+    count = len(attackers)
+    if not (len(targets) == len(attacker_terrain) == len(target_terrain) == len(modes) == len(arcs) == count):
+        raise ValueError("combat batch arrays must have the same length")
+    if rules[2] <= 0 or rules[4] <= 0:
+        raise ValueError("casualty ratio scales must be positive")
+    morale_shock = (0.0,) + tuple(rules[5])
+    cohesion_shock = (0.0,) + tuple(rules[6])
+
+    damage_out = array('i')
+    counter_out = array('i')
+    deltas = [array('d') for _ in range(4)]
+    for attacker, target, attacker_tid, target_tid, mode, arc in zip(attackers, targets, attacker_terrain,
+                                                                     target_terrain, modes, arcs):
+        if not 0 <= mode < len(morale_shock):
+            raise ValueError("unknown combat mode code")
+        for unit in (attacker, target):
+            if not 0 <= unit[3] < len(combat_profiles):
+                raise ValueError("combat snapshot references unknown combat profile")
+            if unit[11] <= 0:
+                raise ValueError("max_cohesion must be positive for damage calculation")
+        attacker_tid = attacker_tid if attacker_tid < 100 else -1
+        target_tid = target_tid if target_tid < 100 else -1
+
+        damage = _damage(terrain_table, combat_profiles, rules, attacker, target, attacker_tid, target_tid, mode, arc)
+        counter = _counter_damage(terrain_table, combat_profiles, rules, attacker, target, attacker_tid, target_tid, mode)
+
+        target_morale, target_cohesion = _casualty_losses(rules, target, damage)
+        extra_morale = morale_shock[mode] + arc[1]
+        extra_cohesion = cohesion_shock[mode] + arc[2]
+        if extra_morale > 0:
+            target_morale = max(0, min(100, target_morale + target[9]) - extra_morale)
+        if extra_cohesion > 0:
+            target_cohesion = max(0, target_cohesion - extra_cohesion)
+        attacker_morale, attacker_cohesion = _casualty_losses(rules, attacker, counter)
+
+        damage_out.append(damage)
+        counter_out.append(counter)
+        deltas[0].append(target_morale - target[8])
+        deltas[1].append(target_cohesion - target[10])
+        deltas[2].append(attacker_morale - attacker[8])
+        deltas[3].append(attacker_cohesion - attacker[10])
+    return (damage_out, counter_out, *deltas)
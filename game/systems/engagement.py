@@ -1,5 +1,11 @@
 """Centralized engagement and Zone of Control logic."""
-from typing import Optional, Tuple
+from typing import Dict, List, Optional, Set, Tuple
+
+from game.battle.domain.events import AttackResolved, ChargeResolved, UnitMoved
+from game.entities.unit_table import FLAG_ENGAGED, FLAG_ROUTING, UnitTable
+
+# Tiles around a unit that its zone of control covers
+ZOC_OFFSETS = ((0, 1), (0, -1), (1, 0), (-1, 0), (1, 1), (1, -1), (-1, 1), (-1, -1))
 
 
 class EngagementSystem:
@@ -63,20 +69,168 @@ class EngagementSystem:
     def update_zoc_and_engagement(cls, game_state) -> None:
         """Update ZOC and engagement flags for all units."""
         cls._validate_game_state(game_state)
+        EngagementTracker().update(game_state)
+
+    @classmethod
+    def update_unit(cls, unit, enemy, live_ids: Set[int]) -> None:
+        """Apply a unit's ZOC enemy (or None) and drop an engagement that has ended"""
+        unit.in_enemy_zoc = enemy is not None
+        unit.zoc_enemy = enemy
+
+        if unit.is_engaged_in_combat:
+            if unit.engaged_with is None:
+                cls._clear_engagement(unit)
+                return
+            if id(unit.engaged_with) not in live_ids:
+                cls._clear_engagement(unit, unit.engaged_with)
+                return
+            if not cls._are_adjacent(unit, unit.engaged_with):
+                cls._clear_engagement(unit, unit.engaged_with)
+        elif unit.engaged_with is not None:
+            unit.engaged_with = None
+
+
+# Row fields whose change can alter a unit's ZOC, its ZOC over others or its engagement
+_ROUTING_AND_ENGAGED = FLAG_ROUTING | FLAG_ENGAGED
+
+
+def _signature(x, y, player, soldiers, morale, cohesion, flags) -> tuple:
+    return (x, y, player, soldiers, morale, cohesion, flags & _ROUTING_AND_ENGAGED)
+
+
+class EngagementTracker:
+    """Incremental ZOC and engagement state for one battle.
+
+    Keeps a tile index of live units and whether each one exerts ZOC. An
+    update only re-evaluates units touched since the last one and the units
+    on tiles around them. Units are touched by the battle events published
+    to the tracker, and by any change to their position, player, strength,
+    morale, cohesion, routing or engagement columns in the unit table,
+    which also catches effects applied later (attack animations, end of
+    turn). A change in the set of live units rebuilds everything.
+
+    ZOC inputs outside the unit table, such as a unit's generals, are not
+    watched; call invalidate() after changing them.
+    """
 
+    def __init__(self):
+        self._live: Set[int] = set()
+        self._order: Dict[int, int] = {}
+        self._tiles: Dict[Tuple[int, int], List] = {}
+        self._positions: Dict[int, Tuple[int, int]] = {}
+        self._signatures: Dict[int, tuple] = {}
+        self._zoc_sources: Set[int] = set()
+        self._touched: Set[int] = set()
+        self._stale = True
+
+    def invalidate(self) -> None:
+        """Re-evaluate every unit on the next update"""
+        self._stale = True
+
+    def publish(self, event) -> None:
+        """EventSink hook: mark the units an event moved or fought as touched"""
+        if isinstance(event, UnitMoved):
+            self._touched.add(event.unit_id)
+        elif isinstance(event, (AttackResolved, ChargeResolved)):
+            self._touched.add(event.attacker_id)
+            self._touched.add(event.target_id)
+        else:
+            raise ValueError(f"Unsupported event type: {type(event).__name__}")
+
+    def update(self, game_state) -> None:
+        """Bring in_enemy_zoc, zoc_enemy and engagement up to date"""
+        EngagementSystem._validate_game_state(game_state)
+        table = UnitTable.of(game_state)
+        if self._stale or not self._same_units(table):
+            self._rebuild(game_state, table)
+            return
+
+        touched = self._touched
+        self._touched = set()
+        signatures = self._signatures
+        moved = []
+        for unit, x, y, player, soldiers, morale, cohesion, flags in zip(
+                table.units, table.x, table.y, table.player, table.soldiers,
+                table.morale, table.cohesion, table.flags):
+            signature = _signature(x, y, player, soldiers, morale, cohesion, flags)
+            if signatures[id(unit)] != signature or id(unit) in touched:
+                signatures[id(unit)] = signature
+                moved.append(unit)
+        if not moved:
+            return
+
+        affected = {}
+        for unit in moved:
+            key = id(unit)
+            old_x, old_y = self._positions[key]
+            self._tiles[(old_x, old_y)].remove(unit)
+            self._positions[key] = (unit.x, unit.y)
+            self._tiles.setdefault((unit.x, unit.y), []).append(unit)
+            if unit.has_zone_of_control():
+                self._zoc_sources.add(key)
+            else:
+                self._zoc_sources.discard(key)
+            affected[key] = unit
+            for x, y in ((old_x, old_y), (unit.x, unit.y)):
+                for other in self._units_around(x, y):
+                    affected[id(other)] = other
+        # Units engaged with a touched unit may have lost contact with it
+        moved_ids = {id(unit) for unit in moved}
+        for unit, flags in zip(table.units, table.flags):
+            if flags & FLAG_ENGAGED and id(unit.engaged_with) in moved_ids:
+                affected[id(unit)] = unit
+
+        for unit in sorted(affected.values(), key=lambda u: self._order[id(u)]):
+            self._apply(unit)
+
+    def _same_units(self, table) -> bool:
+        return len(table) == len(self._live) and all(id(unit) in self._live for unit in table.units)
+
+    def _rebuild(self, game_state, table) -> None:
+        self._stale = False
+        self._touched = set()
+        self._live = {id(unit) for unit in table.units}
+        self._order = {id(unit): index for index, unit in enumerate(game_state.knights)}
+        self._tiles = {}
+        self._positions = {}
+        self._zoc_sources = set()
+        self._signatures = {}
+        for unit in table.units:
+            key = id(unit)
+            self._positions[key] = (unit.x, unit.y)
+            self._tiles.setdefault((unit.x, unit.y), []).append(unit)
+            if unit.has_zone_of_control():
+                self._zoc_sources.add(key)
         for unit in game_state.knights:
-            in_zoc, enemy = cls.is_unit_in_enemy_zoc(unit, game_state)
-            unit.in_enemy_zoc = in_zoc
-            unit.zoc_enemy = enemy if in_zoc else None
-
-            if unit.is_engaged_in_combat:
-                if unit.engaged_with is None:
-                    cls._clear_engagement(unit)
-                    continue
-                if unit.engaged_with not in game_state.knights:
-                    cls._clear_engagement(unit, unit.engaged_with)
-                    continue
-                if not cls._are_adjacent(unit, unit.engaged_with):
-                    cls._clear_engagement(unit, unit.engaged_with)
-            elif unit.engaged_with is not None:
-                unit.engaged_with = None
+            self._apply(unit)
+        self._signatures = {id(unit): self._row_signature(unit) for unit in table.units}
+
+    def _units_around(self, x: int, y: int):
+        tiles = self._tiles
+        for dx, dy in ZOC_OFFSETS:
+            yield from tiles.get((x + dx, y + dy), ())
+        yield from tiles.get((x, y), ())
+
+    def _zoc_enemy(self, unit):
+        """The first enemy in knights order whose ZOC covers the unit's tile"""
+        best = None
+        tiles = self._tiles
+        for dx, dy in ZOC_OFFSETS:
+            for other in tiles.get((unit.x + dx, unit.y + dy), ()):
+                if (other.player_id != unit.player_id and id(other) in self._zoc_sources
+                        and (best is None or self._order[id(other)] < self._order[id(best)])):
+                    best = other
+        return best
+
+    def _apply(self, unit) -> None:
+        partner = unit.engaged_with
+        EngagementSystem.update_unit(unit, self._zoc_enemy(unit), self._live)
+        # Clearing an engagement rewrites flags the signatures watch
+        for changed in (unit, partner):
+            if changed is not None and id(changed) in self._signatures:
+                self._signatures[id(changed)] = self._row_signature(changed)
+
+    @staticmethod
+    def _row_signature(unit) -> tuple:
+        values = unit._row.values()
+        return _signature(*values[:6], values[8])
@@ -0,0 +1,233 @@
+"""Flee fields: how far each tile is from one side's enemies, for routing units."""
+import heapq
+import math
+from array import array
+from collections import OrderedDict
+from typing import Dict, List, Optional, Sequence, Tuple
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE, CPathFinder
+from game.config import USE_C_EXTENSIONS
+from game.entities.unit_table import NO_PLAYER, UnitTable
+from game.systems.threat_map import _EVEN_ROW_DIRS, _ODD_ROW_DIRS
+
+if C_EXTENSION_AVAILABLE:
+    import c_algorithms
+
+
+class FleeField:
+    """Lowest movement cost any enemy of ``player_id`` pays to reach each tile.
+
+    Built by one multi-source Dijkstra per enemy movement profile, seeded from
+    every enemy at once. Enemies move with their own terrain costs; castles
+    block them, units do not. A routing unit flees by stepping to the
+    neighbouring hex with the highest cost, so choosing a retreat is a lookup
+    of six tiles instead of a search.
+    """
+
+    def __init__(self, width: int, height: int, costs, terrain=None):
+        self.width = width
+        self.height = height
+        self._costs = costs
+        # (grid, type_to_id, terrain_types) the field was built on
+        self._terrain = terrain
+        # Terrain movement costs per unit class, for flee_steps
+        self._unit_costs: Dict[object, Dict[int, float]] = {}
+
+    def cost(self, x: int, y: int) -> float:
+        if not (0 <= x < self.width and 0 <= y < self.height):
+            raise ValueError(f"Tile ({x}, {y}) is outside the {self.width}x{self.height} flee field")
+        return self._costs[y * self.width + x]
+
+    def neighbours(self, x: int, y: int) -> List[Tuple[int, int]]:
+        """On-board hex neighbours of a tile, in the pathfinders' direction order"""
+        tiles = []
+        for dx, dy in (_EVEN_ROW_DIRS if y % 2 == 0 else _ODD_ROW_DIRS):
+            nx, ny = x + dx, y + dy
+            if 0 <= nx < self.width and 0 <= ny < self.height:
+                tiles.append((nx, ny))
+        return tiles
+
+    def flee_steps(self, x: int, y: int, unit=None) -> List[Tuple[int, int]]:
+        """Neighbouring tiles farther from the enemies, farthest first.
+
+        With unit, tiles whose terrain the unit cannot enter are left out.
+        """
+        current = self.cost(x, y)
+        steps = [tile for tile in self.neighbours(x, y) if self.cost(*tile) > current]
+        if unit is not None and self._terrain is not None:
+            grid, type_to_id, terrain_types = self._terrain
+            unit_costs = self._unit_costs.get(unit.unit_class)
+            if unit_costs is None:
+                unit_costs = CPathFinder.build_cost_map(unit, type_to_id, terrain_types)
+                self._unit_costs[unit.unit_class] = unit_costs
+            steps = [(sx, sy) for sx, sy in steps
+                     if not math.isinf(unit_costs.get(grid[sy * self.width + sx], 1.0))]
+        steps.sort(key=lambda tile: self.cost(*tile), reverse=True)
+        return steps
+
+    @classmethod
+    def for_player(cls, game_state, player_id: Optional[int]) -> 'FleeField':
+        """The flee field for player_id's units, from the game state's cache when it has one"""
+        cache = getattr(game_state, 'flee_fields', None)
+        if cache is not None:
+            return cache.get(game_state, player_id)
+        return cls.build(game_state, player_id)
+
+    @classmethod
+    def build(cls, game_state, player_id: Optional[int], use_native: Optional[bool] = None) -> 'FleeField':
+        if game_state is None:
+            raise ValueError("game_state is required to build a flee field")
+        if use_native is None:
+            use_native = USE_C_EXTENSIONS and C_EXTENSION_AVAILABLE
+        if use_native and not C_EXTENSION_AVAILABLE:
+            raise ValueError("Native flee field requested but the C extension is not available")
+
+        width = game_state.board_width
+        height = game_state.board_height
+        terrain, cost_profiles, sources, blockers = _collect_inputs(game_state, player_id)
+        grid = terrain[0]
+
+        if use_native:
+            costs = array('d')
+            costs.frombytes(c_algorithms.compute_flee_field(
+                width, height, grid, cost_profiles, sources, blockers
+            ))
+            return cls(width, height, costs, terrain)
+        return cls(width, height, compute_flee_field_python(
+            width, height, grid, cost_profiles, sources, blockers
+        ), terrain)
+
+
+class FleeFieldCache:
+    """Flee fields keyed by side, enemy units and terrain, least recently used dropped first.
+
+    Enemies of the side that is moving hold still during its turn, so in
+    practice each side's field is built once per turn however many of its
+    units rout. AI search states share their battle's cache, so sibling
+    branches with the same enemy placement reuse one field.
+    """
+
+    MAX_FIELDS = 32
+
+    def __init__(self):
+        self._fields: 'OrderedDict[tuple, FleeField]' = OrderedDict()
+
+    def get(self, game_state, player_id: Optional[int]) -> FleeField:
+        key = (player_id, _field_key(game_state, player_id))
+        field = self._fields.get(key)
+        if field is not None:
+            self._fields.move_to_end(key)
+            return field
+        field = FleeField.build(game_state, player_id)
+        self._fields[key] = field
+        if len(self._fields) > self.MAX_FIELDS:
+            self._fields.popitem(last=False)
+        return field
+
+    def clear(self) -> None:
+        self._fields.clear()
+
+
+_pathfinder = CPathFinder()
+
+
+def _field_key(game_state, player_id: Optional[int]) -> tuple:
+    units = UnitTable.of(game_state)
+    own = NO_PLAYER if player_id is None else player_id
+    enemies = tuple(
+        (x, y, unit.unit_class)
+        for unit, x, y, player in zip(units.units, units.x, units.y, units.player)
+        if player != own
+    )
+    terrain_map = getattr(game_state, 'terrain_map', None)
+    castles = tuple(
+        tile for castle in getattr(game_state, 'castles', None) or [] for tile in castle.occupied_tiles
+    )
+    return (game_state.board_width, game_state.board_height, id(terrain_map),
+            getattr(terrain_map, 'revision', None), castles, enemies)
+
+
+def _collect_inputs(game_state, player_id: Optional[int]):
+    width = game_state.board_width
+    height = game_state.board_height
+
+    terrain_map = getattr(game_state, 'terrain_map', None)
+    if terrain_map is not None:
+        grid, type_to_id, terrain_types = _pathfinder.get_terrain_grid(game_state)
+    else:
+        grid, type_to_id, terrain_types = [-1] * (width * height), {}, []
+
+    cost_profiles: List[Dict[int, float]] = []
+    profile_index = {}
+    sources = []
+    for unit in game_state.knights:
+        if unit.player_id == player_id:
+            continue
+        if unit.unit_class not in profile_index:
+            profile_index[unit.unit_class] = len(cost_profiles)
+            cost_profiles.append(CPathFinder.build_cost_map(unit, type_to_id, terrain_types))
+        sources.append((unit.x, unit.y, profile_index[unit.unit_class]))
+
+    blockers = []
+    for castle in getattr(game_state, 'castles', None) or []:
+        blockers.extend(castle.occupied_tiles)
+
+    return (grid, type_to_id, terrain_types), cost_profiles, sources, blockers
+
+
+def compute_flee_field_python(width: int, height: int, grid: Sequence[int],
+                              cost_profiles: Sequence[Dict[int, float]],
+                              sources: Sequence[Tuple[int, int, int]],
+                              blockers: Sequence[Tuple[int, int]]):
+    """Pure Python twin of c_algorithms.compute_flee_field"""
+    map_size = width * height
+    blocked = bytearray(map_size)
+    for bx, by in blockers:
+        if 0 <= bx < width and 0 <= by < height:
+            blocked[by * width + bx] = 1
+
+    field = array('d', [math.inf]) * map_size
+    seeds_by_profile: Dict[int, List[int]] = {}
+    for sx, sy, profile in sources:
+        if not (0 <= profile < len(cost_profiles)):
+            raise ValueError("flee source references unknown cost profile")
+        if 0 <= sx < width and 0 <= sy < height:
+            seeds_by_profile.setdefault(profile, []).append(sy * width + sx)
+
+    for profile, seeds in seeds_by_profile.items():
+        min_costs = _multi_source_dijkstra(width, height, grid, blocked, cost_profiles[profile], seeds)
+        for idx, cost in min_costs.items():
+            if cost < field[idx]:
+                field[idx] = cost
+    return field
+
+
+def _multi_source_dijkstra(width, height, grid, blocked, costs, seeds) -> Dict[int, float]:
+    min_costs = {idx: 0.0 for idx in seeds}
+    closed = set()
+    queue = [(0.0, idx % width, idx // width) for idx in min_costs]
+    heapq.heapify(queue)
+    while queue:
+        cost, cx, cy = heapq.heappop(queue)
+        c_idx = cy * width + cx
+        if cost > min_costs[c_idx] or c_idx in closed:
+            continue
+        closed.add(c_idx)
+
+        for dx, dy in (_EVEN_ROW_DIRS if cy % 2 == 0 else _ODD_ROW_DIRS):
+            nx, ny = cx + dx, cy + dy
+            if not (0 <= nx < width and 0 <= ny < height):
+                continue
+            n_idx = ny * width + nx
+            if n_idx in closed or blocked[n_idx]:
+                continue
+            move_cost = costs.get(grid[n_idx], 1.0) if 0 <= grid[n_idx] < 100 else 1.0
+            if move_cost < 1.0:
+                move_cost = 1.0
+            if math.isinf(move_cost):
+                continue
+            new_cost = cost + move_cost
+            if new_cost < min_costs.get(n_idx, math.inf):
+                min_costs[n_idx] = new_cost
+                heapq.heappush(queue, (new_cost, nx, ny))
+    return min_costs
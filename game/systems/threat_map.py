@@ -0,0 +1,238 @@
+"""Threat and influence maps computed by one multi-source reachability pass."""
+import heapq
+import math
+from array import array
+from typing import Dict, List, Optional, Sequence, Tuple
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE, CPathFinder
+from game.combat_config import CombatConfig
+from game.config import USE_C_EXTENSIONS
+from game.hex_utils import HexGrid
+from game.visibility import VisibilityState
+
+if C_EXTENSION_AVAILABLE:
+    import c_algorithms
+
+
+# Same row-parity neighbour offsets as the C pathfinder (odd-r layout)
+_EVEN_ROW_DIRS = ((-1, -1), (0, -1), (1, 0), (0, 1), (-1, 1), (-1, 0))
+_ODD_ROW_DIRS = ((0, -1), (1, -1), (1, 0), (1, 1), (0, 1), (-1, 0))
+
+
+class ThreatMap:
+    """Per-tile danger from one side's units, queried in O(1).
+
+    Built from every unit not belonging to ``player_id`` in a single pass:
+
+    - ``earliest_turn``: turns a threatening unit needs to reach the tile
+      (0 = standing on it, ``UNREACHABLE`` = not within ``max_turns``)
+    - ``threat_cost``: lowest movement cost any threatening unit pays to get there
+    - ``attack_potential``: summed attack strength of units that can move and
+      attack the tile with next turn's action points
+    - ``archer_coverage``: number of ranged units able to shoot the tile next turn
+
+    Movement follows terrain costs per unit class; castles and (unless
+    ``block_units`` is False) ``player_id``'s units block movement but can still
+    be attacked. ZOC is ignored.
+    """
+
+    UNREACHABLE = 255
+    MAX_TURNS = UNREACHABLE - 1
+    DEFAULT_MAX_TURNS = 3
+
+    def __init__(self, width: int, height: int, earliest_turn, threat_cost, attack_potential, archer_coverage):
+        self.width = width
+        self.height = height
+        self._earliest_turn = earliest_turn
+        self._threat_cost = threat_cost
+        self._attack_potential = attack_potential
+        self._archer_coverage = archer_coverage
+
+    def _index(self, x: int, y: int) -> int:
+        if not (0 <= x < self.width and 0 <= y < self.height):
+            raise ValueError(f"Tile ({x}, {y}) is outside the {self.width}x{self.height} threat map")
+        return y * self.width + x
+
+    def earliest_turn(self, x: int, y: int) -> int:
+        return self._earliest_turn[self._index(x, y)]
+
+    def threat_cost(self, x: int, y: int) -> float:
+        return self._threat_cost[self._index(x, y)]
+
+    def attack_potential(self, x: int, y: int) -> float:
+        return self._attack_potential[self._index(x, y)]
+
+    def archer_coverage(self, x: int, y: int) -> int:
+        return self._archer_coverage[self._index(x, y)]
+
+    @classmethod
+    def build(cls, game_state, player_id: int, fog_of_war=None,
+              max_turns: int = DEFAULT_MAX_TURNS, block_units: bool = True,
+              use_native: Optional[bool] = None) -> 'ThreatMap':
+        """Threat map of all units hostile to player_id.
+
+        With fog_of_war, only enemies visible (or partially visible) to player_id count.
+        """
+        if game_state is None:
+            raise ValueError("game_state is required to build a threat map")
+        if use_native is None:
+            use_native = USE_C_EXTENSIONS and C_EXTENSION_AVAILABLE
+        if use_native and not C_EXTENSION_AVAILABLE:
+            raise ValueError("Native threat map requested but the C extension is not available")
+
+        width = game_state.board_width
+        height = game_state.board_height
+        grid, cost_profiles, sources, blockers = _collect_inputs(game_state, player_id, fog_of_war, block_units)
+
+        if use_native:
+            earliest, costs, potential, coverage = c_algorithms.compute_threat_map(
+                width, height, grid, cost_profiles, sources, blockers, max_turns
+            )
+            threat_cost = array('d')
+            threat_cost.frombytes(costs)
+            attack_potential = array('d')
+            attack_potential.frombytes(potential)
+            return cls(width, height, earliest, threat_cost, attack_potential, coverage)
+
+        return cls(width, height, *compute_threat_map_python(
+            width, height, grid, cost_profiles, sources, blockers, max_turns
+        ))
+
+
+_pathfinder = CPathFinder()
+
+
+def _collect_inputs(game_state, player_id: int, fog_of_war, block_units: bool):
+    width = game_state.board_width
+    height = game_state.board_height
+
+    terrain_map = getattr(game_state, 'terrain_map', None)
+    if terrain_map is not None:
+        grid, type_to_id, terrain_types = _pathfinder.get_terrain_grid(game_state)
+    else:
+        grid, type_to_id, terrain_types = [-1] * (width * height), {}, []
+
+    cost_profiles: List[Dict[int, float]] = []
+    profile_index = {}
+    sources = []
+    blockers = []
+    for unit in game_state.knights:
+        if unit.player_id == player_id:
+            if block_units:
+                blockers.append((unit.x, unit.y))
+            continue
+        if fog_of_war:
+            visibility = fog_of_war.get_visibility_state(player_id, unit.x, unit.y)
+            if visibility not in [VisibilityState.VISIBLE, VisibilityState.PARTIAL]:
+                continue
+
+        if unit.unit_class not in profile_index:
+            profile_index[unit.unit_class] = len(cost_profiles)
+            cost_profiles.append(CPathFinder.build_cost_map(unit, type_to_id, terrain_types))
+
+        attack_range = 0
+        attack_potential = 0.0
+        if 'attack' in unit.behaviors and not unit.is_routing:
+            attack_range = unit.behaviors['attack'].attack_range
+            attack_potential = float(unit.soldiers * unit.stats.stats.attack_per_soldier)
+
+        sources.append((
+            unit.x,
+            unit.y,
+            profile_index[unit.unit_class],
+            float(unit.max_action_points),
+            float(CombatConfig.get_attack_ap_cost(unit.unit_class.value)),
+            attack_range,
+            attack_potential,
+        ))
+
+    for castle in getattr(game_state, 'castles', None) or []:
+        blockers.extend(castle.occupied_tiles)
+
+    return grid, cost_profiles, sources, blockers
+
+
+def compute_threat_map_python(width: int, height: int, grid: Sequence[int],
+                              cost_profiles: Sequence[Dict[int, float]],
+                              sources: Sequence[Tuple], blockers: Sequence[Tuple[int, int]],
+                              max_turns: int):
+    """Pure Python twin of c_algorithms.compute_threat_map"""
+    if not (0 <= max_turns <= ThreatMap.MAX_TURNS):
+        raise ValueError("max_turns must be between 0 and 254")
+
+    map_size = width * height
+    blocked = bytearray(map_size)
+    for bx, by in blockers:
+        if 0 <= bx < width and 0 <= by < height:
+            blocked[by * width + bx] = 1
+
+    earliest = bytearray([ThreatMap.UNREACHABLE]) * map_size
+    threat_cost = array('d', [math.inf]) * map_size
+    potential = array('d', [0.0]) * map_size
+    coverage = bytearray(map_size)
+    hex_grid = HexGrid()
+
+    for sx, sy, profile, action_points, attack_cost, attack_range, attack_potential in sources:
+        if not (0 <= sx < width and 0 <= sy < height):
+            continue
+        costs = cost_profiles[profile]
+        budget = action_points * max_turns if action_points > 0 else 0.0
+        min_costs = _bounded_dijkstra(width, height, grid, blocked, costs, sx, sy, budget)
+
+        attack_budget = action_points - attack_cost
+        can_attack = attack_range > 0 and attack_potential > 0 and attack_budget >= 0
+        attacked = set()
+
+        for idx, cost in min_costs.items():
+            turn = 0 if cost <= 0.0 else math.ceil(cost / action_points - 1e-9)
+            if turn < earliest[idx]:
+                earliest[idx] = turn
+            if cost < threat_cost[idx]:
+                threat_cost[idx] = cost
+
+            if not can_attack or cost > attack_budget:
+                continue
+            from_hex = hex_grid.offset_to_axial(idx % width, idx // width)
+            for target_hex in from_hex.get_neighbors_within_range(attack_range):
+                tx, ty = hex_grid.axial_to_offset(target_hex)
+                if 0 <= tx < width and 0 <= ty < height:
+                    attacked.add(ty * width + tx)
+
+        for t_idx in attacked:
+            potential[t_idx] += attack_potential
+            if attack_range > 1 and coverage[t_idx] < 255:
+                coverage[t_idx] += 1
+
+    return bytes(earliest), threat_cost, potential, bytes(coverage)
+
+
+def _bounded_dijkstra(width, height, grid, blocked, costs, sx, sy, budget) -> Dict[int, float]:
+    min_costs = {sy * width + sx: 0.0}
+    closed = set()
+    queue = [(0.0, sx, sy)]
+    while queue:
+        cost, cx, cy = heapq.heappop(queue)
+        c_idx = cy * width + cx
+        if cost > min_costs[c_idx] or c_idx in closed:
+            continue
+        closed.add(c_idx)
+
+        for dx, dy in (_EVEN_ROW_DIRS if cy % 2 == 0 else _ODD_ROW_DIRS):
+            nx, ny = cx + dx, cy + dy
+            if not (0 <= nx < width and 0 <= ny < height):
+                continue
+            n_idx = ny * width + nx
+            if n_idx in closed or blocked[n_idx]:
+                continue
+            move_cost = costs.get(grid[n_idx], 1.0) if 0 <= grid[n_idx] < 100 else 1.0
+            if move_cost < 1.0:
+                move_cost = 1.0
+            if math.isinf(move_cost):
+                continue
+            new_cost = cost + move_cost
+            if new_cost > budget:
+                continue
+            if new_cost < min_costs.get(n_idx, math.inf):
+                min_costs[n_idx] = new_cost
+                heapq.heappush(queue, (new_cost, nx, ny))
+    return min_costs
@@ -1,10 +1,21 @@
 """Enhanced terrain system with layers and realistic generation"""
 from enum import Enum
 from dataclasses import dataclass
-from typing import List, Dict, Optional, Set, Tuple
+from array import array
+from contextlib import contextmanager
+from typing import List, Dict, NamedTuple, Optional, Set, Tuple
 import random
+import heapq
 import math
 
+from game.config import USE_C_EXTENSIONS
+
+try:
+    import c_algorithms
+    C_NOISE_AVAILABLE = True
+except ImportError:
+    C_NOISE_AVAILABLE = False
+
 
 class TerrainType(Enum):
     """Base terrain types"""
@@ -101,9 +112,21 @@ TERRAIN_PROPERTIES = {
 }
 
 
+# Ids stored in TerrainMap planes; type ids match the C pathfinder's terrain ids
+TERRAIN_TYPES = tuple(TerrainType)
+TERRAIN_FEATURES = tuple(TerrainFeature)
+TERRAIN_TYPE_IDS = {terrain_type: index for index, terrain_type in enumerate(TERRAIN_TYPES)}
+TERRAIN_FEATURE_IDS = {feature: index for index, feature in enumerate(TERRAIN_FEATURES)}
+
+
 class Terrain:
-    """Represents a single terrain tile with base terrain and optional features"""
-    
+    """Represents a single terrain tile with base terrain and optional features.
+
+    Immutable: a TerrainMap hands out one shared instance per (type, feature)
+    pair, so change a tile with set_terrain or by assigning a new Terrain.
+    """
+    __slots__ = ('_type', '_feature', '_properties')
+
     def __init__(self, terrain_type: TerrainType, feature: TerrainFeature = TerrainFeature.NONE):
         if terrain_type is None:
             raise ValueError("terrain_type is required")
@@ -117,10 +140,26 @@ class Terrain:
         if terrain_type in {TerrainType.BRIDGE, TerrainType.ROAD} and feature != TerrainFeature.NONE:
             raise ValueError("Bridge/Road terrain cannot combine with features")
 
-        self.type = terrain_type
-        self.feature = feature
+        self._type = terrain_type
+        self._feature = feature
             
-        self._properties = TERRAIN_PROPERTIES[self.type]
+        self._properties = TERRAIN_PROPERTIES[terrain_type]
+
+    @classmethod
+    def of(cls, terrain_type: TerrainType, feature: TerrainFeature = TerrainFeature.NONE) -> 'Terrain':
+        """The shared instance for a type and feature"""
+        return _flyweight(TERRAIN_TYPE_IDS[terrain_type], TERRAIN_FEATURE_IDS[feature])
+
+    @property
+    def type(self) -> TerrainType:
+        return self._type
+
+    @property
+    def feature(self) -> TerrainFeature:
+        return self._feature
+
+    def __repr__(self) -> str:
+        return f"Terrain({self._type}, {self._feature})"
         
     @property
     def movement_cost(self) -> float:
@@ -202,6 +241,47 @@ class Terrain:
         return 1.0
 
 
+# Shared Terrain per (type id, feature id), created on first use
+_FLYWEIGHTS: List[Optional[Terrain]] = [None] * (len(TERRAIN_TYPES) * len(TERRAIN_FEATURES))
+
+
+def _flyweight(type_id: int, feature_id: int) -> Terrain:
+    code = type_id * len(TERRAIN_FEATURES) + feature_id
+    terrain = _FLYWEIGHTS[code]
+    if terrain is None:
+        terrain = Terrain(TERRAIN_TYPES[type_id], TERRAIN_FEATURES[feature_id])
+        _FLYWEIGHTS[code] = terrain
+    return terrain
+
+
+# Road builder cost per class: open ground, forest, water to bridge, impassable
+_ROAD_COSTS = {0: 1.0, 1: 3.0, 2: 5.0, 3: math.inf}
+_ROAD_CLASSES: Optional[bytes] = None
+
+# Hex neighbour offsets (odd-r), in the native pathfinder's order
+_ROAD_EVEN_ROW_DIRS = ((-1, -1), (0, -1), (1, 0), (0, 1), (-1, 1), (-1, 0))
+_ROAD_ODD_ROW_DIRS = ((0, -1), (1, -1), (1, 0), (1, 1), (0, 1), (-1, 0))
+
+
+def _road_classes() -> bytes:
+    """Road cost class per (type id * feature count + feature id)"""
+    global _ROAD_CLASSES
+    if _ROAD_CLASSES is None:
+        classes = bytearray([3]) * len(_FLYWEIGHTS)
+        for code in _VALID_CODES:
+            terrain = _flyweight(*divmod(code, len(TERRAIN_FEATURES)))
+            if not terrain.passable and terrain.type != TerrainType.WATER:
+                continue
+            if terrain.type in (TerrainType.FOREST, TerrainType.DENSE_FOREST):
+                classes[code] = 1  # Prefer to avoid forests
+            elif terrain.type == TerrainType.WATER:
+                classes[code] = 2  # Expensive to bridge
+            else:
+                classes[code] = 0
+        _ROAD_CLASSES = bytes(classes)
+    return _ROAD_CLASSES
+
+
 class TerrainGenerator:
     """Generates realistic terrain using various algorithms"""
     
@@ -256,14 +336,45 @@ class TerrainGenerator:
         
         return self._interpolate(nx0, nx1, sy)
         
-    def generate_height_map(self, scale: float = 0.1, octaves: int = 4) -> List[List[float]]:
+    def generate_height_map(self, scale: float = 0.1, octaves: int = 4,
+                            use_native: Optional[bool] = None) -> List[List[float]]:
         """Generate height map using Perlin noise"""
-        height_map = []
+        # Use multiple octaves for more realistic terrain
+        return self._noise_map(scale, octaves, 0, use_native)
+        
+    def generate_moisture_map(self, scale: float = 0.15, use_native: Optional[bool] = None) -> List[List[float]]:
+        """Generate moisture map for vegetation distribution"""
+        offset = 10000  # Different offset for different noise
+        return self._noise_map(scale, 1, offset, use_native)
+
+    def _noise_map(self, scale: float, octaves: int, seed_offset: int,
+                   use_native: Optional[bool]) -> List[List[float]]:
+        """Octave noise in 0..1 per tile; octave k uses seed offset seed_offset + 1000k.
+
+        The native version hashes each lattice point once per row instead of
+        four times per tile and returns the same values bit for bit.
+        """
+        seed = self.seed + seed_offset
+        if use_native is None:
+            use_native = (USE_C_EXTENSIONS and C_NOISE_AVAILABLE and scale >= 0
+                          and 1 <= octaves <= 30 and abs(seed) < 2 ** 62)
+        if use_native and not C_NOISE_AVAILABLE:
+            raise ValueError("Native noise requested but the C extension is not available")
+        if not use_native:
+            return self._noise_map_python(scale, octaves, seed_offset)
+
+        values = array('d')
+        values.frombytes(c_algorithms.noise_map(self.width, self.height, seed, scale, octaves))
+        width = self.width
+        return [values[y * width:(y + 1) * width].tolist() for y in range(self.height)]
+
+    def _noise_map_python(self, scale: float, octaves: int, seed_offset: int) -> List[List[float]]:
+        """Pure Python twin of c_algorithms.noise_map"""
+        noise_map = []
         
         for y in range(self.height):
             row = []
             for x in range(self.width):
-                # Use multiple octaves for more realistic terrain
                 value = 0
                 amplitude = 1
                 frequency = scale
@@ -272,34 +383,16 @@ class TerrainGenerator:
                     value += self._perlin_noise(
                         x * frequency,
                         y * frequency,
-                        octave * 1000
+                        seed_offset + octave * 1000
                     ) * amplitude
                     amplitude *= 0.5
                     frequency *= 2
                     
                 # Normalize to 0-1 range
                 row.append((value + 1) / 2)
-            height_map.append(row)
+            noise_map.append(row)
             
-        return height_map
-        
-    def generate_moisture_map(self, scale: float = 0.15) -> List[List[float]]:
-        """Generate moisture map for vegetation distribution"""
-        moisture_map = []
-        offset = 10000  # Different offset for different noise
-        
-        for y in range(self.height):
-            row = []
-            for x in range(self.width):
-                value = self._perlin_noise(
-                    x * scale,
-                    y * scale,
-                    offset
-                )
-                row.append((value + 1) / 2)
-            moisture_map.append(row)
-            
-        return moisture_map
+        return noise_map
         
     @staticmethod
     def classify_terrain(height: float, moisture: float) -> TerrainType:
@@ -395,13 +488,16 @@ class TerrainGenerator:
                 
                 # Add stream feature for battle-appropriate water (avoid blocking rivers)
                 if terrain_grid[y][x].can_support_feature(TerrainFeature.STREAM):
-                    terrain_grid[y][x].feature = TerrainFeature.STREAM
+                    terrain_grid[y][x] = Terrain(terrain_grid[y][x].type, TerrainFeature.STREAM)
                     
     def generate_roads(self, terrain_grid: List[List[Terrain]], 
                       important_points: List[Tuple[int, int]]) -> None:
         """Generate roads connecting important points (like castles)"""
         if len(important_points) < 2:
             return
+
+        # Laying a road never changes a tile's road cost, so one grid serves every road
+        road_grid = self._road_grid(terrain_grid)
             
         # Connect each point to the nearest other point
         for i, start in enumerate(important_points):
@@ -417,72 +513,97 @@ class TerrainGenerator:
                         best_end = end
                         
             if best_end:
-                self._create_road(terrain_grid, start, best_end)
+                self._create_road(terrain_grid, start, best_end, road_grid)
                 
     def _create_road(self, terrain_grid: List[List[Terrain]], 
-                    start: Tuple[int, int], end: Tuple[int, int]) -> None:
+                    start: Tuple[int, int], end: Tuple[int, int],
+                    road_grid: Optional[bytes] = None) -> None:
         """Create a road between two points using A* pathfinding"""
-        from heapq import heappush, heappop
-        
-        # Simple A* to find good path for road
-        open_set = [(0, start)]
-        came_from = {}
-        g_score = {start: 0}
-        
-        while open_set:
-            _, current = heappop(open_set)
+        if road_grid is None:
+            road_grid = self._road_grid(terrain_grid)
+        path = self._find_road_path(road_grid, start, end)
+        if path is None:
+            return
             
-            if current == end:
-                # Reconstruct path
+        # Add road to tiles
+        for x, y in path:
+            tile = terrain_grid[y][x]
+            if tile.can_support_feature(TerrainFeature.ROAD):
+                terrain_grid[y][x] = Terrain(tile.type, TerrainFeature.ROAD)
+            elif tile.type == TerrainType.WATER and tile.can_support_feature(TerrainFeature.BRIDGE):
+                terrain_grid[y][x] = Terrain(tile.type, TerrainFeature.BRIDGE)
+
+    def _road_grid(self, terrain_grid: List[List[Terrain]]) -> bytes:
+        """Road cost class of every tile, row-major (see _ROAD_COSTS)"""
+        classes = _road_classes()
+        feature_count = len(TERRAIN_FEATURES)
+        if isinstance(terrain_grid, TerrainGrid):
+            terrain_map = terrain_grid._map
+            return bytes(classes[t * feature_count + f]
+                         for t, f in zip(terrain_map._types, terrain_map._features))
+        return bytes(classes[TERRAIN_TYPE_IDS[tile.type] * feature_count + TERRAIN_FEATURE_IDS[tile.feature]]
+                     for row in terrain_grid for tile in row)
+
+    def _find_road_path(self, road_grid: bytes, start: Tuple[int, int], end: Tuple[int, int],
+                        use_native: Optional[bool] = None) -> Optional[List[Tuple[int, int]]]:
+        """Cheapest hex path from start to end over road_grid, both ends included"""
+        if use_native is None:
+            use_native = USE_C_EXTENSIONS and C_NOISE_AVAILABLE
+        if use_native:
+            path = c_algorithms.find_path(self.width, self.height, road_grid, _ROAD_COSTS,
+                                          start, end, None, -1.0)
+        else:
+            path = self._find_road_path_python(road_grid, start, end)
+        return None if path is None else [start] + path
+
+    def _find_road_path_python(self, road_grid: bytes, start: Tuple[int, int],
+                               end: Tuple[int, int]) -> Optional[List[Tuple[int, int]]]:
+        """Pure Python twin of the native A* for roads; the path excludes start"""
+        width, height = self.width, self.height
+        end_q = end[0] - (end[1] - (end[1] & 1)) // 2
+
+        def distance(x: int, y: int) -> int:
+            q = x - (y - (y & 1)) // 2
+            return (abs(q - end_q) + abs(q + y - end_q - end[1]) + abs(y - end[1])) // 2
+
+        start_idx = start[1] * width + start[0]
+        g_scores = {start_idx: 0.0}
+        parents = {}
+        closed = set()
+        open_set = [(float(distance(*start)), start)]
+        while open_set:
+            _, (cx, cy) = heapq.heappop(open_set)
+            c_idx = cy * width + cx
+            if (cx, cy) == end:
                 path = []
-                while current in came_from:
-                    path.append(current)
-                    current = came_from[current]
-                path.append(start)
-                
-                # Add road to tiles
-                for x, y in path:
-                    tile = terrain_grid[y][x]
-                    if tile.can_support_feature(TerrainFeature.ROAD):
-                        tile.feature = TerrainFeature.ROAD
-                    elif tile.type == TerrainType.WATER and tile.can_support_feature(TerrainFeature.BRIDGE):
-                        tile.feature = TerrainFeature.BRIDGE
-                return
-                
-            # Check neighbors
-            x, y = current
-            for dx, dy in [(0, 1), (0, -1), (1, 0), (-1, 0)]:
-                nx, ny = x + dx, y + dy
-                if 0 <= nx < self.width and 0 <= ny < self.height:
-                    neighbor = (nx, ny)
-                    
-                    # Cost based on terrain
-                    terrain = terrain_grid[ny][nx]
-                    if not terrain.passable and terrain.type != TerrainType.WATER:
-                        continue
-                        
-                    move_cost = 1
-                    if terrain.type in [TerrainType.FOREST, TerrainType.DENSE_FOREST]:
-                        move_cost = 3  # Prefer to avoid forests
-                    elif terrain.type == TerrainType.WATER:
-                        move_cost = 5  # Expensive to bridge
-                        
-                    tentative_g = g_score[current] + move_cost
-                    
-                    if neighbor not in g_score or tentative_g < g_score[neighbor]:
-                        came_from[neighbor] = current
-                        g_score[neighbor] = tentative_g
-                        f_score = tentative_g + abs(end[0] - nx) + abs(end[1] - ny)
-                        heappush(open_set, (f_score, neighbor))
+                while c_idx != start_idx:
+                    path.append((c_idx % width, c_idx // width))
+                    c_idx = parents[c_idx]
+                path.reverse()
+                return path
+            if c_idx in closed:
+                continue
+            closed.add(c_idx)
+
+            for dx, dy in (_ROAD_EVEN_ROW_DIRS if cy % 2 == 0 else _ROAD_ODD_ROW_DIRS):
+                nx, ny = cx + dx, cy + dy
+                if not (0 <= nx < width and 0 <= ny < height):
+                    continue
+                n_idx = ny * width + nx
+                move_cost = _ROAD_COSTS[road_grid[n_idx]]
+                if n_idx in closed or math.isinf(move_cost):
+                    continue
+                tentative_g = g_scores[c_idx] + move_cost
+                if tentative_g < g_scores.get(n_idx, math.inf):
+                    parents[n_idx] = c_idx
+                    g_scores[n_idx] = tentative_g
+                    heapq.heappush(open_set, (tentative_g + distance(nx, ny), (nx, ny)))
+        return None
     
     def generate_forest_clusters(self, terrain_grid: List[List[Terrain]]) -> None:
         """Generate realistic forest clusters with light -> forest -> dense progression"""
         # Find existing light forest areas to expand into clusters
-        light_forest_seeds = []
-        for y in range(self.height):
-            for x in range(self.width):
-                if terrain_grid[y][x].type == TerrainType.LIGHT_FOREST:
-                    light_forest_seeds.append((x, y))
+        light_forest_seeds = self._tiles_where(terrain_grid, terrain_type=TerrainType.LIGHT_FOREST)
         
         # Create forest clusters from each seed
         for seed_x, seed_y in light_forest_seeds:
@@ -544,11 +665,7 @@ class TerrainGenerator:
     def generate_hill_clusters(self, terrain_grid: List[List[Terrain]]) -> None:
         """Generate additional hill clusters for more varied terrain"""
         # Find existing hills to potentially expand
-        hill_seeds = []
-        for y in range(self.height):
-            for x in range(self.width):
-                if terrain_grid[y][x].type == TerrainType.HILLS:
-                    hill_seeds.append((x, y))
+        hill_seeds = self._tiles_where(terrain_grid, terrain_type=TerrainType.HILLS)
         
         # Expand some existing hills
         for seed_x, seed_y in hill_seeds:
@@ -652,11 +769,7 @@ class TerrainGenerator:
         """Add 0-1 small swamp areas near streams"""
         if random.random() < 0.4:  # 40% chance for swamp
             # Find stream locations
-            stream_locations = []
-            for y in range(self.height):
-                for x in range(self.width):
-                    if terrain_grid[y][x].feature == TerrainFeature.STREAM:
-                        stream_locations.append((x, y))
+            stream_locations = self._tiles_where(terrain_grid, feature=TerrainFeature.STREAM)
             
             if stream_locations:
                 # Pick a random stream location
@@ -670,6 +783,25 @@ class TerrainGenerator:
                             random.random() < 0.6):  # 60% chance per adjacent tile
                             terrain_grid[ny][nx] = Terrain(TerrainType.SWAMP)
     
+    def _tiles_where(self, terrain_grid: List[List[Terrain]], terrain_type: Optional[TerrainType] = None,
+                     feature: Optional[TerrainFeature] = None) -> List[Tuple[int, int]]:
+        """Tiles of the given type or feature, row-major; scans a TerrainMap's planes directly"""
+        if isinstance(terrain_grid, TerrainGrid):
+            terrain_map = terrain_grid._map
+            if terrain_type is not None:
+                plane, wanted = terrain_map._types, TERRAIN_TYPE_IDS[terrain_type]
+            else:
+                plane, wanted = terrain_map._features, TERRAIN_FEATURE_IDS[feature]
+            tiles = []
+            index = plane.find(wanted)
+            while index >= 0:
+                tiles.append((index % self.width, index // self.width))
+                index = plane.find(wanted, index + 1)
+            return tiles
+        return [(x, y) for y in range(self.height) for x in range(self.width)
+                if (terrain_type is not None and terrain_grid[y][x].type == terrain_type)
+                or (terrain_type is None and terrain_grid[y][x].feature == feature)]
+    
     def _is_area_clear(self, terrain_grid: List[List[Terrain]], center_x: int, center_y: int, 
                       radius: int, required_type: TerrainType) -> bool:
         """Check if an area is mostly the required terrain type"""
@@ -768,8 +900,107 @@ class TerrainGenerator:
                 y += sy
                         
 
+# (type id * feature count + feature id) of every valid type/feature pair
+_VALID_CODES: List[int] = []
+for _type_id, _terrain_type in enumerate(TERRAIN_TYPES):
+    for _feature_id, _feature in enumerate(TERRAIN_FEATURES):
+        if _terrain_type not in {TerrainType.BRIDGE, TerrainType.ROAD} or _feature == TerrainFeature.NONE:
+            _VALID_CODES.append(_type_id * len(TERRAIN_FEATURES) + _feature_id)
+
+
+class TerrainRect(NamedTuple):
+    """Tiles left <= x < right, top <= y < bottom"""
+    left: int
+    top: int
+    right: int
+    bottom: int
+
+    def union(self, other: 'TerrainRect') -> 'TerrainRect':
+        return TerrainRect(min(self.left, other.left), min(self.top, other.top),
+                           max(self.right, other.right), max(self.bottom, other.bottom))
+
+
+class TerrainGridRow:
+    """One row of a TerrainMap, indexable like the list of Terrain it replaces"""
+    __slots__ = ('_map', '_y')
+
+    def __init__(self, terrain_map: 'TerrainMap', y: int):
+        self._map = terrain_map
+        self._y = y
+
+    def __len__(self) -> int:
+        return self._map.width
+
+    def _index(self, x: int) -> int:
+        width = self._map.width
+        if x < 0:
+            x += width
+        if not 0 <= x < width:
+            raise IndexError(f"terrain column {x} out of range")
+        return self._y * width + x
+
+    def __getitem__(self, x: int) -> Terrain:
+        index = self._index(x)
+        return _flyweight(self._map._types[index], self._map._features[index])
+
+    def __setitem__(self, x: int, terrain: Terrain) -> None:
+        self._map._store(self._index(x), terrain)
+
+    def __iter__(self):
+        for x in range(self._map.width):
+            yield self[x]
+
+
+class TerrainGrid:
+    """terrain_grid[y][x] access to a TerrainMap's planes.
+
+    Reads return the shared Terrain for the tile; assignments write the
+    planes. append() fills rows in order, for maps built row by row.
+    """
+    __slots__ = ('_map',)
+
+    def __init__(self, terrain_map: 'TerrainMap'):
+        self._map = terrain_map
+
+    def __len__(self) -> int:
+        return self._map.height
+
+    def __getitem__(self, y: int) -> TerrainGridRow:
+        height = self._map.height
+        if y < 0:
+            y += height
+        if not 0 <= y < height:
+            raise IndexError(f"terrain row {y} out of range")
+        return TerrainGridRow(self._map, y)
+
+    def __iter__(self):
+        for y in range(self._map.height):
+            yield TerrainGridRow(self._map, y)
+
+    def append(self, row) -> None:
+        terrain_map = self._map
+        y = terrain_map._rows_loaded
+        terrain_map._load_row(y, row)
+        terrain_map._rows_loaded += 1
+        terrain_map._record_change(TerrainRect(0, y, terrain_map.width, y + 1))
+
+
 class TerrainMap:
-    """Enhanced terrain map with layered terrain system"""
+    """Enhanced terrain map with layered terrain system.
+
+    Tiles are stored as two byte planes, terrain type id and feature id (see
+    TERRAIN_TYPE_IDS / TERRAIN_FEATURE_IDS), one byte each per tile.
+    get_terrain returns the shared Terrain for the tile's pair, so queries
+    allocate nothing and a 1000x1000 map takes 2 MB.
+
+    Every change bumps ``revision`` once, or once per ``batch()``, and is
+    recorded in a journal of changed rectangles, so caches derived from the
+    map can patch the tiles changed since the revision they were built at
+    (see changes_since).
+    """
+
+    # Journal entries kept; older changes force consumers to rebuild
+    JOURNAL_LIMIT = 64
     
     def __init__(self, width: int, height: int, seed: Optional[int] = None):
         if not isinstance(width, int) or not isinstance(height, int):
@@ -781,49 +1012,144 @@ class TerrainMap:
         self.width = width
         self.height = height
         self._revision = 0
-        self.terrain_grid: List[List[Terrain]] = []
+        self._allocate()
         
         self._generate_terrain(seed)
+
+    def _allocate(self) -> None:
+        """Fill both planes with featureless plains"""
+        size = self.width * self.height
+        self._types = bytearray([TERRAIN_TYPE_IDS[TerrainType.PLAINS]]) * size
+        self._features = bytearray([TERRAIN_FEATURE_IDS[TerrainFeature.NONE]]) * size
+        self._rows_loaded = self.height
+        # Movement cost planes by unit cost table: (revision built at, plane)
+        self._cost_planes = {}
+        self._codes = None
+        # Whole-map replacement: no earlier revision can be patched
+        self._revision = self.revision
+        self._journal: List[Tuple[int, TerrainRect]] = []
+        self._journal_floor = self._revision
+        self._batch_depth = 0
+        self._batch_rect: Optional[TerrainRect] = None
         
     def _generate_terrain(self, seed: Optional[int] = None):
         """Generate realistic battle terrain starting with plains base"""
         generator = TerrainGenerator(self.width, self.height, seed)
         
         # Start with all plains for consistent battle terrain
-        self.terrain_grid = []
-        for y in range(self.height):
-            row = []
-            for x in range(self.width):
-                row.append(Terrain(TerrainType.PLAINS))
-            self.terrain_grid.append(row)
-        
-        # Generate strategic terrain features in controlled amounts
-        generator.generate_controlled_features(self.terrain_grid)
-        
-        # Add roads connecting castle positions (if standard size)
-        if self.width >= 20 and self.height >= 20:
-            castle_positions = [
-                (2, 2),
-                (self.width - 3, self.height - 3),
-                (2, self.height - 3),
-                (self.width - 3, 2)
-            ]
-            # Only use positions that are in bounds
-            valid_positions = [
-                pos for pos in castle_positions
-                if pos[0] < self.width and pos[1] < self.height
-            ]
-            generator.generate_roads(self.terrain_grid, valid_positions[:2])
+        self._allocate()
+        
+        with self.batch():
+            # Generate strategic terrain features in controlled amounts
+            generator.generate_controlled_features(self.terrain_grid)
+            
+            # Add roads connecting castle positions (if standard size)
+            if self.width >= 20 and self.height >= 20:
+                castle_positions = [
+                    (2, 2),
+                    (self.width - 3, self.height - 3),
+                    (2, self.height - 3),
+                    (self.width - 3, 2)
+                ]
+                # Only use positions that are in bounds
+                valid_positions = [
+                    pos for pos in castle_positions
+                    if pos[0] < self.width and pos[1] < self.height
+                ]
+                generator.generate_roads(self.terrain_grid, valid_positions[:2])
         self._revision += 1
+        self._journal_floor = self._revision
+        self._journal.clear()
 
     @property
     def revision(self) -> int:
-        return self._revision
+        return getattr(self, '_revision', 0)
+
+    @contextmanager
+    def batch(self):
+        """Apply many edits as one change: one revision bump and one journal rectangle.
+
+        Batches nest; the change is published when the outermost one exits.
+        """
+        self._batch_depth += 1
+        try:
+            yield self
+        finally:
+            self._batch_depth -= 1
+            if self._batch_depth == 0 and self._batch_rect is not None:
+                rect, self._batch_rect = self._batch_rect, None
+                self._record_change(rect)
+
+    def changes_since(self, revision: int) -> Optional[List[TerrainRect]]:
+        """Rectangles changed after revision, oldest first.
+
+        None when the journal no longer reaches back that far (or the whole
+        map was replaced since), in which case derived data must be rebuilt.
+        """
+        if revision == self.revision:
+            return []
+        if revision < self._journal_floor or revision > self.revision:
+            return None
+        return [rect for changed_at, rect in self._journal if changed_at > revision]
+
+    def _record_change(self, rect: TerrainRect) -> None:
+        self._revision = self.revision + 1
+        self._journal.append((self._revision, rect))
+        if len(self._journal) > self.JOURNAL_LIMIT:
+            dropped_at, _ = self._journal.pop(0)
+            self._journal_floor = dropped_at
+
+    @property
+    def terrain_grid(self) -> TerrainGrid:
+        """Row-major Terrain view of the planes: terrain_grid[y][x]"""
+        return TerrainGrid(self)
+
+    @terrain_grid.setter
+    def terrain_grid(self, rows) -> None:
+        """Replace every tile from a list of rows of Terrain.
+
+        An empty list keeps width and height and lets rows be appended.
+        """
+        if rows:
+            self.height = len(rows)
+            self.width = len(rows[0])
+        self._allocate()
+        self._rows_loaded = 0
+        for y, row in enumerate(rows):
+            self._load_row(y, row)
+        self._rows_loaded = len(rows)
+        self._revision = self.revision + 1
+        self._journal_floor = self._revision
+        self._journal.clear()
+
+    def _load_row(self, y: int, row) -> None:
+        if not 0 <= y < self.height:
+            raise ValueError(f"terrain row {y} out of range for map height {self.height}")
+        if len(row) != self.width:
+            raise ValueError(f"terrain row must have {self.width} tiles, got {len(row)}")
+        for x, terrain in enumerate(row):
+            if not isinstance(terrain, Terrain):
+                raise ValueError(f"terrain must be Terrain, got {type(terrain).__name__}")
+            self._types[y * self.width + x] = TERRAIN_TYPE_IDS[terrain.type]
+            self._features[y * self.width + x] = TERRAIN_FEATURE_IDS[terrain.feature]
+
+    def _store(self, index: int, terrain: Terrain) -> None:
+        if not isinstance(terrain, Terrain):
+            raise ValueError(f"terrain must be Terrain, got {type(terrain).__name__}")
+        self._types[index] = TERRAIN_TYPE_IDS[terrain.type]
+        self._features[index] = TERRAIN_FEATURE_IDS[terrain.feature]
+        y, x = divmod(index, self.width)
+        rect = TerrainRect(x, y, x + 1, y + 1)
+        if self._batch_depth:
+            self._batch_rect = rect if self._batch_rect is None else self._batch_rect.union(rect)
+        else:
+            self._record_change(rect)
             
     def get_terrain(self, x: int, y: int) -> Optional[Terrain]:
         """Get terrain at position"""
         if 0 <= x < self.width and 0 <= y < self.height:
-            return self.terrain_grid[y][x]
+            index = y * self.width + x
+            return _flyweight(self._types[index], self._features[index])
         return None
         
     def set_terrain(self, x: int, y: int, terrain_type: TerrainType, 
@@ -833,9 +1159,55 @@ class TerrainMap:
             raise ValueError("x and y must be integers")
         if not (0 <= x < self.width and 0 <= y < self.height):
             raise ValueError(f"Terrain coordinates out of bounds: ({x}, {y}) for map {self.width}x{self.height}")
-        self.terrain_grid[y][x] = Terrain(terrain_type, feature)
-        self._revision += 1
-            
+        self._store(y * self.width + x, Terrain.of(terrain_type, feature))
+
+    def type_ids(self) -> bytes:
+        """Snapshot of the terrain type plane, one TERRAIN_TYPE_IDS byte per tile, row-major"""
+        return bytes(self._types)
+
+    def feature_ids(self) -> bytes:
+        """Snapshot of the feature plane, one TERRAIN_FEATURE_IDS byte per tile, row-major"""
+        return bytes(self._features)
+
+    def movement_cost_plane(self, unit) -> array:
+        """Movement cost of every tile for a unit, row-major doubles (inf = impassable).
+
+        Costs depend only on the unit's terrain behaviour, so planes are
+        cached per cost table and shared by units with the same costs. After
+        terrain edits a cached plane is copied and patched over the changed
+        rectangles rather than rebuilt. The array supports the buffer protocol.
+        """
+        feature_count = len(TERRAIN_FEATURES)
+        costs = [0.0] * len(_FLYWEIGHTS)
+        for code in _VALID_CODES:
+            costs[code] = _flyweight(*divmod(code, feature_count)).get_movement_cost_for_unit(unit)
+        key = tuple(costs[code] for code in _VALID_CODES)
+
+        cached = self._cost_planes.get(key)
+        if cached is not None and cached[0] == self.revision:
+            return cached[1]
+        changes = self.changes_since(cached[0]) if cached is not None else None
+        if changes is None:
+            plane = array('d', map(costs.__getitem__, self._tile_codes()))
+        else:
+            plane = array('d', cached[1])
+            types, features, width = self._types, self._features, self.width
+            for rect in changes:
+                for y in range(rect.top, rect.bottom):
+                    row = y * width
+                    for index in range(row + rect.left, row + rect.right):
+                        plane[index] = costs[types[index] * feature_count + features[index]]
+        self._cost_planes[key] = (self.revision, plane)
+        return plane
+
+    def _tile_codes(self) -> bytes:
+        """Type id * feature count + feature id per tile, cached per revision"""
+        if self._codes is None or self._codes[0] != self.revision:
+            feature_count = len(TERRAIN_FEATURES)
+            self._codes = (self.revision,
+                           bytes(t * feature_count + f for t, f in zip(self._types, self._features)))
+        return self._codes[1]
+
     def is_passable(self, x: int, y: int, unit=None) -> bool:
         """Check if position is passable"""
         terrain = self.get_terrain(x, y)
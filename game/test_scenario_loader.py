@@ -195,16 +195,17 @@ class TestScenarioLoader:
         game_state.knights.clear()
         game_state.castles.clear()
         
-        # Set up terrain
+        # Set up terrain as one change
         base_terrain = cls.TERRAIN_MAPPING[scenario.terrain_base]
-        for x in range(game_state.board_width):
-            for y in range(game_state.board_height):
-                game_state.terrain_map.set_terrain(x, y, base_terrain)
-        
-        # Apply specific terrain tiles
-        for tile in scenario.terrain_tiles:
-            terrain_type = cls.TERRAIN_MAPPING[tile['type']]
-            game_state.terrain_map.set_terrain(tile['x'], tile['y'], terrain_type)
+        with game_state.terrain_map.batch():
+            for x in range(game_state.board_width):
+                for y in range(game_state.board_height):
+                    game_state.terrain_map.set_terrain(x, y, base_terrain)
+            
+            # Apply specific terrain tiles
+            for tile in scenario.terrain_tiles:
+                terrain_type = cls.TERRAIN_MAPPING[tile['type']]
+                game_state.terrain_map.set_terrain(tile['x'], tile['y'], terrain_type)
         
         # Create units
         for unit_def in scenario.units:
@@ -95,11 +95,12 @@ class TestScenario:
         self._setup_flat_terrain(game_state)
         
         # Apply terrain modifications BEFORE creating units
-        for x, y, terrain_type in self.terrain_modifications:
-            # Get terrain at offset coordinates and modify it
-            terrain = game_state.terrain_map.get_terrain(x, y)
-            if terrain:
-                terrain.type = terrain_type
+        with game_state.terrain_map.batch():
+            for x, y, terrain_type in self.terrain_modifications:
+                # Replace the terrain type at offset coordinates, keeping its feature
+                terrain = game_state.terrain_map.get_terrain(x, y)
+                if terrain:
+                    game_state.terrain_map.set_terrain(x, y, terrain_type, terrain.feature)
         
         # Create units
         for unit_data in self.units:
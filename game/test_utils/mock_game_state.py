@@ -19,9 +19,10 @@ class MockGameState(IGameState):
 
         if self._terrain_map is not None:
             from game.terrain import TerrainType
-            for y in range(self._board_height):
-                for x in range(self._board_width):
-                    self._terrain_map.set_terrain(x, y, TerrainType.PLAINS)
+            with self._terrain_map.batch():
+                for y in range(self._board_height):
+                    for x in range(self._board_width):
+                        self._terrain_map.set_terrain(x, y, TerrainType.PLAINS)
         
         # Additional test-specific attributes
         self.pending_positions = {}  # For tracking movement animations
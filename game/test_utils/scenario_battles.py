@@ -0,0 +1,44 @@
+"""Battle states built from the test scenario maps, for tests and tools"""
+import contextlib
+import random
+from typing import Iterator, List
+
+from game.state.battle_state import BattleState
+from game.test_scenario_loader import TestScenarioLoader
+
+
+def loadable_scenarios() -> List[str]:
+    """Scenario names the loader accepts; malformed scenario files are skipped"""
+    names = []
+    for name in TestScenarioLoader.list_scenarios():
+        try:
+            TestScenarioLoader.load_scenario(name)
+        except ValueError:
+            continue
+        names.append(name)
+    return names
+
+
+def load_battle(scenario_name: str, current_player: int = 2) -> BattleState:
+    """Build a fresh BattleState from a test scenario, fog updated, current_player to move"""
+    scenario = TestScenarioLoader.load_scenario(scenario_name)
+    battle_state = BattleState({'board_size': tuple(scenario.board_size), 'knights': 0, 'castles': 1})
+    TestScenarioLoader.apply_to_game_state(scenario, battle_state)
+    battle_state.update_all_fog_of_war()
+    battle_state.current_player = current_player
+    return battle_state
+
+
+@contextlib.contextmanager
+def seeded_random(seed: int) -> Iterator[None]:
+    """Run with the shared random stream set from random.Random(seed).
+
+    Combat and routing draw from the random module, so repeatable battles
+    need it seeded; the caller's stream is restored afterwards.
+    """
+    saved = random.getstate()
+    random.setstate(random.Random(seed).getstate())
+    try:
+        yield
+    finally:
+        random.setstate(saved)
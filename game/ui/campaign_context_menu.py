@@ -112,8 +112,8 @@ class CampaignContextMenu:
             
             # Check if there's an army at this city's position
             army_at_city = None
-            for army in self.campaign_state.armies.values():
-                if army.position == city.position and army.country == self.campaign_state.current_country:
+            for army in self.campaign_state.armies.at(city.position):
+                if army.country == self.campaign_state.current_country:
                     army_at_city = army
                     break
                     
@@ -3,6 +3,8 @@ import os
 import json
 from typing import Optional, List, Dict
 
+from game.campaign.campaign_map_file import is_campaign_map_file, read_header
+
 
 class CampaignMapSelectScreen:
     """Screen for selecting a campaign map"""
@@ -49,9 +51,28 @@ class CampaignMapSelectScreen:
         self.available_maps = []
         
         if os.path.exists(campaign_data_dir):
-            for filename in sorted(os.listdir(campaign_data_dir)):
-                if filename.endswith('.json'):
-                    filepath = os.path.join(campaign_data_dir, filename)
+            filenames = sorted(os.listdir(campaign_data_dir))
+            binary_stems = {os.path.splitext(name)[0] for name in filenames if is_campaign_map_file(name)}
+            for filename in filenames:
+                filepath = os.path.join(campaign_data_dir, filename)
+                if is_campaign_map_file(filename):
+                    # Binary maps list from their header alone
+                    try:
+                        header = read_header(filepath)
+                    except (OSError, ValueError) as e:
+                        print(f"Error loading map {filename}: {e}")
+                        continue
+                    self.available_maps.append({
+                        'filename': filename,
+                        'filepath': filepath,
+                        'name': self._generate_map_name(filename),
+                        'width': header.width,
+                        'height': header.height,
+                        'hex_size_km': header.hex_size_km,
+                        'cities_count': header.city_count,
+                        'countries_count': header.country_count
+                    })
+                elif filename.endswith('.json') and os.path.splitext(filename)[0] not in binary_stems:
                     try:
                         with open(filepath, 'r', encoding='utf-8') as f:
                             data = json.load(f)
@@ -101,7 +122,7 @@ class CampaignMapSelectScreen:
     
     def _generate_map_name(self, filename: str) -> str:
         """Generate a human-readable name from filename"""
-        name = filename.replace('.json', '').replace('_', ' ')
+        name = os.path.splitext(filename)[0].replace('_', ' ')
         
         # Parse map filename format: map_WESTw_EASTe_SOUTHs_NORTHn_SIZEkm_WIDTHxHEIGHT
         if name.startswith('map '):
@@ -27,6 +27,7 @@ class CampaignScreen:
         # AI turn processing
         self.ai_turn_timer = 0
         self.ai_turn_delay = 1.0  # 1 second delay for AI turns
+        self.last_ai_report = None
         
         # UI elements
         self.context_menu = CampaignContextMenu()
@@ -131,16 +132,14 @@ class CampaignScreen:
         army_at_hex = None
         
         # Find city at hex
-        for city_id, city in self.campaign_state.cities.items():
-            if city.position == hex_pos:
-                city_at_hex = city
-                break
+        for city in self.campaign_state.cities.at(hex_pos):
+            city_at_hex = city
+            break
                 
         # Find army at hex
-        for army_id, army in self.campaign_state.armies.items():
-            if army.position == hex_pos:
-                army_at_hex = (army_id, army)
-                break
+        for army_id, army in self.campaign_state.armies.items_at(hex_pos):
+            army_at_hex = (army_id, army)
+            break
         
         # Update selection state
         self.selected_city = city_at_hex
@@ -186,15 +185,13 @@ class CampaignScreen:
             city_at_pos = None
             army_at_pos = None
             
-            for city_id, city in self.campaign_state.cities.items():
-                if city.position == hex_pos:
-                    city_at_pos = city
-                    break
+            for city in self.campaign_state.cities.at(hex_pos):
+                city_at_pos = city
+                break
             
-            for army in self.campaign_state.armies.values():
-                if army.position == hex_pos:
-                    army_at_pos = army
-                    break
+            for army in self.campaign_state.armies.at(hex_pos):
+                army_at_pos = army
+                break
             
             if city_at_pos or army_at_pos:
                 # Show context menu for what's at the clicked position
@@ -224,10 +221,9 @@ class CampaignScreen:
                     self.selected_city = None
                     
                     # Check for city at new position
-                    for city_id, city in self.campaign_state.cities.items():
-                        if city.position == hex_pos:
-                            self.selected_city = city
-                            break
+                    for city in self.campaign_state.cities.at(hex_pos):
+                        self.selected_city = city
+                        break
                     
                     # Check if we're at an enemy territory/army
                     enemy_army = self._get_enemy_army_at_position(hex_pos)
@@ -241,9 +237,8 @@ class CampaignScreen:
                 
     def _get_enemy_army_at_position(self, hex_pos: HexCoord) -> Optional[Army]:
         """Check if there's an enemy army at the given hex position"""
-        for army in self.campaign_state.armies.values():
-            if (army.country != self.campaign_state.current_country and
-                army.position == hex_pos):
+        for army in self.campaign_state.armies.at(hex_pos):
+            if army.country != self.campaign_state.current_country:
                 return army
         return None
     
@@ -382,16 +377,12 @@ class CampaignScreen:
         if self.campaign_state.current_country != self.campaign_state.player_country:
             self.ai_turn_timer -= dt
             if self.ai_turn_timer <= 0:
-                # Simple AI: move armies randomly for now
                 self._process_ai_turn()
-                self.campaign_state.end_turn()
                 self.ai_turn_timer = self.ai_turn_delay
                 
     def _process_ai_turn(self):
-        """Process AI country turn"""
-        # For now, AI doesn't move - just processes the turn
-        # In future, add AI movement logic here
-        pass
+        """Play all AI countries' turns, handing control back to the player"""
+        self.last_ai_report = self.campaign_state.play_ai_turns()
         
     def draw(self):
         """Draw the campaign screen"""
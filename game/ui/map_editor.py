@@ -536,9 +536,8 @@ class MapEditorScreen:
         hex_pos = self.renderer.screen_to_hex(pos, self.campaign_state.hex_layout)
         if hex_pos:
             # Check if city already exists at this position
-            for city in self.campaign_state.cities.values():
-                if city.position == hex_pos:
-                    return  # City already exists here
+            if self.campaign_state.cities.at(hex_pos):
+                return  # City already exists here
             
             # Create new city
             city_id = f"city_{len(self.campaign_state.cities)}"
@@ -566,10 +565,9 @@ class MapEditorScreen:
         if hex_pos:
             # Find city at this position
             city_to_remove = None
-            for city_id, city in self.campaign_state.cities.items():
-                if city.position == hex_pos:
-                    city_to_remove = city_id
-                    break
+            for city_id, city in self.campaign_state.cities.items_at(hex_pos):
+                city_to_remove = city_id
+                break
             
             if city_to_remove:
                 del self.campaign_state.cities[city_to_remove]
@@ -583,11 +581,10 @@ class MapEditorScreen:
         hex_pos = self.renderer.screen_to_hex(pos, self.campaign_state.hex_layout)
         if hex_pos:
             # Find city at this position
-            for city_id, city in self.campaign_state.cities.items():
-                if city.position == hex_pos:
-                    # Open city edit dialog
-                    self.city_edit_dialog = CityEditDialog(self.screen, city, city_id)
-                    break
+            for city_id, city in self.campaign_state.cities.items_at(hex_pos):
+                # Open city edit dialog
+                self.city_edit_dialog = CityEditDialog(self.screen, city, city_id)
+                break
     
     def _handle_pan_drag(self, pos: Tuple[int, int]):
         """Handle camera panning"""
@@ -601,7 +598,7 @@ class MapEditorScreen:
     def _save_state(self):
         """Save current state for undo"""
         state = {
-            'terrain_map': dict(self.campaign_state.terrain_map),
+            'terrain_map': self.campaign_state.terrain_map.snapshot(),
             'cities': {k: {
                 'name': v.name,
                 'country': v.country,
@@ -641,9 +638,7 @@ class MapEditorScreen:
     def _restore_state(self, state: Dict):
         """Restore editor state"""
         # Restore terrain
-        self.campaign_state.terrain_map.clear()
-        for (q, r), terrain in state['terrain_map'].items():
-            self.campaign_state.terrain_map[(q, r)] = terrain
+        self.campaign_state.terrain_map.restore(state['terrain_map'])
         
         # Restore cities
         self.campaign_state.cities.clear()
@@ -837,10 +832,9 @@ class MapEditorScreen:
                     info_lines.append(f"Terrain: {terrain.name.title()}")
                 
                 # Show city if present
-                for city in self.campaign_state.cities.values():
-                    if city.position == hex_pos:
-                        info_lines.append(f"City: {city.name} ({city.country})")
-                        break
+                for city in self.campaign_state.cities.at(hex_pos):
+                    info_lines.append(f"City: {city.name} ({city.country})")
+                    break
                 
                 # Draw info box
                 if info_lines:
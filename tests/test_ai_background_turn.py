@@ -0,0 +1,144 @@
+"""Tests for AI planning on a background thread against battle snapshots."""
+import contextlib
+import io
+import threading
+import time
+
+import pygame
+
+from game.ai.ai_player import AIPlayer
+from game.ai.background_turn import BackgroundAITurn
+from game.ai.battle_snapshot import BattleSnapshot
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.game_state import GameState
+from game.terrain import TerrainType
+from game.visibility import VisibilityState
+
+
+def _make_game_state(vs_ai=False):
+    if not pygame.get_init():
+        pygame.init()
+    if not pygame.font.get_init():
+        pygame.font.init()
+
+    game_state = GameState(
+        battle_config={'board_size': (16, 12), 'knights': 0, 'castles': 1},
+        vs_ai=vs_ai,
+    )
+    game_state.knights = []
+    # Generated terrain is random; keep runs comparable
+    for y in range(game_state.board_height):
+        for x in range(game_state.board_width):
+            game_state.terrain_map.set_terrain(x, y, TerrainType.PLAINS)
+    layout = [
+        ("AI Warrior", KnightClass.WARRIOR, 9, 5, 2),
+        ("AI Archer", KnightClass.ARCHER, 11, 6, 2),
+        ("AI Cavalry", KnightClass.CAVALRY, 10, 8, 2),
+        ("Warrior", KnightClass.WARRIOR, 6, 5, 1),
+        ("Archer", KnightClass.ARCHER, 4, 6, 1),
+    ]
+    for name, unit_class, x, y, player_id in layout:
+        unit = UnitFactory.create_unit(name, unit_class, x, y)
+        unit.player_id = player_id
+        game_state.knights.append(unit)
+    game_state.current_player = 2
+    game_state._update_all_fog_of_war()
+    return game_state
+
+
+def test_snapshot_is_isolated_from_live_changes():
+    game_state = _make_game_state()
+    warrior = game_state.knights[0]
+    game_state.pending_positions[id(warrior)] = (8, 5)
+
+    snapshot = BattleSnapshot.capture(game_state)
+    clone = snapshot.knights[0]
+    visibility = snapshot.fog_of_war.get_visibility_state(2, 6, 5)
+
+    warrior.x, warrior.y = 7, 7
+    warrior.stats.stats.current_soldiers = 1
+    game_state.fog_of_war.visibility_maps[2][(6, 5)] = VisibilityState.HIDDEN
+
+    assert (clone.x, clone.y) == (9, 5)
+    assert clone.soldiers != 1
+    assert snapshot.pending_positions == {id(clone): (8, 5)}
+    assert snapshot.fog_of_war.get_visibility_state(2, 6, 5) == visibility
+    assert snapshot.live_unit(clone) is warrior
+
+    target = snapshot.knights[3]
+    live_action = snapshot.to_live_action(('attack', clone, target, 10))
+    assert live_action == ('attack', warrior, game_state.knights[3], 10)
+
+
+def test_background_turn_matches_synchronous_turn():
+    sync_state = _make_game_state()
+    with contextlib.redirect_stdout(io.StringIO()):
+        expected = AIPlayer(2, 'easy').execute_turn(sync_state)
+
+    background_state = _make_game_state()
+    turn = BackgroundAITurn(AIPlayer(2, 'easy'), background_state)
+    with contextlib.redirect_stdout(io.StringIO()):
+        turn.start()
+        while not turn.poll(block=True, timeout=30):
+            pass
+
+    assert expected
+    assert turn.actions_taken == expected
+    assert [(k.name, k.action_points) for k in background_state.knights] == \
+        [(k.name, k.action_points) for k in sync_state.knights]
+    assert sorted(background_state.pending_positions.values()) == sorted(sync_state.pending_positions.values())
+
+
+class _GatedAIPlayer(AIPlayer):
+    """Holds every plan after the first until released"""
+
+    def __init__(self, *args, **kwargs):
+        super().__init__(*args, **kwargs)
+        self.plans_started = 0
+        self.second_plan_started = threading.Event()
+        self.release = threading.Event()
+
+    def plan_action(self, game_state, touched_tiles=()):
+        self.plans_started += 1
+        if self.plans_started > 1:
+            self.second_plan_started.set()
+            self.release.wait(timeout=30)
+        return super().plan_action(game_state, touched_tiles)
+
+
+def test_first_action_is_applied_while_next_is_planned():
+    game_state = _make_game_state()
+    ai = _GatedAIPlayer(2, 'easy')
+    turn = BackgroundAITurn(ai, game_state)
+
+    with contextlib.redirect_stdout(io.StringIO()):
+        turn.start()
+        assert not turn.poll(block=True, timeout=30)
+        assert ai.second_plan_started.wait(timeout=30)
+
+        # The first action is live and animating while the worker is still planning
+        assert len(turn.actions_taken) == 1
+        assert game_state.animation_coordinator.is_animating()
+        assert not turn.poll()
+
+        ai.release.set()
+        while not turn.poll(block=True, timeout=30):
+            pass
+
+    assert turn.done
+    assert ai._move_cache_state is None
+
+
+def test_presentation_state_finishes_turn_after_animations():
+    game_state = _make_game_state(vs_ai=True)
+
+    with contextlib.redirect_stdout(io.StringIO()):
+        deadline = time.monotonic() + 30
+        while game_state.current_player == 2 and time.monotonic() < deadline:
+            game_state.update(0.05)
+            time.sleep(0.001)
+
+    assert game_state.current_player == 1
+    assert not game_state.ai_thinking
+    assert not game_state.animation_coordinator.is_animating()
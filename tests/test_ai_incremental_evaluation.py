@@ -0,0 +1,101 @@
+"""Tests for incremental AI position evaluation."""
+import contextlib
+import io
+
+from game.ai.ai_player import AIPlayer
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.test_utils.mock_game_state import MockGameState
+from game.test_utils.scenario_battles import load_battle
+
+
+def _make_state():
+    game_state = MockGameState(board_width=40, board_height=40)
+    game_state.fog_of_war = None
+    game_state._castles = []
+    return game_state
+
+
+def _add_unit(game_state, name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    game_state.add_knight(unit)
+    return unit
+
+
+def _full_evaluation(ai, game_state):
+    ai.use_incremental_evaluation = False
+    try:
+        return ai.evaluate_position(game_state)
+    finally:
+        ai.use_incremental_evaluation = True
+
+
+def test_incremental_matches_full_evaluation_two_plies_deep():
+    for scenario_name in ("archer_line_of_sight", "cavalry_charge"):
+        battle_state = load_battle(scenario_name)
+        ai = AIPlayer(2, 'medium')
+        ai._begin_search(battle_state)
+
+        for move in ai.get_all_possible_moves(battle_state)[:12]:
+            child = ai._simulate_move(battle_state, move)
+            for reply in ai.get_all_possible_moves(child)[:6]:
+                leaf = ai._simulate_move(child, reply)
+                assert ai.evaluate_position(leaf) == _full_evaluation(ai, leaf)
+
+        assert ai._evaluator.units_reused > 0
+
+
+def test_distant_units_keep_their_terms():
+    game_state = _make_state()
+    mover = _add_unit(game_state, "Mover", KnightClass.WARRIOR, 3, 5, 2)
+    _add_unit(game_state, "Enemy", KnightClass.WARRIOR, 3, 9, 1)
+    for i in range(4):
+        _add_unit(game_state, f"Far Ally {i}", KnightClass.ARCHER, 30 + i, 30, 2)
+        _add_unit(game_state, f"Far Enemy {i}", KnightClass.WARRIOR, 30 + i, 34, 1)
+
+    ai = AIPlayer(2, 'medium')
+    ai._begin_search(game_state)
+    ai.evaluate_position(game_state)
+    root_computations = ai._evaluator.units_recomputed
+
+    child = ai._simulate_move(game_state, ('move', mover, 4, 6))
+    score = ai.evaluate_position(child)
+
+    assert score == _full_evaluation(ai, child)
+    # Only the mover and the enemy whose nearest-enemy distance it crossed
+    assert ai._evaluator.units_recomputed - root_computations == 2
+    assert ai._evaluator.units_reused == 8
+
+
+def test_removed_unit_updates_neighbours():
+    game_state = _make_state()
+    attacker = _add_unit(game_state, "Attacker", KnightClass.WARRIOR, 10, 10, 2)
+    target = _add_unit(game_state, "Target", KnightClass.ARCHER, 11, 10, 1)
+    _add_unit(game_state, "Line Left", KnightClass.WARRIOR, 10, 9, 2)
+    _add_unit(game_state, "Far Enemy", KnightClass.WARRIOR, 25, 25, 1)
+
+    ai = AIPlayer(2, 'medium')
+    ai._begin_search(game_state)
+    child = ai._simulate_move(game_state, ('attack', attacker, target, 0))
+    ai.evaluate_position(child)
+
+    # Drop the target as a killing blow would and derive a grandchild from it
+    removed = next(k for k in child.knights if k.name == "Target")
+    grandchild = ai._simulate_move(child, ('move', removed, removed.x, removed.y))
+    grandchild.remove_unit(next(k for k in grandchild.knights if k.name == "Target"))
+
+    assert ai.evaluate_position(grandchild) == _full_evaluation(ai, grandchild)
+
+
+def test_choose_action_unchanged_by_incremental_evaluation():
+    chosen = []
+    for incremental in (False, True):
+        ai = AIPlayer(2, 'medium', use_incremental_evaluation=incremental)
+        battle_state = load_battle("archer_mechanics")
+        with contextlib.redirect_stdout(io.StringIO()):
+            move = ai.choose_action(battle_state)
+        target = (move[2], move[3]) if move[0] == 'move' else move[2].name
+        chosen.append((move[0], move[1].name, target))
+
+    assert chosen[0] == chosen[1]
@@ -0,0 +1,145 @@
+"""Tests for the Monte Carlo tree search AI and its battle rollouts."""
+import contextlib
+import io
+import random
+import time
+
+from game.ai.ai_player import AIPlayer
+from game.ai.battle_rollout import BattleRollout
+from game.ai.mcts import MonteCarloTreeSearch
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.terrain import TerrainType
+from game.test_utils.mock_game_state import MockGameState
+
+
+def _make_state(width=20, height=20):
+    game_state = MockGameState(board_width=width, board_height=height)
+    game_state.fog_of_war = None
+    game_state._castles = []
+    return game_state
+
+
+def _add_unit(game_state, name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    game_state.add_knight(unit)
+    return unit
+
+
+def _random_battle(seed, width=30, height=24, units=20):
+    rng = random.Random(seed)
+    game_state = _make_state(width, height)
+    terrain_types = [TerrainType.PLAINS, TerrainType.FOREST, TerrainType.HILLS, TerrainType.WATER]
+    for y in range(height):
+        for x in range(width):
+            game_state.terrain_map.set_terrain(x, y, rng.choice(terrain_types))
+
+    classes = list(KnightClass)
+    tiles = rng.sample([(x, y) for x in range(width) for y in range(height)], units)
+    for i, (x, y) in enumerate(tiles):
+        game_state.terrain_map.set_terrain(x, y, TerrainType.PLAINS)
+        _add_unit(game_state, f"Unit {i}", classes[i % len(classes)], x, y, 1 + i % 2)
+    return game_state
+
+
+def test_native_and_python_rollouts_match():
+    assert C_EXTENSION_AVAILABLE, "C extension is required for rollout parity tests"
+    for seed in (3, 11):
+        game_state = _random_battle(seed)
+        native = BattleRollout(game_state, 2, AIPlayer.UNIT_BASE_VALUES, use_native=True)
+        python = BattleRollout(game_state, 2, AIPlayer.UNIT_BASE_VALUES, use_native=False)
+
+        assert native.play(game_state, rollouts=20, turns=4, seed=seed) == \
+            python.play(game_state, rollouts=20, turns=4, seed=seed)
+
+
+def test_rollout_damage_follows_combat_formulas():
+    game_state = _make_state()
+    target = _add_unit(game_state, "Target", KnightClass.WARRIOR, 6, 5, 1)
+    attacker = _add_unit(game_state, "Attacker", KnightClass.WARRIOR, 7, 5, 2)
+    # A routing target cannot strike back on its own turn, only counter
+    target.is_routing = True
+
+    attack = attacker.behaviors['attack']
+    terrain = game_state.terrain_map.get_terrain(7, 5)
+    assert target.facing.get_damage_modifier(target.facing.get_attack_angle(7, 5, 6, 5)) == 1.0
+    damage = attack.calculate_damage(attacker, target, terrain, terrain)
+    counter = attack.calculate_counter_damage(target, attacker, terrain, terrain)
+
+    reward = BattleRollout(game_state, 2, AIPlayer.UNIT_BASE_VALUES).play(game_state, turns=1)
+
+    value = AIPlayer.UNIT_BASE_VALUES[KnightClass.WARRIOR]
+    own_ratio = (value * (attacker.soldiers - counter) / attacker.soldiers) / (value * attacker.soldiers / attacker.soldiers)
+    enemy_ratio = (value * (target.soldiers - damage) / target.soldiers) / (value * target.soldiers / target.soldiers)
+    assert damage > 0 and counter > 0
+    assert reward == 0.5 + 0.5 * (own_ratio - enemy_ratio)
+
+
+def test_mcts_returns_legal_action():
+    game_state = _random_battle(5)
+    ai = AIPlayer(2, 'mcts')
+    ai._mcts = MonteCarloTreeSearch(ai, seed=1)
+
+    action = ai._mcts.search(game_state, 0, max_iterations=60)
+
+    legal = [(m[0], m[1], m[2], m[3]) if m[0] == 'move' else (m[0], m[1], m[2])
+             for m in ai.get_all_possible_moves(game_state)]
+    chosen = (action[0], action[1], action[2], action[3]) if action[0] == 'move' else action[:3]
+    assert chosen in legal
+    assert ai._mcts.iterations == 60
+
+
+def test_mcts_prefers_finishing_off_a_weak_unit():
+    game_state = _make_state()
+    archer = _add_unit(game_state, "Archer", KnightClass.ARCHER, 10, 10, 2)
+    # Enough AP to shoot or to move, not both
+    archer.action_points = archer.behaviors['attack'].get_ap_cost(archer)
+    weak = _add_unit(game_state, "Weak", KnightClass.ARCHER, 10, 12, 1)
+    weak.stats.stats.current_soldiers = 3
+    _add_unit(game_state, "Far", KnightClass.WARRIOR, 2, 2, 1)
+
+    ai = AIPlayer(2, 'mcts')
+    ai._mcts = MonteCarloTreeSearch(ai, seed=2)
+    # Playouts stop after the enemy's reply, so a later kill is worth nothing
+    ai._mcts.ROLLOUT_TURNS = 1
+    action = ai._mcts.search(game_state, 0, max_iterations=150)
+
+    assert action[0] == 'attack'
+    assert action[1] is archer and action[2] is weak
+
+
+def test_progressive_widening_generates_moves_lazily():
+    game_state = _make_state(40, 40)
+    for i in range(12):
+        _add_unit(game_state, f"Own {i}", KnightClass.WARRIOR, 3 + 3 * i, 30, 2)
+        _add_unit(game_state, f"Enemy {i}", KnightClass.WARRIOR, 3 + 3 * i, 10, 1)
+
+    ai = AIPlayer(2, 'mcts')
+    generated = []
+    original = ai.get_unit_moves
+    ai.get_unit_moves = lambda unit, state: generated.append(unit.name) or original(unit, state)
+    search = MonteCarloTreeSearch(ai, seed=3)
+    ai._mcts = search
+
+    search.search(game_state, 0, max_iterations=8)
+
+    root_units = {name for name in generated if name.startswith("Own")}
+    assert 0 < len(root_units) < 12
+
+
+def test_time_budget_bounds_search():
+    game_state = _random_battle(7)
+    ai = AIPlayer(2, 'mcts')
+    ai.thinking_time = 0.3
+
+    start = time.perf_counter()
+    with contextlib.redirect_stdout(io.StringIO()):
+        action = ai.choose_action(game_state)
+    elapsed = time.perf_counter() - start
+
+    assert action is not None
+    assert ai.nodes_searched > 0
+    # One iteration may overrun the deadline, not the whole search
+    assert elapsed < ai.thinking_time + 1.0
@@ -0,0 +1,128 @@
+"""Tests for the AI per-turn move generation cache."""
+from game.ai.ai_player import AIPlayer
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.test_utils.mock_game_state import MockGameState
+
+
+def _make_state():
+    game_state = MockGameState(board_width=30, board_height=30)
+    game_state.fog_of_war = None
+    game_state._castles = []
+    return game_state
+
+
+def _add_unit(game_state, name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    game_state.add_knight(unit)
+    return unit
+
+
+def _count_move_generation(unit, calls):
+    original = unit.get_possible_moves
+
+    def counting(*args, **kwargs):
+        calls.append(unit.name)
+        return original(*args, **kwargs)
+
+    unit.get_possible_moves = counting
+
+
+def _moves_by_unit(moves):
+    result = {}
+    for move in moves:
+        if move[0] == 'move':
+            result.setdefault(move[1].name, set()).add((move[2], move[3]))
+    return result
+
+
+def test_cached_moves_match_uncached_generation():
+    game_state = _make_state()
+    _add_unit(game_state, "West", KnightClass.WARRIOR, 3, 15, 2)
+    _add_unit(game_state, "East", KnightClass.CAVALRY, 26, 15, 2)
+    _add_unit(game_state, "Enemy", KnightClass.WARRIOR, 15, 3, 1)
+
+    ai = AIPlayer(2, 'easy')
+    uncached = ai.get_all_possible_moves(game_state)
+
+    ai._start_move_cache(game_state)
+    first = ai.get_all_possible_moves(game_state)
+    second = ai.get_all_possible_moves(game_state)
+
+    assert _moves_by_unit(first) == _moves_by_unit(uncached)
+    assert _moves_by_unit(second) == _moves_by_unit(uncached)
+
+
+def test_repeated_generation_skips_reachability_search():
+    game_state = _make_state()
+    west = _add_unit(game_state, "West", KnightClass.WARRIOR, 3, 15, 2)
+    east = _add_unit(game_state, "East", KnightClass.WARRIOR, 26, 15, 2)
+
+    calls = []
+    _count_move_generation(west, calls)
+    _count_move_generation(east, calls)
+
+    ai = AIPlayer(2, 'easy')
+    ai._start_move_cache(game_state)
+    ai.get_all_possible_moves(game_state)
+    assert sorted(calls) == ["East", "West"]
+
+    calls.clear()
+    ai.get_all_possible_moves(game_state)
+    assert calls == []
+
+
+def test_action_invalidates_only_units_within_reach():
+    game_state = _make_state()
+    west = _add_unit(game_state, "West", KnightClass.WARRIOR, 3, 15, 2)
+    east = _add_unit(game_state, "East", KnightClass.WARRIOR, 26, 15, 2)
+
+    calls = []
+    _count_move_generation(west, calls)
+    _count_move_generation(east, calls)
+
+    ai = AIPlayer(2, 'easy')
+    ai._start_move_cache(game_state)
+    ai.get_all_possible_moves(game_state)
+
+    calls.clear()
+    invalidated = ai._move_cache.note_action([(4, 15), (5, 16)])
+    ai.get_all_possible_moves(game_state)
+
+    assert invalidated == 1
+    assert calls == ["West"]
+
+
+def test_unit_state_change_misses_cache():
+    game_state = _make_state()
+    unit = _add_unit(game_state, "Mover", KnightClass.WARRIOR, 10, 10, 2)
+
+    ai = AIPlayer(2, 'easy')
+    ai._start_move_cache(game_state)
+    before = _moves_by_unit(ai.get_all_possible_moves(game_state))
+
+    unit.action_points = 2
+    after = _moves_by_unit(ai.get_all_possible_moves(game_state))
+
+    assert ai._move_cache.misses == 2
+    assert after["Mover"] < before["Mover"]
+
+
+def test_cache_only_applies_to_live_turn_state():
+    game_state = _make_state()
+    unit = _add_unit(game_state, "Mover", KnightClass.WARRIOR, 10, 10, 2)
+
+    calls = []
+    _count_move_generation(unit, calls)
+
+    ai = AIPlayer(2, 'easy')
+    ai.get_all_possible_moves(game_state)
+    ai.get_all_possible_moves(game_state)
+    assert len(calls) == 2
+
+    ai._start_move_cache(game_state)
+    ai._clear_move_cache()
+    ai.get_all_possible_moves(game_state)
+    assert len(calls) == 3
+    assert len(ai._move_cache) == 0
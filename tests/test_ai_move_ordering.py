@@ -0,0 +1,99 @@
+"""Tests and node-count benchmark for AI killer-move and history ordering."""
+import contextlib
+import io
+
+from game.ai.ai_player import AIPlayer
+from game.ai.move_ordering import MoveOrderingHeuristics
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.test_utils.scenario_battles import load_battle, seeded_random
+
+
+def _unit(name, unit_class, x, y, player_id=2):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    return unit
+
+
+def test_attacks_then_killers_then_history():
+    heuristics = MoveOrderingHeuristics()
+    warrior = _unit("Warrior", KnightClass.WARRIOR, 5, 5)
+    archer = _unit("Archer", KnightClass.ARCHER, 8, 5)
+    enemy = _unit("Enemy", KnightClass.WARRIOR, 6, 5, player_id=1)
+
+    quiet_a = ('move', warrior, 4, 4)
+    quiet_b = ('move', warrior, 4, 6)
+    quiet_c = ('move', archer, 9, 5)
+    attack = ('attack', warrior, enemy, 150)
+
+    heuristics.record_cutoff(quiet_b, ply=1, depth=2)
+    heuristics.record_cutoff(quiet_c, ply=0, depth=3)
+
+    ordered = heuristics.order_moves([quiet_a, quiet_b, quiet_c, attack], ply=1)
+
+    assert ordered[0] is attack
+    assert ordered[1] is quiet_b          # killer at ply 1
+    assert ordered[2] is quiet_c          # history score 9
+    assert ordered[3] is quiet_a
+
+
+def test_killer_slots_keep_most_recent_moves():
+    heuristics = MoveOrderingHeuristics()
+    unit = _unit("Warrior", KnightClass.WARRIOR, 5, 5)
+    moves = [('move', unit, 5 + i, 6) for i in range(3)]
+
+    for move in moves:
+        heuristics.record_cutoff(move, ply=0, depth=1)
+
+    killers = heuristics.get_killers(0)
+    assert len(killers) == MoveOrderingHeuristics.KILLER_SLOTS
+    assert killers[0] == MoveOrderingHeuristics.move_signature(moves[2])
+    assert killers[1] == MoveOrderingHeuristics.move_signature(moves[1])
+
+
+def test_history_is_shared_by_unit_class_and_tiles():
+    heuristics = MoveOrderingHeuristics()
+    first = _unit("First", KnightClass.CAVALRY, 3, 3)
+    clone = first.clone_for_simulation()
+    other = _unit("Other", KnightClass.CAVALRY, 3, 3)
+
+    heuristics.record_cutoff(('move', first, 4, 3), ply=0, depth=2)
+    heuristics.record_cutoff(('move', clone, 4, 3), ply=1, depth=1)
+
+    assert heuristics.get_history_score(('move', other, 4, 3)) == 5
+    assert heuristics.get_history_score(('move', other, 3, 4)) == 0
+
+
+def test_attacks_do_not_become_killers():
+    heuristics = MoveOrderingHeuristics()
+    attacker = _unit("Attacker", KnightClass.WARRIOR, 5, 5)
+    target = _unit("Target", KnightClass.WARRIOR, 6, 5, player_id=1)
+
+    heuristics.record_cutoff(('attack', attacker, target, 100), ply=0, depth=2)
+
+    assert heuristics.get_killers(0) == []
+
+
+def _search_nodes(use_search_heuristics, search_width):
+    """Nodes searched by two seeded medium-AI (depth 2) decisions on the smallest test scenario"""
+    ai = AIPlayer(2, 'medium', use_search_heuristics=use_search_heuristics)
+    ai.search_width = search_width
+    battle_state = load_battle("terrain_showcase")
+    with seeded_random(0), contextlib.redirect_stdout(io.StringIO()):
+        ai.choose_action(battle_state)
+        first = ai.nodes_searched
+        ai.choose_action(battle_state)
+    return first + ai.nodes_searched
+
+
+def test_move_ordering_reduces_search_nodes():
+    """Ordering on one small map; tools/move_ordering_benchmark.py compares every scenario"""
+    plain_width, ordered_width = AIPlayer.UNORDERED_SEARCH_WIDTH, AIPlayer.SEARCH_WIDTH
+    plain = _search_nodes(False, plain_width)
+    ordered = _search_nodes(True, plain_width)
+    ordered_wide = _search_nodes(True, ordered_width)
+
+    assert ordered < plain
+    # Ordering pays for the wider SEARCH_WIDTH: still fewer nodes than plain search at its width
+    assert ordered_width > plain_width
+    assert ordered_wide < plain
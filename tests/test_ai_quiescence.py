@@ -0,0 +1,127 @@
+"""Tests and node-count benchmark for the AI's quiescence search."""
+import contextlib
+import io
+
+from game.ai.ai_player import AIPlayer
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.test_utils.mock_game_state import MockGameState
+from game.test_utils.scenario_battles import load_battle, seeded_random
+
+
+def _make_state(width=16, height=16):
+    game_state = MockGameState(board_width=width, board_height=height)
+    game_state.fog_of_war = None
+    game_state._castles = []
+    return game_state
+
+
+def _add_unit(game_state, name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    game_state.add_knight(unit)
+    return unit
+
+
+def test_quiescence_sees_the_enemy_reply():
+    game_state = _make_state()
+    archer = _add_unit(game_state, "Archer", KnightClass.ARCHER, 8, 8, 2)
+    archer.stats.stats.current_soldiers = 10
+    _add_unit(game_state, "Cavalry", KnightClass.CAVALRY, 9, 8, 1)
+    _add_unit(game_state, "Far", KnightClass.WARRIOR, 2, 2, 1)
+    # Ours has already acted this turn; the enemy has not
+    archer.action_points = 0
+
+    ai = AIPlayer(2, 'medium')
+    ai._begin_search(game_state)
+    try:
+        stand_pat = ai.evaluate_position(game_state)
+        replies = ai.get_tactical_moves(game_state, own_side=False)
+        resolved = ai.quiescence(game_state, float('-inf'), float('inf'), True)
+    finally:
+        ai._end_search()
+
+    assert ai.get_tactical_moves(game_state, own_side=True) == []
+    assert {(m[0], m[1].name) for m in replies} == {('attack', "Cavalry"), ('charge', "Cavalry")}
+    assert resolved < stand_pat
+
+
+def test_quiet_position_passes_to_a_standing_pat_enemy():
+    game_state = _make_state()
+    _add_unit(game_state, "Warrior", KnightClass.WARRIOR, 3, 3, 2)
+    _add_unit(game_state, "Enemy", KnightClass.WARRIOR, 12, 12, 1)
+
+    ai = AIPlayer(2, 'medium')
+    ai._begin_search(game_state)
+    try:
+        assert ai.quiescence(game_state, float('-inf'), float('inf'), True) == ai.evaluate_position(game_state)
+    finally:
+        ai._end_search()
+    # Our pass, then the enemy's stand pat
+    assert ai.nodes_searched == 2
+
+
+def test_enemy_charge_reply_is_simulated():
+    game_state = _make_state()
+    warrior = _add_unit(game_state, "Warrior", KnightClass.WARRIOR, 8, 8, 2)
+    cavalry = _add_unit(game_state, "Cavalry", KnightClass.CAVALRY, 7, 8, 1)
+    cavalry.action_points = 0
+
+    ai = AIPlayer(2, 'medium')
+    charge = next(m for m in ai.get_tactical_moves(game_state, own_side=False) if m[0] == 'charge')
+    after = ai._simulate_move(game_state, charge)
+
+    charged = next(k for k in after.knights if k.name == "Warrior")
+    charger = next(k for k in after.knights if k.name == "Cavalry")
+    assert charged.soldiers < warrior.soldiers
+    assert charged.morale < warrior.morale
+    assert charger.soldiers < cavalry.soldiers
+    assert charger.has_used_special
+    # The live units are untouched
+    assert cavalry.action_points == 0 and not cavalry.has_used_special
+
+
+def test_enemy_replies_use_the_attack_behavior_range():
+    game_state = _make_state()
+    _add_unit(game_state, "Archer", KnightClass.ARCHER, 8, 8, 1)
+    _add_unit(game_state, "Diagonal", KnightClass.WARRIOR, 11, 11, 2)
+    _add_unit(game_state, "Beyond", KnightClass.WARRIOR, 12, 8, 2)
+
+    ai = AIPlayer(2, 'medium')
+    replies = ai.get_tactical_moves(game_state, own_side=False)
+
+    # Range 3 in Chebyshev distance, as AttackBehavior.execute measures it
+    assert {(m[0], m[2].name) for m in replies} == {('attack', "Diagonal")}
+
+
+def test_node_budget_bounds_each_leaf():
+    game_state = _make_state()
+    for i in range(4):
+        _add_unit(game_state, f"Own {i}", KnightClass.WARRIOR, 4 + 2 * i, 8, 2)
+        _add_unit(game_state, f"Enemy {i}", KnightClass.CAVALRY, 4 + 2 * i, 9, 1)
+
+    ai = AIPlayer(2, 'medium')
+    ai.QUIESCENCE_NODE_BUDGET = 5
+    ai._begin_search(game_state)
+    try:
+        ai._quiescence_nodes = 0
+        ai.quiescence(game_state, float('-inf'), float('inf'), False)
+    finally:
+        ai._end_search()
+
+    assert ai.get_tactical_moves(game_state, own_side=False)
+    assert ai._quiescence_nodes == ai.QUIESCENCE_NODE_BUDGET
+    assert ai.nodes_searched == ai.QUIESCENCE_NODE_BUDGET
+
+
+def _search_nodes(difficulty, use_quiescence):
+    ai = AIPlayer(2, difficulty, use_quiescence=use_quiescence)
+    with seeded_random(0), contextlib.redirect_stdout(io.StringIO()):
+        ai.choose_action(load_battle("archer_line_of_sight"))
+    return ai.nodes_searched
+
+
+def test_quiescent_search_costs_fewer_nodes_than_a_full_extra_ply():
+    """Depth 1 with quiescence against plain depth 2 on one small map; the depth 2
+    against depth 3 comparison over every scenario is in tools/move_ordering_benchmark.py"""
+    assert _search_nodes('easy', use_quiescence=True) < _search_nodes('medium', use_quiescence=False)
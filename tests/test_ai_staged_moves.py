@@ -0,0 +1,157 @@
+"""Tests and reachability benchmark for the AI's lazy staged move generator."""
+import contextlib
+import io
+
+from game.ai.ai_player import AIPlayer
+from game.ai.move_ordering import MoveOrderingHeuristics
+from game.ai.staged_moves import StagedMoveGenerator
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.test_utils.mock_game_state import MockGameState
+from game.test_utils.scenario_battles import load_battle, loadable_scenarios
+
+
+def _make_state():
+    game_state = MockGameState(board_width=30, board_height=30)
+    game_state.fog_of_war = None
+    game_state._castles = []
+    return game_state
+
+
+def _add_unit(game_state, name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    game_state.add_knight(unit)
+    return unit
+
+
+def _count_move_generation(unit, calls):
+    original = unit.get_possible_moves
+
+    def counting(*args, **kwargs):
+        calls.append(unit.name)
+        return original(*args, **kwargs)
+
+    unit.get_possible_moves = counting
+
+
+def _signatures(moves):
+    return {MoveOrderingHeuristics.move_signature(move) for move in moves}
+
+
+def _skirmish():
+    game_state = _make_state()
+    attacker = _add_unit(game_state, "Attacker", KnightClass.WARRIOR, 10, 10, 2)
+    west = _add_unit(game_state, "West", KnightClass.WARRIOR, 3, 20, 2)
+    east = _add_unit(game_state, "East", KnightClass.CAVALRY, 25, 20, 2)
+    enemy = _add_unit(game_state, "Enemy", KnightClass.WARRIOR, 11, 10, 1)
+    return game_state, attacker, west, east, enemy
+
+
+def test_full_iteration_matches_all_possible_moves():
+    game_state, *_ = _skirmish()
+    ai = AIPlayer(2, 'medium')
+
+    staged = list(StagedMoveGenerator(ai, game_state, MoveOrderingHeuristics()))
+
+    assert len(staged) == len(_signatures(staged))
+    assert _signatures(staged) == _signatures(ai.get_all_possible_moves(game_state))
+
+
+def test_attacks_come_first_without_reachability_search():
+    game_state, attacker, west, east, enemy = _skirmish()
+    calls = []
+    for unit in (attacker, west, east):
+        _count_move_generation(unit, calls)
+
+    generator = StagedMoveGenerator(AIPlayer(2, 'medium'), game_state, MoveOrderingHeuristics())
+    first = next(iter(generator))
+
+    assert first[0] == 'attack' and first[2] is enemy
+    assert calls == []
+    assert generator.units_expanded == 0
+
+
+def test_killer_follows_attacks_and_is_not_repeated():
+    game_state, attacker, west, east, _ = _skirmish()
+    heuristics = MoveOrderingHeuristics()
+    killer = ('move', west, 4, 20)
+    heuristics.record_cutoff(killer, ply=1, depth=1)
+    calls = []
+    for unit in (attacker, west, east):
+        _count_move_generation(unit, calls)
+
+    generator = iter(StagedMoveGenerator(AIPlayer(2, 'medium'), game_state, heuristics, ply=1))
+    first, second = next(generator), next(generator)
+
+    assert first[0] == 'attack'
+    assert MoveOrderingHeuristics.move_signature(second) == MoveOrderingHeuristics.move_signature(killer)
+    assert calls == ["West"]  # Only the killer's unit was expanded
+
+    rest = list(generator)
+    assert MoveOrderingHeuristics.move_signature(killer) not in _signatures(rest)
+
+
+def test_quiet_units_are_visited_by_history_and_expanded_lazily():
+    game_state, attacker, west, east, _ = _skirmish()
+    heuristics = MoveOrderingHeuristics()
+    heuristics.record_cutoff(('move', east, 24, 20), ply=0, depth=3)
+    calls = []
+    for unit in (attacker, west, east):
+        _count_move_generation(unit, calls)
+
+    generator = StagedMoveGenerator(AIPlayer(2, 'medium'), game_state, heuristics, ply=5)
+    quiet = [move for move in generator if move[0] == 'move']
+
+    assert quiet[0][1] is east and (quiet[0][2], quiet[0][3]) == (24, 20)
+    assert calls[0] == "East"
+    assert generator.units_expanded == 3
+
+
+def test_unordered_generation_keeps_unit_order():
+    game_state, attacker, west, east, _ = _skirmish()
+
+    moves = list(StagedMoveGenerator(AIPlayer(2, 'medium'), game_state))
+    quiet_units = []
+    for move in moves:
+        if move[0] == 'move' and move[1] not in quiet_units:
+            quiet_units.append(move[1])
+
+    assert moves[0][0] == 'attack'
+    assert quiet_units == [attacker, west, east]
+
+
+def _search_with_eager_count(ai, battle_state):
+    """Run one decision; return how many units full generation would have expanded"""
+    eager = 0
+    original = ai.minimax
+
+    def counting(game_state, depth, *args, **kwargs):
+        nonlocal eager
+        if depth > 0:
+            eager += sum(1 for k in game_state.knights if k.player_id == ai.player_id and k.can_move())
+        return original(game_state, depth, *args, **kwargs)
+
+    ai.minimax = counting
+    with contextlib.redirect_stdout(io.StringIO()):
+        ai.choose_action(battle_state)
+    return eager
+
+
+def test_staged_generation_skips_reachability_on_test_scenarios():
+    """Benchmark: units expanded with staged versus eager move generation"""
+    scenarios = loadable_scenarios()
+    assert scenarios
+
+    total_eager = 0
+    total_staged = 0
+    print(f"\n{'Scenario':<24}{'Eager':>8}{'Staged':>8}")
+    for name in scenarios:
+        ai = AIPlayer(2, 'medium')
+        eager = _search_with_eager_count(ai, load_battle(name))
+        print(f"{name:<24}{eager:>8}{ai.units_expanded:>8}")
+        total_eager += eager
+        total_staged += ai.units_expanded
+
+    print(f"{'Total':<24}{total_eager:>8}{total_staged:>8}")
+    assert total_staged < total_eager
@@ -0,0 +1,146 @@
+"""Tests for the parallel campaign AI turn engine."""
+import dataclasses
+import random
+
+import pytest
+
+from game.campaign.campaign_ai import (
+    ArmyOrder, CampaignAIEngine, CampaignAIPlanner, CampaignSnapshot, CountryPlan, offset_distance,
+)
+from game.campaign.campaign_state import Army, CampaignState, City
+from game.campaign.campaign_terrain import CampaignTerrainMap, CampaignTerrainType
+from game.hex_utils import HexCoord
+
+
+def _army(army_id, country, x, y, knights=5, archers=3, cavalry=2):
+    return Army(id=army_id, country=country, position=HexCoord(x, y),
+                knights=knights, archers=archers, cavalry=cavalry, movement_points=3)
+
+
+def _city(name, country, x, y, income=50):
+    return City(name, country, HexCoord(x, y), "city", income, 1, 5000, "trade", "")
+
+
+def _skirmish_campaign(seed=4, width=40, height=30):
+    """Plains map where every country holds a few cities and armies"""
+    rng = random.Random(seed)
+    campaign = CampaignState(player_country="poland")
+    campaign.armies.clear()
+    campaign.cities.clear()
+    campaign.terrain_map = CampaignTerrainMap(width, height)
+    campaign.terrain_map.fill_rects(CampaignTerrainType.PLAINS, [[0, width, 0, height]])
+    for country in campaign.countries:
+        campaign.country_treasury[country] = rng.randrange(0, 1500)
+        for i in range(3):
+            campaign.cities[f"{country}_{i}"] = _city(f"{country}_{i}", country,
+                                                      rng.randrange(width), rng.randrange(height))
+            campaign.armies[f"{country}_a{i}"] = _army(f"{country}_a{i}", country, rng.randrange(width),
+                                                       rng.randrange(height), knights=rng.randrange(2, 9))
+    return campaign
+
+
+def _state(campaign):
+    armies = sorted((army_id, army.country, army.position.q, army.position.r, army.movement_points,
+                     army.knights, army.archers, army.cavalry) for army_id, army in campaign.armies.items())
+    return armies, dict(campaign.country_treasury)
+
+
+def test_parallel_and_serial_planning_commit_the_same_turn():
+    serial, parallel = _skirmish_campaign(), _skirmish_campaign()
+
+    serial_report = CampaignAIEngine(max_workers=1).play_turn(serial)
+    parallel_report = CampaignAIEngine(max_workers=4).play_turn(parallel)
+
+    assert serial_report.applied_moves and serial_report.applied_recruits
+    assert serial_report.applied_moves == parallel_report.applied_moves
+    assert serial_report.rejected_moves == parallel_report.rejected_moves
+    assert serial_report.applied_recruits == parallel_report.applied_recruits
+    assert _state(serial) == _state(parallel)
+    assert set(parallel_report.planning_seconds) == set(CampaignAIEngine.ai_countries(parallel))
+    assert all(seconds >= 0 for seconds in parallel_report.planning_seconds.values())
+
+
+def test_planned_moves_head_for_the_nearest_enemy_city():
+    campaign = _skirmish_campaign()
+    snapshot = CampaignSnapshot.capture(campaign)
+    plan = CampaignAIPlanner().plan(snapshot, "hungary")
+
+    enemy_cities = [city.position for city in snapshot.cities.values() if city.country != "hungary"]
+    for order in plan.moves:
+        army = snapshot.armies[order.army_id]
+        nearest = min(offset_distance(army.position, city) for city in enemy_cities)
+        assert army.strength >= 8 and 1 <= order.cost <= army.movement_points
+        assert min(offset_distance(order.target, city) for city in enemy_cities) < nearest
+    assert len({order.target for order in plan.moves}) == len(plan.moves)
+
+
+def test_snapshot_is_isolated_from_the_live_campaign():
+    campaign = _skirmish_campaign()
+    position = campaign.armies["france_a0"].position
+    snapshot = CampaignSnapshot.capture(campaign)
+    campaign.armies["france_a0"].position = HexCoord(position.q + 1, position.r)
+    campaign.armies["france_a0"].knights = 0
+    campaign.country_treasury["france"] = -1
+
+    assert snapshot.armies["france_a0"].position == position
+    assert snapshot.armies["france_a0"].knights > 0
+    assert snapshot.country_treasury["france"] != -1
+    with pytest.raises(dataclasses.FrozenInstanceError):
+        snapshot.armies["france_a0"].knights = 99
+    with pytest.raises(TypeError):
+        snapshot.armies["new"] = snapshot.armies["france_a0"]
+
+
+def test_commit_resolves_contested_hexes_by_strength_then_country_order():
+    campaign = _skirmish_campaign()
+    campaign.armies.clear()
+    campaign.cities.clear()
+    campaign.armies.update(weak=_army("weak", "france", 10, 10, knights=2),
+                           strong=_army("strong", "england", 12, 10, knights=9),
+                           twin=_army("twin", "denmark", 11, 12, knights=9))
+    target = HexCoord(11, 10)
+
+    def order(army_id):
+        army = campaign.armies[army_id]
+        return ArmyOrder(army_id, army.country, army.position, target, 1.0,
+                         army.knights + army.archers + army.cavalry)
+
+    plans = {country: CountryPlan(country) for country in ("france", "england", "denmark")}
+    for army_id in ("weak", "strong", "twin"):
+        plans[campaign.armies[army_id].country].moves.append(order(army_id))
+
+    report = CampaignAIEngine(max_workers=1).commit(campaign, plans)
+    assert [o.army_id for o in report.applied_moves] == ["strong"]
+    assert sorted((o.army_id, reason) for o, reason in report.rejected_moves) == [
+        ("twin", "contested"), ("weak", "contested")]
+    assert campaign.armies["strong"].position == target
+    assert campaign.armies["weak"].position == HexCoord(10, 10)
+
+
+def test_recruitment_keeps_the_reserve_and_survives_a_changed_treasury():
+    campaign = _skirmish_campaign()
+    campaign.country_treasury["venice"] = 200 + 2 * 260 + 100
+    snapshot = CampaignSnapshot.capture(campaign)
+    plan = CampaignAIPlanner(reserve_gold=200).plan(snapshot, "venice")
+    assert [order.cost for order in plan.recruits] == [260, 260]
+    incomes = [snapshot.cities[order.city_key].income for order in plan.recruits]
+    assert incomes == sorted(incomes, reverse=True)
+
+    campaign.country_treasury["venice"] = 300
+    report = CampaignAIEngine(max_workers=1).commit(campaign, {"venice": plan})
+    assert len(report.applied_recruits) == 1 and len(report.rejected_recruits) == 1
+    assert campaign.country_treasury["venice"] == 40
+
+
+def test_play_ai_turns_hands_control_back_to_the_player():
+    campaign = _skirmish_campaign()
+    campaign.end_turn()
+    assert campaign.current_country != "poland"
+    before = {army_id: army.position for army_id, army in campaign.armies.items() if army.country == "poland"}
+
+    report = campaign.play_ai_turns()
+
+    assert campaign.current_country == "poland"
+    assert "poland" not in report.plans
+    assert {army_id: army.position for army_id, army in campaign.armies.items()
+            if army.country == "poland"} == before
@@ -2,7 +2,7 @@ import pytest
 import pygame
 import time
 from game.ui.campaign_screen import CampaignScreen
-from game.campaign.campaign_state import CampaignState, City, Country, Army
+from game.campaign.campaign_state import CampaignState, City, Country, Army, CampaignTerrainType
 from game.hex_utils import HexCoord
 
 
@@ -62,6 +62,9 @@ def campaign_screen_with_data(pygame_setup):
     )
     campaign_screen.campaign_state.armies["test_army"] = test_army
     
+    # Open ground around the army, so a one hex move costs one movement point
+    campaign_screen.campaign_state.terrain_map.fill_rects(CampaignTerrainType.PLAINS, [[9, 15, 9, 14]])
+    
     # Set test country as current
     campaign_screen.campaign_state.current_country = "test_country"
     campaign_screen.campaign_state.player_country = "test_country"
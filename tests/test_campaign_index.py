@@ -0,0 +1,75 @@
+"""Tests for the per-hex and per-country index of campaign cities and armies."""
+import copy
+import random
+
+from game.campaign.campaign_index import CampaignIndex
+from game.campaign.campaign_state import Army, CampaignState, City
+from game.hex_utils import HexCoord
+
+
+def _army(army_id, country, q, r):
+    return Army(id=army_id, country=country, position=HexCoord(q, r),
+                knights=5, archers=3, cavalry=2, movement_points=3)
+
+
+def _ids(armies):
+    return sorted(army.id for army in armies)
+
+
+def test_index_follows_every_mutation_path():
+    rng = random.Random(3)
+    armies = CampaignIndex()
+    countries = ("poland", "hungary", "bohemia")
+    for step in range(400):
+        army_id = f"a{rng.randrange(40)}"
+        action = rng.random()
+        if action < 0.35:
+            armies[army_id] = _army(army_id, rng.choice(countries), rng.randrange(8), rng.randrange(8))
+        elif action < 0.45 and army_id in armies:
+            del armies[army_id]
+        elif army_id in armies and action < 0.8:
+            armies[army_id].position = HexCoord(rng.randrange(8), rng.randrange(8))
+        elif army_id in armies:
+            armies[army_id].country = rng.choice(countries)
+
+        for q in range(8):
+            for r in range(8):
+                assert _ids(armies.at(HexCoord(q, r))) == _ids(
+                    a for a in armies.values() if a.position == HexCoord(q, r))
+        for country in countries:
+            assert _ids(armies.owned_by(country)) == _ids(a for a in armies.values() if a.country == country)
+
+    assert _ids(armies.in_area(2, 5, 1, 7)) == _ids(
+        a for a in armies.values() if 2 <= a.position.q < 5 and 1 <= a.position.r < 7)
+    assert _ids(armies.in_area(0, 8, 0, 8)) == sorted(armies)
+
+
+def test_removed_armies_stop_updating_the_index():
+    armies = CampaignIndex({"a": _army("a", "poland", 1, 1)})
+    army = armies["a"]
+    del armies["a"]
+    army.position = HexCoord(2, 2)
+    assert armies.at(HexCoord(2, 2)) == [] and len(armies) == 0
+
+    armies["a"] = army
+    armies.clear()
+    army.country = "hungary"
+    assert armies.owned_by("hungary") == []
+
+
+def test_campaign_state_keeps_assigned_dicts_indexed():
+    campaign = CampaignState(player_country="poland")
+    campaign.armies = {"x": _army("x", "poland", 4, 4), "y": _army("y", "hungary", 5, 4)}
+    campaign.cities["buda"] = City("Buda", "hungary", HexCoord(5, 4), "capital", 100, 3, 1000, "trade", "")
+
+    assert isinstance(campaign.armies, CampaignIndex)
+    assert [a.id for a in campaign.get_country_armies("poland")] == ["x"]
+    assert campaign.get_country_cities("hungary") == [campaign.cities["buda"]]
+
+    campaign.cities["buda"].country = "poland"
+    assert campaign.cities["buda"] in campaign.get_country_cities("poland")
+
+    clone = copy.deepcopy(campaign.armies)
+    clone["x"].position = HexCoord(9, 9)
+    assert [a.id for a in clone.at(HexCoord(9, 9))] == ["x"]
+    assert campaign.armies.at(HexCoord(9, 9)) == []
@@ -0,0 +1,84 @@
+"""Tests for the binary campaign map format."""
+import glob
+import json
+import os
+
+import pytest
+
+from game.campaign.campaign_map_file import HEADER, CampaignMapFile, read_header, write_campaign_map
+from game.campaign.campaign_state import CampaignState
+
+DATA_DIR = os.path.join(os.path.dirname(__file__), '..', 'game', 'campaign', 'data')
+
+
+def _same_campaign(a, b):
+    assert (a.map_width, a.map_height, a.hex_size_km) == (b.map_width, b.map_height, b.hex_size_km)
+    assert a.terrain_map.cells == b.terrain_map.cells
+    assert a.countries == b.countries and a.cities == b.cities
+    assert list(a.cities) == list(b.cities)
+    assert a.neutral_regions == b.neutral_regions
+
+
+def test_binary_map_round_trips_the_json_campaign(tmp_path):
+    source = os.path.join(DATA_DIR, 'medieval_europe.json')
+    from_json = CampaignState(map_file=source)
+    path = str(tmp_path / 'europe.cmap')
+    with open(source, encoding='utf-8') as f:
+        write_campaign_map(path, json.load(f), (-10.0, 40.0, 35.0, 70.0))
+
+    header = read_header(path)
+    assert (header.width, header.height) == (from_json.map_width, from_json.map_height)
+    assert header.bounds == (-10.0, 40.0, 35.0, 70.0)
+    assert (header.city_count, header.country_count) == (len(from_json.cities), len(from_json.countries))
+
+    from_binary = CampaignState(map_file=path)
+    _same_campaign(from_json, from_binary)
+    assert from_binary.map_data['bounds'] == header.bounds
+
+
+def test_corrupt_or_foreign_files_are_rejected(tmp_path):
+    source = os.path.join(DATA_DIR, 'medieval_europe.json')
+    path = tmp_path / 'europe.cmap'
+    with open(source, encoding='utf-8') as f:
+        write_campaign_map(str(path), json.load(f))
+    data = bytearray(path.read_bytes())
+    data[-1] ^= 0xFF
+    path.write_bytes(bytes(data))
+
+    assert read_header(str(path)).bounds is None
+    with pytest.raises(ValueError, match="checksum"):
+        CampaignMapFile(str(path))
+    with CampaignMapFile(str(path), verify=False) as map_file:
+        assert map_file.terrain_map().width == map_file.header.width
+
+    foreign = tmp_path / 'other.cmap'
+    foreign.write_bytes(b'{"map": {}}' + bytes(200))
+    with pytest.raises(ValueError, match="not a campaign map"):
+        read_header(str(foreign))
+
+
+def test_city_text_must_match_the_city_count(tmp_path):
+    source = os.path.join(DATA_DIR, 'medieval_europe.json')
+    path = tmp_path / 'europe.cmap'
+    with open(source, encoding='utf-8') as f:
+        write_campaign_map(str(path), json.load(f))
+    data = path.read_bytes()
+    header = read_header(str(path))
+    meta_offset, meta_size = header.meta
+    meta = json.loads(data[meta_offset:meta_offset + meta_size])
+    meta['cities'].pop()
+    short_meta = json.dumps(meta).encode('utf-8')
+    # Meta is the last section, so only its size in the header changes
+    fields = list(HEADER.unpack_from(data))
+    fields[-2] = len(short_meta)
+    path.write_bytes(HEADER.pack(*fields) + data[HEADER.size:meta_offset] + short_meta)
+
+    with CampaignMapFile(str(path), verify=False) as map_file:
+        with pytest.raises(ValueError, match="city count"):
+            list(map_file.cities())
+
+
+@pytest.mark.parametrize("binary_path", sorted(glob.glob(os.path.join(DATA_DIR, '*.cmap'))))
+def test_shipped_binary_maps_match_their_json(binary_path):
+    json_path = os.path.splitext(binary_path)[0] + '.json'
+    _same_campaign(CampaignState(map_file=json_path), CampaignState(map_file=binary_path))
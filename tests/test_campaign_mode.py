@@ -1,6 +1,6 @@
 import pytest
 import pygame
-from game.campaign.campaign_state import CampaignState, Country, Army, City
+from game.campaign.campaign_state import CampaignState, Country, Army, City, CampaignTerrainType
 from game.campaign.campaign_renderer import CampaignRenderer
 from game.ui.campaign_screen import CampaignScreen
 from game.hex_utils import HexCoord
@@ -137,6 +137,7 @@ class TestCampaignMode:
         )
         state.armies["test_army"] = army
         state.current_country = "poland"
+        state.terrain_map.fill_rects(CampaignTerrainType.PLAINS, [[10, 12, 10, 11]])
         
         original_pos = army.position
         
@@ -396,6 +397,7 @@ class TestCampaignMode:
         )
         state.armies["test_army"] = test_army
         state.current_country = "poland"
+        state.terrain_map.fill_rects(CampaignTerrainType.PLAINS, [[24, 29, 17, 22]])
         
         # Test 1-hex movement (distance = 1)
         target1 = HexCoord(26, 20)  # 1 hex east
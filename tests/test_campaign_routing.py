@@ -0,0 +1,101 @@
+"""Tests for terrain-aware campaign army routing."""
+import math
+import random
+
+import pytest
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.campaign.campaign_routing import (
+    CAMPAIGN_MOVEMENT_COSTS, _EVEN_ROW_DIRS, _ODD_ROW_DIRS,
+)
+from game.campaign.campaign_state import Army, CampaignState, City
+from game.campaign.campaign_terrain import CampaignTerrainMap, CampaignTerrainType
+from game.hex_utils import HexCoord
+
+
+def _army(army_id, country, x, y, movement_points=3):
+    return Army(id=army_id, country=country, position=HexCoord(x, y),
+                knights=5, archers=3, cavalry=2, movement_points=movement_points)
+
+
+def _plains_campaign(width=20, height=16):
+    campaign = CampaignState(player_country="poland")
+    campaign.armies.clear()
+    campaign.cities.clear()
+    campaign.terrain_map = CampaignTerrainMap(width, height)
+    campaign.terrain_map.fill_rects(CampaignTerrainType.PLAINS, [[0, width, 0, height]])
+    return campaign
+
+
+def _is_hex_path(start, path):
+    for a, b in zip([start] + path, path):
+        dirs = _EVEN_ROW_DIRS if a.r % 2 == 0 else _ODD_ROW_DIRS
+        if (b.q - a.q, b.r - a.r) not in dirs:
+            return False
+    return True
+
+
+@pytest.mark.skipif(not C_EXTENSION_AVAILABLE, reason="C extension not built")
+def test_native_and_python_routes_cost_the_same():
+    rng = random.Random(8)
+    campaign = _plains_campaign(31, 23)
+    terrain_types = list(CampaignTerrainType)
+    for y in range(23):
+        for x in range(31):
+            campaign.terrain_map[(x, y)] = rng.choice(terrain_types)
+    for i in range(6):
+        campaign.armies[f"own_{i}"] = _army(f"own_{i}", "poland", rng.randrange(31), rng.randrange(23))
+        campaign.armies[f"foe_{i}"] = _army(f"foe_{i}", "hungary", rng.randrange(31), rng.randrange(23))
+    campaign.cities["foe_city"] = City("Buda", "hungary", HexCoord(15, 11), "capital", 100, 3, 1000, "trade", "")
+
+    native = campaign.router.plan_country("poland", budget=12, use_native=True)
+    python = campaign.router.plan_country("poland", budget=12, use_native=False)
+
+    assert sorted(native) == [f"own_{i}" for i in range(6)]
+    for army_id, routes in native.items():
+        assert routes.reachable() == python[army_id].reachable()
+        for target, cost in routes.reachable().items():
+            path = routes.path_to(target)
+            assert _is_hex_path(routes.start, path) and path[-1] == target
+            assert sum(CAMPAIGN_MOVEMENT_COSTS[campaign.terrain_map[(h.q, h.r)]] for h in path) == cost
+
+
+@pytest.mark.parametrize("use_native", [
+    False, pytest.param(True, marks=pytest.mark.skipif(not C_EXTENSION_AVAILABLE, reason="C extension not built"))])
+def test_terrain_sets_the_cost_and_water_blocks(use_native):
+    campaign = _plains_campaign()
+    campaign.terrain_map.fill_rects(CampaignTerrainType.FOREST, [[6, 7, 0, 16]])
+    campaign.terrain_map.fill_rects(CampaignTerrainType.WATER, [[10, 11, 0, 16]])
+    army = _army("army", "poland", 4, 4, movement_points=3)
+    campaign.armies["army"] = army
+
+    routes = campaign.router.plan_army(army, use_native=use_native)
+    assert routes.cost_to(HexCoord(5, 4)) == 1
+    assert routes.cost_to(HexCoord(6, 4)) == 3
+    assert not routes.can_reach(HexCoord(7, 4))
+    assert not campaign.router.plan_army(army, budget=math.inf, use_native=use_native).can_reach(HexCoord(12, 4))
+
+    assert campaign.move_army("army", HexCoord(6, 4))
+    assert army.movement_points == 0
+
+
+@pytest.mark.parametrize("use_native", [
+    False, pytest.param(True, marks=pytest.mark.skipif(not C_EXTENSION_AVAILABLE, reason="C extension not built"))])
+def test_enemy_zone_of_control_ends_movement(use_native):
+    campaign = _plains_campaign()
+    army = _army("army", "poland", 4, 6)
+    enemy = _army("enemy", "hungary", 7, 6)
+    campaign.armies.update(army=army, enemy=enemy, friend=_army("friend", "poland", 5, 6))
+
+    routes = campaign.router.plan_army(army, use_native=use_native)
+    assert routes.cost_to(HexCoord(6, 6)) == 2  # past a friendly army, into the enemy's zone
+    assert routes.path_to(HexCoord(6, 6)) == [HexCoord(5, 6), HexCoord(6, 6)]
+    assert not routes.can_reach(HexCoord(7, 6))  # the enemy itself is only in reach from its zone
+
+    # An army starting inside a zone of control may leave it
+    enemy.position = HexCoord(4, 5)
+    assert campaign.router.plan_army(army, use_native=use_native).cost_to(HexCoord(3, 6)) == 1
+
+    assert not campaign.move_army("army", HexCoord(5, 3))
+    assert campaign.move_army("army", HexCoord(4, 5))
+    assert army.movement_points == 2
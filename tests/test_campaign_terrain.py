@@ -0,0 +1,68 @@
+"""Tests for the dense campaign terrain grid."""
+import random
+
+import pytest
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.campaign.campaign_state import CampaignState
+from game.campaign.campaign_terrain import (
+    CAMPAIGN_TERRAIN_CODES, CampaignTerrainMap, CampaignTerrainType,
+)
+
+
+def test_grid_reads_and_writes_like_the_terrain_dict():
+    terrain_map = CampaignTerrainMap(6, 4)
+    terrain_map[(2, 1)] = CampaignTerrainType.FOREST
+    terrain_map[(5, 3)] = CampaignTerrainType.WATER
+
+    assert terrain_map[(2, 1)] is CampaignTerrainType.FOREST
+    assert terrain_map.get((0, 0)) is None and terrain_map.get((9, 9), "off") == "off"
+    assert (5, 3) in terrain_map and (0, 0) not in terrain_map
+    assert dict(terrain_map) == {(2, 1): CampaignTerrainType.FOREST, (5, 3): CampaignTerrainType.WATER}
+    assert terrain_map.cells[1 * 6 + 2] == CAMPAIGN_TERRAIN_CODES[CampaignTerrainType.FOREST]
+
+    snapshot = terrain_map.snapshot()
+    del terrain_map[(2, 1)]
+    assert len(terrain_map) == 1
+    terrain_map.restore(snapshot)
+    assert len(terrain_map) == 2
+
+    with pytest.raises(KeyError):
+        terrain_map[(6, 0)] = CampaignTerrainType.PLAINS
+    with pytest.raises(ValueError):
+        terrain_map[(1, 1)] = "forest"
+
+
+@pytest.mark.parametrize("use_native", [
+    False, pytest.param(True, marks=pytest.mark.skipif(not C_EXTENSION_AVAILABLE, reason="C extension not built"))])
+def test_rectangle_runs_match_per_hex_expansion(use_native):
+    rng = random.Random(5)
+    width, height = 23, 17
+    terrain_map = CampaignTerrainMap(width, height)
+    expected = {}
+    for terrain_type in (CampaignTerrainType.PLAINS, CampaignTerrainType.HILLS, CampaignTerrainType.SNOW):
+        rects = []
+        for _ in range(30):
+            min_x, min_y = rng.randint(-3, width), rng.randint(-3, height)
+            rects.append([min_x, min_x + rng.randint(0, 6), min_y, min_y + rng.randint(0, 6)])
+        terrain_map.fill_rects(terrain_type, rects, use_native=use_native)
+        for min_x, max_x, min_y, max_y in rects:
+            for x in range(min_x, max_x):
+                for y in range(min_y, max_y):
+                    if 0 <= x < width and 0 <= y < height:
+                        expected[(x, y)] = terrain_type
+
+    assert dict(terrain_map) == expected
+    with pytest.raises(ValueError):
+        terrain_map.fill_rects(CampaignTerrainType.PLAINS, [[0, 1, 0]], use_native=use_native)
+
+
+def test_campaign_loads_terrain_into_the_grid():
+    campaign = CampaignState()
+
+    assert isinstance(campaign.terrain_map, CampaignTerrainMap)
+    assert (campaign.terrain_map.width, campaign.terrain_map.height) == (campaign.map_width, campaign.map_height)
+    for name, regions in campaign.map_data['terrain'].items():
+        min_x, max_x, min_y, max_y = regions[-1]
+        if min_x < max_x and min_y < max_y:
+            assert campaign.terrain_map.get((max_x - 1, max_y - 1)) is not None
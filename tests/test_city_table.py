@@ -0,0 +1,122 @@
+"""Tests for the columnar city table and its whole-column end-turn kernels."""
+import copy
+import random
+from array import array
+
+import pytest
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.campaign.campaign_state import CampaignState, City
+from game.campaign.city_specialization import CitySpecialization
+from game.campaign.city_table import (
+    CityIndex, CityTable, group_sums_python, stream_uniform, turn_stream_key,
+)
+from game.campaign.end_turn_steps.base import EndTurnContext
+from game.campaign.end_turn_steps.income_step import IncomeCollectionStep
+from game.campaign.end_turn_steps.population_step import PopulationCalculationStep
+from game.hex_utils import HexCoord
+
+SPECIALIZATIONS = ("military", "trade", "religious", "agricultural")
+
+
+def _city(name, country, population, specialization="trade", income=100, q=0, r=0):
+    return City(name, country, HexCoord(q, r), "city", income, 1, population, specialization, "")
+
+
+def _random_cities(count, seed=5):
+    rng = random.Random(seed)
+    return {f"c{i}": _city(f"City{i}", rng.choice(("poland", "hungary", "bohemia")),
+                           rng.randrange(200, 80000), rng.choice(SPECIALIZATIONS), rng.randrange(0, 300))
+            for i in range(count)}
+
+
+@pytest.mark.skipif(not C_EXTENSION_AVAILABLE, reason="C extension not built")
+def test_native_and_python_kernels_agree():
+    native, python = CityIndex(_random_cities(300)), CityIndex(_random_cities(300))
+
+    for turn in range(1, 6):
+        native_rates = native.table.grow_population(1234, turn, use_native=True)
+        python_rates = python.table.grow_population(1234, turn, use_native=False)
+        assert native_rates == python_rates
+        assert native.table.population == python.table.population
+    assert native.table.income_by_country(use_native=True) == python.table.income_by_country(use_native=False)
+
+
+def test_growth_is_reproducible_from_the_seed():
+    first, second = CityIndex(_random_cities(50)), CityIndex(_random_cities(50))
+    first.table.grow_population(99, 3)
+    second.table.grow_population(99, 3)
+    assert first.table.population == second.table.population
+
+    second.table.grow_population(99, 4)
+    first.table.grow_population(100, 4)
+    assert first.table.population != second.table.population
+    assert 0.0 <= stream_uniform(turn_stream_key(99, 3), 0) < 1.0
+
+
+def test_city_attributes_follow_their_row():
+    cities = CityIndex({"a": _city("A", "poland", 5000), "b": _city("B", "hungary", 7000)})
+    a, b = cities["a"], cities["b"]
+    b.population = 7500
+    assert cities.table.population[b._row.index] == 7500
+
+    del cities["a"]
+    assert len(cities.table) == 1 and b.population == 7500
+    a.population = 42  # a released city keeps working on its own row
+    assert a.population == 42 and cities.table.population.tolist() == [7500]
+
+    cities["a"] = a
+    a.country = "hungary"
+    assert [c.name for c in cities.owned_by("hungary")] == ["B", "A"]
+    assert cities.table.income_by_country()[cities.table.name_id("country", "hungary")] == 200
+
+    clone = copy.deepcopy(cities)
+    clone["b"].population = 1
+    assert b.population == 7500 and clone.table.population[clone["b"]._row.index] == 1
+    assert copy.deepcopy(a) == a and copy.deepcopy(a)._row.table is not cities.table
+
+
+def test_population_step_matches_the_per_city_rule():
+    campaign = CampaignState(player_country="poland")
+    campaign.cities = _random_cities(40)
+    campaign.cities["tiny"] = _city("Tiny", "poland", 500, "military")
+    before = {key: city.population for key, city in campaign.cities.items()}
+
+    context = EndTurnContext(campaign_state=campaign, current_country_id="poland", turn_number=7, step_results={})
+    changes = PopulationCalculationStep().execute(context)
+
+    key = turn_stream_key(campaign.random_seed, 7)
+    for row, city_key in enumerate(campaign.cities.table.keys):
+        city = campaign.cities[city_key]
+        base = CitySpecialization.get_growth_rate(CitySpecialization.from_string(city.specialization))
+        rate = base + (stream_uniform(key, row) - 0.5) * 0.01
+        old = before[city_key]
+        assert changes[city_key] == {
+            'old_population': old,
+            'new_population': max(1000, old + int(old * rate)),
+            'change': int(old * rate),
+            'growth_rate': rate,
+            'specialization': city.specialization,
+        }
+        assert city.population == changes[city_key]['new_population']
+    assert campaign.cities["tiny"].population == 1000
+    assert set(changes) == set(campaign.cities)
+
+    campaign.random_seed = None
+    with pytest.raises(ValueError):
+        PopulationCalculationStep().execute(context)
+
+
+def test_income_step_sums_the_country_rows():
+    campaign = CampaignState(player_country="poland")
+    campaign.cities = _random_cities(60)
+    campaign.country_treasury["poland"] = 10
+    expected = {c.name: c.income for c in campaign.cities.values() if c.country == "poland"}
+
+    context = EndTurnContext(campaign_state=campaign, current_country_id="poland", turn_number=1, step_results={})
+    result = IncomeCollectionStep().execute(context)
+
+    assert result['total_income'] == sum(expected.values())
+    assert dict(result['city_incomes']) == expected
+    assert campaign.country_treasury["poland"] == 10 + sum(expected.values())
+    assert group_sums_python(array('q', [1, 2, 3]), array('H', [1, 0, 1]), 2) == [2, 4]
@@ -0,0 +1,185 @@
+"""Tests for the batch combat outcome evaluator."""
+import random
+
+from game.behaviors.combat import CombatMode
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.components.facing import FacingDirection
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.systems.combat_batch import BatchCombatEvaluator, COMBAT_MODE_CODES
+from game.systems.combat_resolver import CombatResolver
+from game.terrain import TerrainType
+from game.test_utils.mock_game_state import MockGameState
+
+_MODES = list(COMBAT_MODE_CODES)
+
+
+def _battle(seed, width=12, height=10, units=10):
+    rng = random.Random(seed)
+    game_state = MockGameState(board_width=width, board_height=height)
+    terrain_types = [TerrainType.PLAINS, TerrainType.FOREST, TerrainType.HILLS, TerrainType.BRIDGE]
+    for y in range(height):
+        for x in range(width):
+            game_state.terrain_map.set_terrain(x, y, rng.choice(terrain_types))
+
+    classes = list(KnightClass)
+    tiles = rng.sample([(x, y) for x in range(width) for y in range(height)], units)
+    for i, (x, y) in enumerate(tiles):
+        unit = UnitFactory.create_unit(f"Unit {i}", classes[i % len(classes)], x, y)
+        unit.player_id = 1 + i % 2
+        unit.facing.facing = rng.choice(list(FacingDirection))
+        unit.stats.stats.current_soldiers = rng.randint(unit.stats.stats.max_soldiers // 3, unit.stats.stats.max_soldiers)
+        unit.stats.stats.morale = rng.uniform(20, 100)
+        unit.cohesion = rng.uniform(10, unit.max_cohesion)
+        unit.is_disrupted = rng.random() < 0.2
+        unit.is_routing = rng.random() < 0.2
+        game_state.add_knight(unit)
+    return game_state
+
+
+def _all_pairs(game_state):
+    return [
+        (attacker, target, mode)
+        for attacker in game_state.knights
+        for target in game_state.knights
+        if attacker.player_id != target.player_id
+        for mode in _MODES
+    ]
+
+
+def test_native_and_python_batches_match():
+    assert C_EXTENSION_AVAILABLE, "C extension is required for combat batch parity tests"
+    for seed in (1, 8):
+        game_state = _battle(seed)
+        pairs = _all_pairs(game_state)
+        native = BatchCombatEvaluator(game_state, use_native=True).evaluate(pairs)
+        python = BatchCombatEvaluator(game_state, use_native=False).evaluate(pairs)
+
+        assert len(native) == len(pairs)
+        assert [native[i] for i in range(len(pairs))] == [python[i] for i in range(len(pairs))]
+
+
+def _scalar_counter(attack, attacker, target, attacker_terrain, target_terrain, mode):
+    if mode == CombatMode.RANGED:
+        return 0
+    counter = attack.calculate_counter_damage(target, attacker, target_terrain, attacker_terrain)
+    if mode == CombatMode.SKIRMISH:
+        return int(counter * 0.5)
+    if mode == CombatMode.CHARGE:
+        return int(counter * 0.75)
+    return counter
+
+
+def test_batch_matches_scalar_combat_path():
+    game_state = _battle(1)
+    pairs = _all_pairs(game_state)
+    outcomes = BatchCombatEvaluator(game_state).evaluate(pairs)
+
+    for i, (attacker, target, mode) in enumerate(pairs):
+        attack = attacker.behaviors['attack']
+        attacker_terrain = game_state.terrain_map.get_terrain(attacker.x, attacker.y)
+        target_terrain = game_state.terrain_map.get_terrain(target.x, target.y)
+
+        assert outcomes.damage[i] == attack.calculate_damage(attacker, target, attacker_terrain,
+                                                             target_terrain, mode)
+        assert outcomes.counter_damage[i] == _scalar_counter(attack, attacker, target, attacker_terrain,
+                                                             target_terrain, mode)
+
+
+def test_morale_and_cohesion_deltas_follow_resolver():
+    game_state = _battle(8)
+    pairs = _all_pairs(game_state)
+    outcomes = BatchCombatEvaluator(game_state).evaluate(pairs)
+    shocks = {
+        CombatMode.MELEE: (2.0, 6.0), CombatMode.RANGED: (1.0, 1.0),
+        CombatMode.SKIRMISH: (1.0, 3.0), CombatMode.CHARGE: (8.0, 12.0), None: (0.0, 0.0),
+    }
+
+    for i, (attacker, target, mode) in enumerate(pairs):
+        attacker_copy = attacker.clone_for_simulation()
+        target_copy = target.clone_for_simulation()
+        damage, counter = outcomes.damage[i], outcomes.counter_damage[i]
+
+        # Unit.take_casualties without its (random) routing check
+        if damage > 0:
+            target_copy.stats.take_casualties(int(damage * 0.7) if target.is_routing else damage)
+        angle = target.facing.get_attack_angle(attacker.x, attacker.y, target.x, target.y)
+        morale_shock, cohesion_shock = shocks[mode]
+        CombatResolver._apply_extra_penalties(
+            target_copy,
+            target.facing.get_morale_penalty(angle) + morale_shock,
+            target.facing.get_cohesion_penalty(angle) + cohesion_shock,
+        )
+        if counter > 0:
+            attacker_copy.stats.take_casualties(int(counter * 0.7) if attacker.is_routing else counter)
+
+        assert outcomes.target_morale_delta[i] == target_copy.stats.stats.morale - target.stats.stats.morale
+        assert outcomes.target_cohesion_delta[i] == target_copy.cohesion - target.cohesion
+        assert outcomes.attacker_morale_delta[i] == attacker_copy.stats.stats.morale - attacker.stats.stats.morale
+        assert outcomes.attacker_cohesion_delta[i] == attacker_copy.cohesion - attacker.cohesion
+
+
+def test_attack_mode_previews_every_target():
+    import pygame
+    from game.game_state import GameState
+
+    if not pygame.get_init():
+        pygame.init()
+    game_state = GameState(battle_config={'board_size': (12, 10), 'knights': 0, 'castles': 1}, vs_ai=False)
+    game_state.knights = []
+    for y in range(game_state.board_height):
+        for x in range(game_state.board_width):
+            game_state.terrain_map.set_terrain(x, y, TerrainType.PLAINS)
+    archer = UnitFactory.create_unit("Archer", KnightClass.ARCHER, 5, 5)
+    archer.player_id = 1
+    targets = []
+    for name, x, y in (("Near", 6, 5), ("Far", 5, 7)):
+        target = UnitFactory.create_unit(name, KnightClass.WARRIOR, x, y)
+        target.player_id = 2
+        targets.append(target)
+    game_state.knights = [archer] + targets
+    game_state.current_player = 1
+    game_state._update_all_fog_of_war()
+    game_state.selected_knight = archer
+
+    game_state.set_action_mode('attack')
+
+    attack = archer.behaviors['attack']
+    assert len(game_state.attack_targets) == 2
+    assert sorted(game_state.attack_previews) == sorted(game_state.attack_targets)
+    for target in targets:
+        distance = max(abs(archer.x - target.x), abs(archer.y - target.y))
+        mode = attack.determine_combat_mode(archer, target, distance)
+        terrain = game_state.terrain_map.get_terrain(target.x, target.y)
+        expected = attack.calculate_damage(archer, target, terrain, terrain, mode)
+        assert game_state.attack_previews[(target.x, target.y)][0] == expected
+
+
+def test_previews_are_dropped_with_the_attack_targets():
+    import pygame
+    from game.game_state import GameState
+
+    if not pygame.get_init():
+        pygame.init()
+    game_state = GameState(battle_config={'board_size': (12, 10), 'knights': 0, 'castles': 1}, vs_ai=False)
+    for y in range(game_state.board_height):
+        for x in range(game_state.board_width):
+            game_state.terrain_map.set_terrain(x, y, TerrainType.PLAINS)
+    cavalry = UnitFactory.create_unit("Cavalry", KnightClass.CAVALRY, 5, 5)
+    cavalry.player_id = 1
+    target = UnitFactory.create_unit("Target", KnightClass.WARRIOR, 6, 5)
+    target.player_id = 2
+    game_state.knights = [cavalry, target]
+    game_state.current_player = 1
+    game_state._update_all_fog_of_war()
+    game_state.selected_knight = cavalry
+
+    game_state.set_action_mode('attack')
+    assert game_state.attack_previews
+
+    game_state.set_action_mode('charge')
+    assert game_state.attack_targets and game_state.attack_previews == {}
+
+    game_state.set_action_mode('attack')
+    game_state.deselect_knight()
+    assert game_state.attack_targets == [] and game_state.attack_previews == {}
@@ -1,6 +1,9 @@
+import random
+import threading
+
 import pytest
 from unittest.mock import Mock, MagicMock
-from game.campaign.end_turn_steps.base import EndTurnContext, EndTurnStep, StepPriority
+from game.campaign.end_turn_steps.base import ALL_RESOURCES, EndTurnContext, EndTurnStep, StepPriority
 from game.campaign.end_turn_steps.processor import EndTurnProcessor
 from game.campaign.end_turn_steps.income_step import IncomeCollectionStep
 from game.campaign.end_turn_steps.movement_step import MovementResetStep
@@ -38,6 +41,36 @@ class TestEndTurnStep(EndTurnStep):
         return f"result_from_{self.name}"
 
 
+class LedgerStep(TestEndTurnStep):
+    """Step that appends to shared ledgers, declaring which ones it touches."""
+    __test__ = False
+    
+    def __init__(self, name, priority, reads=(), writes=(), dependencies=None, barrier=None):
+        super().__init__(name, priority, dependencies)
+        self._reads = frozenset(reads)
+        self._writes = frozenset(writes)
+        self.barrier = barrier
+        self.thread = None
+    
+    @property
+    def reads(self):
+        return self._reads
+    
+    @property
+    def writes(self):
+        return self._writes
+    
+    def execute(self, context: EndTurnContext):
+        self.thread = threading.current_thread()
+        if self.barrier is not None:
+            self.barrier.wait(timeout=5)
+        ledgers = context.campaign_state
+        seen = {name: list(ledgers[name]) for name in sorted(self._reads)}
+        for name in sorted(self._writes):
+            ledgers[name].append((self.name, random.random() if name == 'random' else len(ledgers[name])))
+        return seen
+
+
 class TestEndTurnContext:
     """Test EndTurnContext functionality."""
     
@@ -170,6 +203,77 @@ class TestEndTurnProcessor:
         assert "test" not in context.step_results
 
 
+class TestConcurrentExecution:
+    """Concurrent execution must reproduce sequential results."""
+    
+    def _ledger_steps(self):
+        return [
+            LedgerStep("reset", StepPriority.PREPARATION, reads={"armies"}, writes={"armies"}),
+            LedgerStep("income", StepPriority.INCOME, reads={"cities"}, writes={"treasury"}),
+            LedgerStep("growth", StepPriority.POPULATION, reads={"cities"}, writes={"cities", "random"}),
+            LedgerStep("upkeep", StepPriority.MAINTENANCE, reads={"armies"}, writes={"treasury"}),
+            LedgerStep("events", StepPriority.EVENTS, writes={"random"}, dependencies=["income"]),
+            TestEndTurnStep("report", StepPriority.CLEANUP),
+        ]
+    
+    def _run(self, max_workers, seed):
+        processor = EndTurnProcessor(max_workers=max_workers)
+        for step in self._ledger_steps():
+            processor.register_step(step)
+        ledgers = {name: [] for name in ("armies", "cities", "treasury", "random")}
+        random.seed(seed)
+        context = processor.execute(ledgers, "poland", 3)
+        return processor, ledgers, context
+    
+    def test_results_match_sequential_execution(self):
+        for seed in range(5):
+            _, sequential_ledgers, sequential = self._run(1, seed)
+            processor, ledgers, concurrent = self._run(4, seed)
+            
+            assert processor.get_execution_plan().width > 1
+            assert ledgers == sequential_ledgers
+            assert concurrent.step_results == sequential.step_results
+            assert list(concurrent.step_results) == list(sequential.step_results)
+            assert list(concurrent.step_timings) == [s.name for s in processor.get_execution_order()]
+            assert all(seconds >= 0 for seconds in concurrent.step_timings.values())
+    
+    def test_plan_waits_only_for_dependencies_and_conflicts(self):
+        processor = EndTurnProcessor(max_workers=4)
+        for step in self._ledger_steps():
+            processor.register_step(step)
+        plan = processor.get_execution_plan()
+        
+        assert plan.waits_for["reset"] == [] and plan.waits_for["income"] == []
+        assert plan.waits_for["growth"] == ["income"]  # income reads what growth writes
+        assert plan.waits_for["upkeep"] == ["reset", "income"]
+        assert plan.waits_for["events"] == ["income", "growth"]
+        assert plan.waits_for["report"] == ["reset", "income", "growth", "upkeep", "events"]
+        assert processor.get_execution_plan() is plan
+        
+        processor.unregister_step("report")
+        assert processor.get_execution_plan() is not plan
+    
+    def test_independent_steps_run_on_separate_workers(self):
+        barrier = threading.Barrier(2)
+        processor = EndTurnProcessor(max_workers=2)
+        first = LedgerStep("first", StepPriority.INCOME, writes={"treasury"}, barrier=barrier)
+        second = LedgerStep("second", StepPriority.POPULATION, writes={"cities"}, barrier=barrier)
+        processor.register_step(first)
+        processor.register_step(second)
+        
+        context = processor.execute({"treasury": [], "cities": []}, "poland", 1)
+        
+        assert first.thread is not second.thread
+        assert set(context.step_results) == {"first", "second"}
+    
+    def test_undeclared_steps_run_alone(self):
+        step = TestEndTurnStep("legacy", StepPriority.INCOME)
+        declared = LedgerStep("declared", StepPriority.INCOME, writes={"treasury"})
+        
+        assert step.reads == step.writes == ALL_RESOURCES
+        assert step.conflicts_with(declared) and declared.conflicts_with(step)
+
+
 class TestIncomeCollectionStep:
     """Test IncomeCollectionStep functionality."""
     
@@ -271,6 +375,8 @@ class TestPopulationCalculationStep:
         city2.specialization = "military"
         
         campaign_state.cities = {"TradeCity": city1, "MilitaryCity": city2}
+        # Growth draws from the campaign's seeded stream
+        campaign_state.random_seed = 1
         
         # Create context
         context = EndTurnContext(
@@ -311,6 +417,7 @@ class TestPopulationCalculationStep:
         city.specialization = "military"
         
         campaign_state.cities = {"SmallCity": city}
+        campaign_state.random_seed = 1
         
         context = EndTurnContext(
             campaign_state=campaign_state,
@@ -0,0 +1,120 @@
+"""Tests for the incremental ZOC and engagement tracker."""
+import random
+
+import pytest
+
+from game.battle.domain.events import AttackResolved, UnitMoved
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.state.battle_state import BattleState
+from game.systems.engagement import EngagementSystem, EngagementTracker
+from game.test_utils.scenario_battles import load_battle
+
+
+def _unit(name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    return unit
+
+
+def _expected(battle_state):
+    """ZOC enemy of each unit by scanning every knight, in knights order"""
+    expected = {}
+    for unit in battle_state.knights:
+        enemy = None
+        for other in battle_state.knights:
+            if other.player_id != unit.player_id and other.has_zone_of_control():
+                dx, dy = abs(unit.x - other.x), abs(unit.y - other.y)
+                if dx <= 1 and dy <= 1 and dx + dy > 0:
+                    enemy = other
+                    break
+        expected[unit.name] = enemy
+    return expected
+
+
+def _assert_matches_scan(battle_state):
+    for unit in battle_state.knights:
+        enemy = _expected(battle_state)[unit.name]
+        assert unit.zoc_enemy is enemy, unit.name
+        assert unit.in_enemy_zoc == (enemy is not None), unit.name
+
+
+def test_tracker_follows_random_moves_and_strength_changes():
+    rng = random.Random(3)
+    battle_state = load_battle("cavalry_charge")
+    battle_state.update_zoc_status()
+    _assert_matches_scan(battle_state)
+
+    for step in range(60):
+        unit = rng.choice(battle_state.knights)
+        if step % 3:
+            unit.x = min(battle_state.board_width - 1, max(0, unit.x + rng.choice((-1, 0, 1))))
+            unit.y = min(battle_state.board_height - 1, max(0, unit.y + rng.choice((-1, 0, 1))))
+        else:
+            unit.morale = rng.choice((10, 100))
+        battle_state.update_zoc_status()
+        _assert_matches_scan(battle_state)
+
+
+def test_only_touched_neighbourhood_is_reevaluated(monkeypatch):
+    battle_state = BattleState({'board_size': (20, 20), 'knights': 0, 'castles': 0})
+    battle_state.knights.clear()
+    mover = _unit("Mover", KnightClass.WARRIOR, 2, 2, 1)
+    near = _unit("Near", KnightClass.WARRIOR, 5, 2, 2)
+    far = _unit("Far", KnightClass.WARRIOR, 15, 15, 2)
+    battle_state.knights.extend([mover, near, far])
+    battle_state.update_zoc_status()
+
+    evaluated = []
+    original = EngagementSystem.update_unit.__func__
+    monkeypatch.setattr(EngagementSystem, 'update_unit', classmethod(
+        lambda cls, unit, enemy, live_ids: (evaluated.append(unit.name), original(cls, unit, enemy, live_ids))))
+
+    battle_state.engagement.publish(UnitMoved(id(mover), 2, 2, 4, 2, [(3, 2), (4, 2)], 2))
+    mover.x = 4
+    battle_state.update_zoc_status()
+
+    assert sorted(evaluated) == ["Mover", "Near"]
+    assert mover.zoc_enemy is near and near.zoc_enemy is mover
+    assert far.zoc_enemy is None
+
+    evaluated.clear()
+    battle_state.update_zoc_status()
+    assert evaluated == []
+
+
+def test_engagement_ends_when_partner_moves_away_or_dies():
+    battle_state = BattleState({'board_size': (20, 20), 'knights': 0, 'castles': 0})
+    battle_state.knights.clear()
+    attacker = _unit("Attacker", KnightClass.WARRIOR, 5, 5, 1)
+    target = _unit("Target", KnightClass.WARRIOR, 6, 5, 2)
+    other = _unit("Other", KnightClass.ARCHER, 10, 10, 2)
+    battle_state.knights.extend([attacker, target, other])
+    battle_state.update_zoc_status()
+
+    attacker.is_engaged_in_combat = target.is_engaged_in_combat = True
+    attacker.engaged_with, target.engaged_with = target, attacker
+    battle_state.engagement.publish(AttackResolved(id(attacker), id(target), 10, 0, None, 0, 0, False))
+    battle_state.update_zoc_status()
+    assert attacker.is_engaged_in_combat and target.engaged_with is attacker
+
+    target.x = 8
+    battle_state.update_zoc_status()
+    assert not attacker.is_engaged_in_combat and attacker.engaged_with is None
+    assert not target.is_engaged_in_combat and target.engaged_with is None
+
+    target.x = 6
+    attacker.is_engaged_in_combat = target.is_engaged_in_combat = True
+    attacker.engaged_with, target.engaged_with = target, attacker
+    battle_state.update_zoc_status()
+    target.stats.stats.current_soldiers = 0
+    battle_state.cleanup_dead_knights()
+    battle_state.update_zoc_status()
+    assert not attacker.is_engaged_in_combat and attacker.engaged_with is None
+
+
+def test_tracker_rejects_unknown_events():
+    with pytest.raises(ValueError):
+        EngagementTracker().publish(object())
+    with pytest.raises(ValueError):
+        EngagementTracker().update(None)
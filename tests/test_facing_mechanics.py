@@ -6,7 +6,8 @@ sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
 
 from game.entities.unit_factory import UnitFactory
 from game.entities.knight import KnightClass
-from game.components.facing import FacingDirection, AttackAngle
+from game.components.facing import (ATTACK_TABLE_RADIUS, AttackAngle, FacingDirection,
+                                    _classify_attack, attack_arc)
 from game.test_utils.mock_game_state import MockGameState
 from game.combat_config import CombatConfig
 from game.animation import AttackAnimation
@@ -79,6 +80,36 @@ class TestFacingMechanics:
         assert not angle.is_frontal
         assert not angle.is_rear
         
+    def test_attack_arc_table_matches_geometry(self):
+        """Test the attack arc table against the geometric classification"""
+        defender = UnitFactory.create_warrior("Defender", 10, 10)
+        reach = ATTACK_TABLE_RADIUS + 2
+        for facing in FacingDirection:
+            defender.facing.facing = facing
+            for dy in range(-reach, reach + 1):
+                for dx in range(-reach, reach + 1):
+                    arc = attack_arc(facing, dx, dy)
+                    assert arc == _classify_attack(facing, dx, dy)
+                    assert defender.facing.get_attack_angle(10 + dx, 10 + dy, 10, 10) == arc.angle
+                    assert arc.damage_modifier == defender.facing.get_damage_modifier(arc.angle)
+                    assert arc.morale_penalty == defender.facing.get_morale_penalty(arc.angle)
+                    assert arc.cohesion_penalty == defender.facing.get_cohesion_penalty(arc.angle)
+
+        # Offsets within the radius share one table entry
+        assert attack_arc(FacingDirection.EAST, 1, 0) is attack_arc(FacingDirection.EAST, 1, 0)
+
+    def test_attack_arc_table_follows_cohesion_penalties(self, monkeypatch):
+        """Test that changed CombatConfig cohesion penalties reach the table"""
+        rear_offset = (-1, 0)  # West of a defender facing east
+        default = attack_arc(FacingDirection.EAST, *rear_offset)
+        assert default.angle.is_rear
+
+        monkeypatch.setattr(CombatConfig, 'COHESION_REAR_PENALTY', default.cohesion_penalty + 7.0)
+        assert attack_arc(FacingDirection.EAST, *rear_offset).cohesion_penalty == default.cohesion_penalty + 7.0
+
+        monkeypatch.undo()
+        assert attack_arc(FacingDirection.EAST, *rear_offset) is default
+
     def test_damage_modifiers(self):
         """Test damage modifiers based on attack angle"""
         defender = UnitFactory.create_warrior("Defender", 10, 10)
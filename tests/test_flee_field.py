@@ -0,0 +1,123 @@
+"""Tests for flee fields that steer routing units."""
+import random
+
+from game.battle.adapters.shared_battle_state import SharedBattleState
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE, CPathFinder
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.state.battle_state import BattleState
+from game.systems.flee_field import FleeField
+from game.systems.threat_map import ThreatMap
+from game.terrain import TerrainType
+from game.test_utils.mock_game_state import MockGameState
+
+
+def _make_state(width=20, height=20):
+    game_state = MockGameState(board_width=width, board_height=height)
+    game_state.fog_of_war = None
+    game_state._castles = []
+    return game_state
+
+
+def _add_unit(game_state, name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    game_state.add_knight(unit)
+    return unit
+
+
+def _random_battle(seed):
+    rng = random.Random(seed)
+    game_state = _make_state(24, 18)
+    terrain_types = [TerrainType.PLAINS, TerrainType.FOREST, TerrainType.HILLS, TerrainType.WATER]
+    for y in range(18):
+        for x in range(24):
+            game_state.terrain_map.set_terrain(x, y, rng.choice(terrain_types))
+    classes = list(KnightClass)
+    tiles = rng.sample([(x, y) for x in range(24) for y in range(18)], 16)
+    for i, (x, y) in enumerate(tiles):
+        game_state.terrain_map.set_terrain(x, y, TerrainType.PLAINS)
+        _add_unit(game_state, f"Unit {i}", classes[i % len(classes)], x, y, 1 + i % 2)
+    return game_state
+
+
+def _snapshot(field):
+    return [field.cost(x, y) for y in range(field.height) for x in range(field.width)]
+
+
+def test_native_and_python_fields_match_the_threat_cost():
+    assert C_EXTENSION_AVAILABLE, "C pathfinding extension is required for parity tests"
+    game_state = _random_battle(11)
+
+    native = FleeField.build(game_state, 2, use_native=True)
+    python = FleeField.build(game_state, 2, use_native=False)
+    threat_map = ThreatMap.build(game_state, 2, max_turns=ThreatMap.MAX_TURNS, block_units=False)
+
+    assert _snapshot(native) == _snapshot(python)
+    assert _snapshot(native) == [threat_map.threat_cost(x, y) for y in range(18) for x in range(24)]
+
+
+def test_routers_step_to_the_farthest_free_neighbour():
+    game_state = _make_state()
+    _add_unit(game_state, "Enemy", KnightClass.WARRIOR, 10, 10, 1)
+    router = _add_unit(game_state, "Router", KnightClass.WARRIOR, 12, 10, 2)
+    field = FleeField.build(game_state, 2)
+
+    router.is_routing = True
+    moves = router.get_behavior('MovementBehavior')._get_routing_moves(router, game_state)
+
+    assert moves and set(moves) <= set(field.neighbours(12, 10))
+    assert [field.cost(*move) for move in moves] == sorted((field.cost(*m) for m in moves), reverse=True)
+    _add_unit(game_state, "Blocker", KnightClass.ARCHER, *moves[0], 2)
+
+    router.is_routing = True
+    assert router._attempt_auto_routing_movement(game_state)
+    assert (router.x, router.y) == moves[1]
+
+
+def test_battle_state_builds_each_side_field_once_until_enemies_move():
+    battle_state = BattleState({'board_size': (16, 16), 'knights': 0, 'castles': 0})
+    battle_state.knights.clear()
+    enemy = UnitFactory.create_unit("Enemy", KnightClass.CAVALRY, 3, 3)
+    enemy.player_id = 1
+    own = UnitFactory.create_unit("Own", KnightClass.WARRIOR, 8, 8)
+    own.player_id = 2
+    battle_state.knights.extend([enemy, own])
+
+    field = FleeField.for_player(battle_state, 2)
+    own.x = 9
+    assert FleeField.for_player(battle_state, 2) is field
+
+    enemy.x = 4
+    moved = FleeField.for_player(battle_state, 2)
+    assert moved is not field and moved.cost(4, 3) == 0.0
+
+    battle_state.terrain_map.set_terrain(6, 6, TerrainType.FOREST)
+    assert FleeField.for_player(battle_state, 2) is not moved
+
+
+def test_search_states_share_fields_and_unit_costs(monkeypatch):
+    battle_state = BattleState({'board_size': (16, 16), 'knights': 0, 'castles': 0})
+    battle_state.knights.clear()
+    enemy = UnitFactory.create_unit("Enemy", KnightClass.CAVALRY, 3, 3)
+    enemy.player_id = 1
+    own = UnitFactory.create_unit("Own", KnightClass.WARRIOR, 8, 8)
+    own.player_id = 2
+    battle_state.knights.extend([enemy, own])
+
+    root = SharedBattleState.share(battle_state)
+    field = FleeField.for_player(root.fork(), 2)
+    assert root.fork().flee_fields is battle_state.flee_fields
+    assert FleeField.for_player(root.fork(), 2) is field
+
+    moved = root.fork()
+    moved.writable(enemy).x = 4
+    assert FleeField.for_player(moved, 2) is not field
+    assert FleeField.for_player(root.fork(), 2) is field
+
+    built = []
+    build_cost_map = CPathFinder.build_cost_map
+    monkeypatch.setattr(CPathFinder, 'build_cost_map',
+                        staticmethod(lambda *args: built.append(args) or build_cost_map(*args)))
+    assert field.flee_steps(8, 8, own) == field.flee_steps(8, 8, own)
+    assert len(built) == 1
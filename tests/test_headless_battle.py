@@ -0,0 +1,91 @@
+"""Tests for headless AI-vs-AI battles and the tournament runner."""
+import pytest
+
+from game.ai.ai_player import AIPlayer
+from game.battle.adapters.headless_battle import AI_PHASES, HeadlessBattle
+from game.test_utils.scenario_battles import load_battle, loadable_scenarios
+from tools.ai_tournament import BattleSpec, build_specs, format_report, run_battle, run_tournament
+
+
+def _positions(battle_state):
+    return sorted((k.name, k.player_id, k.x, k.y, k.soldiers) for k in battle_state.knights)
+
+
+def test_battle_plays_through_command_handlers():
+    battle_state = load_battle("cavalry_charge", current_player=1)
+    before = _positions(battle_state)
+    battle = HeadlessBattle(battle_state, {1: AIPlayer(1, 'easy'), 2: AIPlayer(2, 'easy')})
+
+    outcome = battle.play(max_turns=2)
+
+    assert outcome.turns == 2
+    assert outcome.actions > 0
+    assert battle_state.turn_number == 3 and battle_state.current_player == 1
+    assert _positions(battle_state) != before
+    assert not battle.pending_positions
+    for player_id in (1, 2):
+        phases = outcome.phases[player_id]
+        assert set(phases) == set(AI_PHASES)
+        assert phases['plan'].calls > 0 and phases['plan'].nodes > 0
+        assert phases['end_turn'].calls == 2
+
+
+def test_battle_stops_at_victory():
+    battle_state = load_battle("cavalry_charge", current_player=1)
+    for knight in [k for k in battle_state.knights if k.player_id == 1]:
+        battle_state.knights.remove(knight)
+    battle = HeadlessBattle(battle_state, {1: AIPlayer(1, 'easy'), 2: AIPlayer(2, 'easy')})
+
+    outcome = battle.play(max_turns=5)
+
+    assert outcome.winner == 2
+    assert outcome.actions == 0 and outcome.turns == 1
+
+
+def test_ai_players_must_match_their_seats():
+    battle_state = load_battle("cavalry_charge", current_player=1)
+    with pytest.raises(ValueError):
+        HeadlessBattle(battle_state, {1: AIPlayer(2, 'easy'), 2: AIPlayer(1, 'easy')})
+    with pytest.raises(ValueError):
+        HeadlessBattle(battle_state, {1: AIPlayer(1, 'easy')})
+
+
+def test_seeded_battles_repeat():
+    spec = BattleSpec("archer_mechanics", seed=7, difficulties=('easy', 'medium'), max_turns=2)
+
+    first, second = run_battle(spec), run_battle(spec)
+
+    assert (first.winner, first.turns, first.actions, first.rejected) == \
+        (second.winner, second.turns, second.actions, second.rejected)
+    assert [first.phases[p][phase].nodes for p in (1, 2) for phase in AI_PHASES] == \
+        [second.phases[p][phase].nodes for p in (1, 2) for phase in AI_PHASES]
+
+
+def test_seeded_mcts_battles_repeat():
+    spec = BattleSpec("cavalry_charge", seed=3, difficulties=('mcts', 'easy'), max_turns=1, mcts_iterations=8)
+
+    first, second = run_battle(spec), run_battle(spec)
+
+    assert (first.winner, first.actions, first.rejected) == (second.winner, second.actions, second.rejected)
+    assert first.phases[1]['plan'].nodes == second.phases[1]['plan'].nodes > 0
+
+
+def test_tournament_aggregates_battles():
+    scenarios = loadable_scenarios()
+    assert "cavalry_charge" in scenarios
+    specs = build_specs(["cavalry_charge", "archer_mechanics"], battles=3, seed=5,
+                        difficulties=('easy', 'easy'), max_turns=1)
+
+    assert [(s.scenario, s.seed) for s in specs] == [
+        ("cavalry_charge", 5), ("archer_mechanics", 6), ("cavalry_charge", 7)]
+
+    report = run_tournament(specs, workers=1)
+
+    assert report.battles == 3
+    assert sum(report.wins.values()) == 3
+    assert sum(sum(wins.values()) for wins in report.by_scenario.values()) == 3
+    assert report.phases[1]['end_turn'].calls == 3
+    assert "Player 1 (easy) wins" in format_report(report, ('easy', 'easy'))
+
+    with pytest.raises(ValueError):
+        build_specs([], battles=1, seed=0, difficulties=('easy', 'easy'), max_turns=1)
@@ -0,0 +1,138 @@
+"""Tests for copy-on-write battle states used by AI search and snapshots."""
+import contextlib
+import io
+
+import pytest
+
+from game.ai.ai_player import AIPlayer
+from game.ai.battle_snapshot import BattleSnapshot
+from game.battle.adapters.shared_battle_state import SharedBattleState
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.state.state_serializer import StateSerializer
+from game.test_utils.mock_game_state import MockGameState
+from game.test_utils.scenario_battles import load_battle, seeded_random
+from game.visibility import FogOfWar
+
+
+def _make_state():
+    game_state = MockGameState(board_width=20, board_height=20)
+    game_state.fog_of_war = None
+    game_state._castles = []
+    return game_state
+
+
+def _add_unit(game_state, name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    game_state.add_knight(unit)
+    return unit
+
+
+def _skirmish():
+    game_state = _make_state()
+    attacker = _add_unit(game_state, "Attacker", KnightClass.WARRIOR, 10, 10, 2)
+    target = _add_unit(game_state, "Target", KnightClass.ARCHER, 11, 10, 1)
+    bystander = _add_unit(game_state, "Bystander", KnightClass.CAVALRY, 3, 3, 2)
+    return game_state, attacker, target, bystander
+
+
+def test_fork_shares_unit_records():
+    game_state, attacker, target, bystander = _skirmish()
+    root = SharedBattleState.share(game_state)
+    child = root.fork()
+
+    assert child.knights is root.knights
+    assert child.knights[0] is attacker
+    assert child.get_knight_at(3, 3) is bystander
+    with pytest.raises(AttributeError):
+        child.knights.append(attacker)
+
+
+def test_writable_clones_only_the_touched_unit():
+    game_state, attacker, target, bystander = _skirmish()
+    root = SharedBattleState.share(game_state)
+    child = root.fork()
+
+    moved = child.writable(attacker)
+    moved.x, moved.y = 9, 9
+
+    assert moved is not attacker
+    assert child.owns(moved) and not child.owns(attacker)
+    assert child.writable(moved) is moved
+    assert (attacker.x, attacker.y) == (10, 10)
+    assert root.knights[0] is attacker
+    assert child.knights[1] is target and child.knights[2] is bystander
+    assert child.get_knight_at(9, 9) is moved
+    assert child.get_knight_at(10, 10) is None
+
+    with pytest.raises(ValueError):
+        child.writable(UnitFactory.create_unit("Stranger", KnightClass.WARRIOR, 0, 0))
+
+
+def test_removal_keeps_parent_indices():
+    game_state, attacker, target, bystander = _skirmish()
+    child = SharedBattleState.share(game_state).fork()
+    wounded = child.writable(target)
+
+    child.remove_unit(wounded)
+
+    assert child.knights == (attacker, bystander)
+    assert child.origin_indices() == {id(attacker): 0, id(bystander): 2}
+    assert len(game_state.knights) == 3
+
+
+def test_simulated_attack_leaves_the_searched_state_untouched():
+    game_state, attacker, target, bystander = _skirmish()
+    soldiers = target.soldiers
+    ai = AIPlayer(2, 'medium')
+
+    # Combat and the rout check draw from the shared stream; the defender
+    # may rout off its tile, so its clone is found by index, not position
+    with seeded_random(36):
+        child = ai._simulate_move(game_state, ('attack', attacker, target, 0))
+        grandchild = ai._simulate_move(child, ('move', bystander, 4, 3))
+
+    wounded = child.knights[1]
+    assert target.soldiers == soldiers and attacker.action_points == attacker.max_action_points
+    assert child.owns(wounded) and wounded.name == "Target" and wounded.soldiers < soldiers
+    # The grandchild only cloned the bystander; the attack's clones are shared
+    assert grandchild.knights[1] is wounded
+    assert grandchild.get_knight_at(4, 3) is not bystander
+    assert child.get_knight_at(3, 3) is bystander
+
+
+def test_search_does_not_mutate_live_units():
+    battle_state = load_battle("cavalry_charge")
+    before = [(k.name, k.x, k.y, k.soldiers, k.action_points, k.morale) for k in battle_state.knights]
+
+    ai = AIPlayer(2, 'hard')
+    with contextlib.redirect_stdout(io.StringIO()):
+        ai.choose_action(battle_state)
+
+    after = [(k.name, k.x, k.y, k.soldiers, k.action_points, k.morale) for k in battle_state.knights]
+    assert after == before
+
+
+def test_snapshot_forks_share_its_clones():
+    battle_state = load_battle("archer_mechanics")
+    snapshot = BattleSnapshot.capture(battle_state)
+    child = snapshot.fork()
+
+    assert type(child) is SharedBattleState
+    assert child.knights is snapshot.knights
+    clone = child.writable(child.knights[0])
+    assert snapshot.knights[0] is not clone
+    assert snapshot.live_unit(snapshot.knights[0]) is battle_state.knights[0]
+
+
+def test_battle_serializes_from_a_snapshot():
+    battle_state = load_battle("archer_mechanics")
+    serializer = StateSerializer()
+    expected = serializer.serialize_battle(battle_state)
+
+    snapshot = BattleSnapshot.capture(battle_state)
+    battle_state.knights[0].x += 1
+
+    assert isinstance(battle_state.fog_of_war, FogOfWar)
+    assert serializer.serialize_battle(snapshot) == expected
@@ -0,0 +1,69 @@
+"""Tests for the native terrain noise and road routing behind TerrainGenerator."""
+import random
+
+import pytest
+
+from game.terrain import (
+    C_NOISE_AVAILABLE, _ROAD_COSTS, _ROAD_EVEN_ROW_DIRS, _ROAD_ODD_ROW_DIRS,
+    TerrainFeature, TerrainGenerator, TerrainMap,
+)
+
+native_only = pytest.mark.skipif(not C_NOISE_AVAILABLE, reason="C extension not built")
+
+
+def _is_hex_path(path):
+    for (x, y), step in zip(path, path[1:]):
+        dirs = _ROAD_EVEN_ROW_DIRS if y % 2 == 0 else _ROAD_ODD_ROW_DIRS
+        if (step[0] - x, step[1] - y) not in dirs:
+            return False
+    return True
+
+
+@native_only
+@pytest.mark.parametrize("seed", [1, 4242, 987654])
+def test_native_noise_matches_the_python_octaves(seed):
+    generator = TerrainGenerator(37, 23, seed=seed)
+
+    for scale, octaves in ((0.1, 4), (0.33, 6), (1.7, 2)):
+        assert (generator.generate_height_map(scale, octaves, use_native=True)
+                == generator.generate_height_map(scale, octaves, use_native=False))
+    assert generator.generate_moisture_map(use_native=True) == generator.generate_moisture_map(use_native=False)
+
+
+@native_only
+def test_native_and_python_roads_cost_the_same():
+    rng = random.Random(6)
+    generator = TerrainGenerator(30, 24, seed=6)
+    road_grid = bytes(rng.choice((0, 0, 0, 1, 2, 3)) for _ in range(30 * 24))
+    road_grid = b'\0' + road_grid[1:-1] + b'\0'
+
+    native = generator._find_road_path(road_grid, (0, 0), (29, 23), use_native=True)
+    python = generator._find_road_path(road_grid, (0, 0), (29, 23), use_native=False)
+
+    def cost(path):
+        return sum(_ROAD_COSTS[road_grid[y * 30 + x]] for x, y in path[1:])
+
+    assert native[0] == python[0] == (0, 0) and native[-1] == python[-1] == (29, 23)
+    assert _is_hex_path(native) and _is_hex_path(python)
+    assert cost(native) == cost(python)
+
+    walled = bytearray(30 * 24)
+    walled[10 * 30:11 * 30] = b'\3' * 30
+    assert generator._find_road_path(bytes(walled), (0, 0), (29, 23)) is None
+
+
+def test_generated_roads_link_castle_corners():
+    terrain_map = TerrainMap(64, 48, seed=17)
+    road = {(x, y) for y in range(48) for x in range(64)
+            if terrain_map.get_terrain(x, y).feature in (TerrainFeature.ROAD, TerrainFeature.BRIDGE)}
+
+    reached, frontier = {(2, 2)}, [(2, 2)]
+    while frontier:
+        x, y = frontier.pop()
+        for dx, dy in (_ROAD_EVEN_ROW_DIRS if y % 2 == 0 else _ROAD_ODD_ROW_DIRS):
+            if (x + dx, y + dy) in road and (x + dx, y + dy) not in reached:
+                reached.add((x + dx, y + dy))
+                frontier.append((x + dx, y + dy))
+
+    assert (2, 2) in road and (61, 45) in reached
+    assert terrain_map.feature_ids() == TerrainMap(64, 48, seed=17).feature_ids()
@@ -0,0 +1,55 @@
+"""Tests for batched terrain edits and the changed-region journal."""
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.terrain import TerrainMap, TerrainRect, TerrainType
+
+
+def test_batch_bumps_revision_once_with_one_rectangle():
+    terrain_map = TerrainMap(20, 20, seed=2)
+    start = terrain_map.revision
+
+    with terrain_map.batch():
+        for x in range(3, 8):
+            terrain_map.set_terrain(x, 4, TerrainType.FOREST)
+        with terrain_map.batch():
+            terrain_map.set_terrain(5, 9, TerrainType.HILLS)
+        assert terrain_map.revision == start
+
+    assert terrain_map.revision == start + 1
+    assert terrain_map.changes_since(start) == [TerrainRect(3, 4, 8, 10)]
+    assert terrain_map.changes_since(terrain_map.revision) == []
+
+    terrain_map.set_terrain(0, 0, TerrainType.WATER)
+    assert terrain_map.changes_since(start) == [TerrainRect(3, 4, 8, 10), TerrainRect(0, 0, 1, 1)]
+
+
+def test_journal_forgets_old_and_replaced_revisions():
+    terrain_map = TerrainMap(10, 10, seed=4)
+    start = terrain_map.revision
+
+    for i in range(TerrainMap.JOURNAL_LIMIT + 1):
+        terrain_map.set_terrain(i % 10, i // 10, TerrainType.FOREST)
+
+    assert terrain_map.changes_since(start) is None
+    assert len(terrain_map.changes_since(start + 1)) == TerrainMap.JOURNAL_LIMIT
+
+    replaced_at = terrain_map.revision
+    terrain_map.terrain_grid = [[terrain_map.get_terrain(x, y) for x in range(10)] for y in range(10)]
+    assert terrain_map.changes_since(replaced_at) is None
+    assert terrain_map.changes_since(terrain_map.revision) == []
+
+
+def test_cost_planes_are_patched_from_the_journal():
+    terrain_map = TerrainMap(30, 30, seed=8)
+    warrior = UnitFactory.create_unit("Foot", KnightClass.WARRIOR, 0, 0)
+    before = terrain_map.movement_cost_plane(warrior)
+
+    with terrain_map.batch():
+        terrain_map.set_terrain(10, 10, TerrainType.SWAMP)
+        terrain_map.set_terrain(12, 11, TerrainType.WATER)
+    patched = terrain_map.movement_cost_plane(warrior)
+
+    assert patched is not before
+    assert list(patched) == [
+        terrain_map.get_movement_cost(x, y, warrior) for y in range(30) for x in range(30)]
+    assert before[10 * 30 + 10] != patched[10 * 30 + 10]
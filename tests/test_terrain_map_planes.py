@@ -0,0 +1,88 @@
+"""Tests for the byte-plane storage behind TerrainMap."""
+import math
+
+import pytest
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.terrain import (
+    TERRAIN_FEATURE_IDS, TERRAIN_TYPE_IDS, TERRAIN_TYPES, Terrain, TerrainFeature, TerrainMap, TerrainType,
+)
+
+
+def test_tiles_share_immutable_terrain_per_type_and_feature():
+    terrain_map = TerrainMap(12, 10, seed=3)
+    terrain_map.set_terrain(1, 1, TerrainType.FOREST)
+    terrain_map.set_terrain(5, 7, TerrainType.FOREST)
+    terrain_map.set_terrain(2, 2, TerrainType.PLAINS, TerrainFeature.ROAD)
+
+    assert terrain_map.get_terrain(1, 1) is terrain_map.get_terrain(5, 7)
+    assert terrain_map.get_terrain(1, 1) is Terrain.of(TerrainType.FOREST)
+    assert terrain_map.get_terrain(2, 2).feature == TerrainFeature.ROAD
+    assert terrain_map.get_terrain(12, 0) is None
+    with pytest.raises(AttributeError):
+        terrain_map.get_terrain(1, 1).type = TerrainType.WATER
+
+    index = 7 * 12 + 5
+    assert terrain_map.type_ids()[index] == TERRAIN_TYPE_IDS[TerrainType.FOREST]
+    assert terrain_map.feature_ids()[2 * 12 + 2] == TERRAIN_FEATURE_IDS[TerrainFeature.ROAD]
+
+
+def test_terrain_grid_reads_and_writes_the_planes():
+    terrain_map = TerrainMap(8, 8, seed=1)
+    revision = terrain_map.revision
+
+    terrain_map.terrain_grid[3][4] = Terrain(TerrainType.HILLS)
+
+    assert terrain_map.get_terrain(4, 3).type == TerrainType.HILLS
+    assert terrain_map.terrain_grid[3][-4].type == TerrainType.HILLS
+    assert terrain_map.revision > revision
+    assert len(terrain_map.terrain_grid) == 8 and len(terrain_map.terrain_grid[0]) == 8
+    with pytest.raises(IndexError):
+        terrain_map.terrain_grid[8]
+
+    # Built row by row, as hand-made test maps do
+    built = TerrainMap.__new__(TerrainMap)
+    built.width, built.height = 3, 2
+    built.terrain_grid = []
+    built.terrain_grid.append([Terrain(TerrainType.PLAINS)] * 3)
+    built.terrain_grid.append([Terrain(TerrainType.WATER)] * 3)
+    assert [[t.type for t in row] for row in built.terrain_grid] == [
+        [TerrainType.PLAINS] * 3, [TerrainType.WATER] * 3]
+    with pytest.raises(ValueError):
+        built.terrain_grid.append([Terrain(TerrainType.PLAINS)] * 3)
+
+
+def test_movement_cost_plane_matches_per_tile_costs():
+    terrain_map = TerrainMap(20, 20, seed=5)
+    terrain_map.set_terrain(3, 3, TerrainType.WATER)
+    cavalry = UnitFactory.create_unit("Rider", KnightClass.CAVALRY, 0, 0)
+
+    plane = terrain_map.movement_cost_plane(cavalry)
+
+    assert list(plane) == [
+        terrain_map.get_movement_cost(x, y, cavalry) for y in range(20) for x in range(20)]
+    assert math.isinf(plane[3 * 20 + 3])
+    assert terrain_map.movement_cost_plane(cavalry) is plane
+
+    terrain_map.set_terrain(3, 3, TerrainType.PLAINS)
+    replanned = terrain_map.movement_cost_plane(cavalry)
+    assert replanned is not plane
+    assert replanned[3 * 20 + 3] == terrain_map.get_movement_cost(3, 3, cavalry) < math.inf
+
+
+@pytest.mark.skipif(not C_EXTENSION_AVAILABLE, reason="C extension not built")
+def test_type_plane_feeds_native_pathfinding():
+    import c_algorithms
+
+    terrain_map = TerrainMap(16, 12, seed=9)
+    grid_list = [TERRAIN_TYPE_IDS[terrain_map.get_terrain(x, y).type] for y in range(12) for x in range(16)]
+    costs = {TERRAIN_TYPE_IDS[t]: 1.0 + i % 3 for i, t in enumerate(TERRAIN_TYPES)}
+
+    from_plane = c_algorithms.find_reachable(16, 12, terrain_map.type_ids(), costs, (2, 2), [], 9.0, None)
+    from_list = c_algorithms.find_reachable(16, 12, grid_list, costs, (2, 2), [], 9.0, None)
+
+    assert from_plane == from_list
+    with pytest.raises(ValueError):
+        c_algorithms.find_reachable(16, 12, bytes(5), costs, (2, 2), [], 9.0, None)
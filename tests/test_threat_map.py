@@ -0,0 +1,167 @@
+"""Tests for multi-source threat and influence maps."""
+import random
+
+from game.ai.ai_player import AIPlayer
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.hex_utils import HexGrid
+from game.systems.threat_map import ThreatMap
+from game.terrain import TerrainType
+from game.test_utils.mock_game_state import MockGameState
+
+
+def _make_state(width=20, height=20):
+    game_state = MockGameState(board_width=width, board_height=height)
+    game_state.fog_of_war = None
+    game_state._castles = []
+    return game_state
+
+
+def _add_unit(game_state, name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    game_state.add_knight(unit)
+    return unit
+
+
+def _hex_distance(a, b):
+    hex_grid = HexGrid()
+    return hex_grid.offset_to_axial(*a).distance_to(hex_grid.offset_to_axial(*b))
+
+
+def _snapshot(threat_map):
+    return [
+        (threat_map.earliest_turn(x, y), threat_map.threat_cost(x, y),
+         threat_map.attack_potential(x, y), threat_map.archer_coverage(x, y))
+        for y in range(threat_map.height)
+        for x in range(threat_map.width)
+    ]
+
+
+def test_native_and_python_maps_match():
+    assert C_EXTENSION_AVAILABLE, "C pathfinding extension is required for parity tests"
+    rng = random.Random(7)
+    game_state = _make_state(24, 18)
+    terrain_types = [TerrainType.PLAINS, TerrainType.FOREST, TerrainType.HILLS, TerrainType.WATER]
+    for y in range(18):
+        for x in range(24):
+            game_state.terrain_map.set_terrain(x, y, rng.choice(terrain_types))
+
+    classes = list(KnightClass)
+    tiles = rng.sample([(x, y) for x in range(24) for y in range(18)], 16)
+    for i, (x, y) in enumerate(tiles):
+        game_state.terrain_map.set_terrain(x, y, TerrainType.PLAINS)
+        _add_unit(game_state, f"Unit {i}", classes[i % len(classes)], x, y, 1 + i % 2)
+
+    native = ThreatMap.build(game_state, 2, use_native=True)
+    python = ThreatMap.build(game_state, 2, use_native=False)
+
+    assert _snapshot(native) == _snapshot(python)
+
+
+def test_earliest_turn_follows_action_points():
+    game_state = _make_state()
+    enemy = _add_unit(game_state, "Enemy", KnightClass.WARRIOR, 10, 10, 1)
+
+    threat_map = ThreatMap.build(game_state, 2)
+    ap = enemy.max_action_points
+
+    assert threat_map.earliest_turn(10, 10) == 0
+    for x, y in [(10 + ap, 10), (10, 10 + ap)]:
+        assert _hex_distance((10, 10), (x, y)) <= ap
+        assert threat_map.earliest_turn(x, y) == 1
+    assert threat_map.earliest_turn(0, 0) == 2
+    assert threat_map.threat_cost(12, 10) == 2.0
+
+
+def test_attack_potential_sums_units_in_reach():
+    game_state = _make_state()
+    _add_unit(game_state, "Left", KnightClass.WARRIOR, 4, 10, 1)
+    _add_unit(game_state, "Right", KnightClass.WARRIOR, 14, 10, 1)
+
+    threat_map = ThreatMap.build(game_state, 2)
+
+    # Warriors move 4 (8 AP - 4 for the attack) and strike 1 hex further
+    assert threat_map.attack_potential(9, 10) == 200.0
+    assert threat_map.attack_potential(4, 16) == 0.0
+    assert threat_map.attack_potential(4, 15) == 100.0
+    assert threat_map.archer_coverage(9, 10) == 0
+
+
+def test_archer_coverage_counts_ranged_units_only():
+    game_state = _make_state()
+    _add_unit(game_state, "Archer", KnightClass.ARCHER, 10, 10, 1)
+    _add_unit(game_state, "Warrior", KnightClass.WARRIOR, 11, 10, 1)
+
+    threat_map = ThreatMap.build(game_state, 2)
+
+    assert threat_map.archer_coverage(10, 18) == 1
+    assert threat_map.archer_coverage(10, 19) == 0
+    assert threat_map.attack_potential(10, 18) == 120.0
+
+
+def test_own_units_block_movement_but_can_be_attacked():
+    game_state = _make_state(9, 7)
+    _add_unit(game_state, "Enemy", KnightClass.WARRIOR, 0, 1, 1)
+    for y in range(7):
+        _add_unit(game_state, f"Wall {y}", KnightClass.WARRIOR, 2, y, 2)
+
+    blocked = ThreatMap.build(game_state, 2)
+    open_field = ThreatMap.build(game_state, 2, block_units=False)
+
+    assert blocked.earliest_turn(2, 1) == ThreatMap.UNREACHABLE
+    assert blocked.earliest_turn(4, 1) == ThreatMap.UNREACHABLE
+    assert blocked.attack_potential(2, 1) == 100.0
+    assert open_field.earliest_turn(4, 1) == 1
+
+
+def test_hidden_enemies_are_ignored_with_fog():
+    class FogStub:
+        def get_visibility_state(self, player_id, x, y):
+            from game.visibility import VisibilityState
+            return VisibilityState.VISIBLE if x < 10 else VisibilityState.HIDDEN
+
+    game_state = _make_state()
+    _add_unit(game_state, "Seen", KnightClass.WARRIOR, 3, 3, 1)
+    _add_unit(game_state, "Hidden", KnightClass.WARRIOR, 16, 16, 1)
+
+    threat_map = ThreatMap.build(game_state, 2, fog_of_war=FogStub())
+
+    assert threat_map.earliest_turn(3, 3) == 0
+    assert threat_map.earliest_turn(16, 16) != 0
+
+
+def test_routing_moves_increase_distance_from_enemies():
+    game_state = _make_state()
+    _add_unit(game_state, "Enemy", KnightClass.WARRIOR, 10, 10, 1)
+    router = _add_unit(game_state, "Router", KnightClass.WARRIOR, 12, 10, 2)
+    router.is_routing = True
+
+    moves = router.get_behavior('MovementBehavior')._get_routing_moves(router, game_state)
+
+    assert moves
+    start_distance = _hex_distance((10, 10), (12, 10))
+    for move in moves:
+        assert _hex_distance((10, 10), move) > start_distance
+
+
+def test_ai_facing_scores_tiles_enemies_can_reach():
+    game_state = _make_state()
+    _add_unit(game_state, "Enemy", KnightClass.WARRIOR, 10, 10, 1)
+    own = _add_unit(game_state, "Own", KnightClass.WARRIOR, 10, 13, 2)
+
+    ai = AIPlayer(2, 'easy')
+    ai._begin_search(game_state)
+    own.facing.face_towards(10, 11, own.x, own.y)
+    facing_enemy = ai._evaluate_facing_position(own, game_state)
+    own.facing.face_towards(10, 15, own.x, own.y)
+    facing_away = ai._evaluate_facing_position(own, game_state)
+    own.x, own.y = 2, 2
+    far_from_enemy = ai._evaluate_facing_position(own, game_state)
+    ai._end_search()
+
+    # The warrior can reach tiles on either side of the unit next turn
+    assert facing_away < 0
+    assert facing_enemy > facing_away
+    assert far_from_enemy == 0
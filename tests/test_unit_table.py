@@ -0,0 +1,174 @@
+"""Tests for the columnar unit table behind Unit fields."""
+import copy
+
+import pytest
+
+from game.c_pathfinding_wrapper import C_EXTENSION_AVAILABLE, CPathFinder
+from game.components.facing import FacingDirection
+from game.entities.knight import KnightClass
+from game.entities.unit_factory import UnitFactory
+from game.entities.unit_table import FLAG_ROUTING, NO_PLAYER, UnitTable
+from game.state.battle_state import BattleState
+from game.test_utils.scenario_battles import load_battle
+
+
+def _unit(name, unit_class, x, y, player_id):
+    unit = UnitFactory.create_unit(name, unit_class, x, y)
+    unit.player_id = player_id
+    return unit
+
+
+def _empty_battle():
+    battle_state = BattleState({'board_size': (12, 12), 'knights': 0, 'castles': 0})
+    battle_state.knights.clear()
+    return battle_state
+
+
+def test_unit_fields_are_views_of_its_row():
+    unit = _unit("Scout", KnightClass.CAVALRY, 3, 4, 2)
+    unit.is_routing = True
+    unit.facing.facing = FacingDirection.WEST
+    unit.stats.stats.morale = 42.0
+
+    row = unit._row
+    assert row.table.row_values(row.index)[:4] == (3, 4, 2, unit.soldiers)
+    assert row.table.flags[row.index] & FLAG_ROUTING
+    assert row.table.facing[row.index] == FacingDirection.WEST.value
+    assert row.table.morale[row.index] == 42.0
+    assert unit.stats.stats._row is row and unit.facing._row is row
+
+    unit.player_id = None
+    assert unit.player_id is None and row.table.player[row.index] == NO_PLAYER
+    unit.player_id = 0
+    assert unit.player_id == 0
+
+
+def test_battle_state_adopts_and_releases_rows():
+    battle_state = _empty_battle()
+    first = _unit("First", KnightClass.WARRIOR, 1, 1, 1)
+    second = _unit("Second", KnightClass.ARCHER, 2, 2, 2)
+    third = _unit("Third", KnightClass.MAGE, 3, 3, 2)
+    battle_state.knights.extend([first, second, third])
+
+    table = battle_state.unit_table
+    assert list(table.x) == [1, 2, 3] and list(table.player) == [1, 2, 2]
+    assert table.units == [first, second, third]
+
+    second.x = 9
+    assert table.x[1] == 9
+
+    battle_state.knights.remove(first)
+    table = battle_state.unit_table
+    assert len(table) == 2
+    # The last row filled the hole and its unit still reads its own values
+    assert table.units == [third, second]
+    assert (third.x, second.x) == (3, 9)
+    assert table.index_of(third) == 0 and table.index_of(first) is None
+
+    # A released unit keeps its values in a private row
+    first.x = 5
+    assert first.x == 5 and 5 not in table.x
+
+
+def test_reading_the_table_does_not_rescan_the_knights(monkeypatch):
+    battle_state = _empty_battle()
+    first = _unit("First", KnightClass.WARRIOR, 1, 1, 1)
+    second = _unit("Second", KnightClass.ARCHER, 2, 2, 2)
+    battle_state.knights = [first]
+    table = battle_state.unit_table
+
+    battle_state.knights.append(second)
+    assert table.units == [first, second]
+    del battle_state.knights[0]
+    assert table.units == [second] and table.index_of(first) is None
+
+    def no_sync(self, units):
+        raise AssertionError("unit_table read rescanned the knights")
+
+    monkeypatch.setattr(UnitTable, 'sync', no_sync)
+    assert battle_state.unit_table is table and list(battle_state.unit_table.x) == [2]
+    assert type(copy.copy(battle_state.knights)) is list
+
+
+def test_dead_units_leave_the_table():
+    battle_state = load_battle("cavalry_charge")
+    table = battle_state.unit_table
+    victim = battle_state.knights[0]
+    victim.stats.stats.current_soldiers = 0
+
+    battle_state.cleanup_dead_knights()
+
+    assert victim not in battle_state.unit_table.units
+    assert len(table) == len(battle_state.knights)
+    for index, unit in enumerate(table.units):
+        assert (table.x[index], table.y[index]) == (unit.x, unit.y)
+
+
+def test_clones_get_independent_rows():
+    battle_state = _empty_battle()
+    unit = _unit("Original", KnightClass.WARRIOR, 4, 4, 1)
+    battle_state.knights.append(unit)
+    table = battle_state.unit_table
+
+    clone = unit.clone_for_simulation()
+    clone.x = 7
+    clone.has_moved = True
+    clone.stats.stats.current_soldiers -= 10
+    clone.facing.rotate_clockwise()
+    stats_copy = copy.copy(unit.stats.stats)
+    stats_copy.morale = 1.0
+
+    assert (unit.x, unit.has_moved) == (4, False)
+    assert unit.soldiers == clone.soldiers + 10
+    assert unit.facing.facing != clone.facing.facing
+    assert unit.morale != 1.0
+    assert clone._row.table is not table and len(table) == 1
+
+
+def test_gathered_table_copies_without_rebinding():
+    unit = _unit("Loose", KnightClass.ARCHER, 6, 2, 1)
+    row = unit._row
+
+    table = UnitTable.of(type("State", (), {'knights': [unit]})())
+
+    assert list(table.x) == [6] and table.units == [unit]
+    assert unit._row is row and row.table is not table
+    with pytest.raises(ValueError):
+        table.adopt(unit)
+
+
+@pytest.mark.skipif(not C_EXTENSION_AVAILABLE, reason="C extension not built")
+def test_native_reachability_accepts_table_masks():
+    import c_algorithms
+
+    battle_state = load_battle("cavalry_charge")
+    width, height = battle_state.board_width, battle_state.board_height
+    mover = next(k for k in battle_state.knights if k.player_id == 2)
+    pathfinder = CPathFinder()
+    grid, type_to_id, terrain_types = pathfinder.get_terrain_grid(battle_state)
+    costs = pathfinder.build_cost_map(mover, type_to_id, terrain_types)
+
+    table = battle_state.unit_table
+    blocked = pathfinder.build_blocked_mask(battle_state, table, mover)
+    zoc = pathfinder.build_zoc_mask(width, height, table, mover)
+    enemies = [k for k in battle_state.knights if k.player_id != mover.player_id]
+    blockers = [(k.x, k.y) for k in enemies]
+    for castle in battle_state.castles:
+        blockers.extend(castle.occupied_tiles)
+    zoc_list = [
+        int(any(k.has_zone_of_control() and abs(x - k.x) <= 1 and abs(y - k.y) <= 1 and (x, y) != (k.x, k.y)
+                for k in enemies))
+        for y in range(height) for x in range(width)
+    ]
+
+    assert [i for i, v in enumerate(blocked) if v] == sorted(
+        {y * width + x for x, y in blockers if 0 <= x < width and 0 <= y < height})
+    assert zoc is not None and list(zoc) == zoc_list
+
+    start = (mover.x, mover.y)
+    from_masks = c_algorithms.find_reachable(width, height, grid, costs, start, blocked, 12.0, zoc)
+    from_lists = c_algorithms.find_reachable(width, height, grid, costs, start, blockers, 12.0, zoc_list)
+    assert from_masks == from_lists
+
+    with pytest.raises(ValueError):
+        c_algorithms.find_reachable(width, height, grid, costs, start, bytearray(3), 12.0, None)
@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+AI Tournament
+Plays seeded AI-vs-AI battles on the test scenario maps without a window and
+reports win rates, battle length and per-phase AI time and search nodes.
+"""
+
+import argparse
+import os
+import random
+import sys
+from concurrent.futures import ProcessPoolExecutor
+from dataclasses import dataclass, field
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+os.environ.setdefault("SDL_VIDEODRIVER", "dummy")
+os.environ.setdefault("SDL_AUDIODRIVER", "dummy")
+
+from game.ai.ai_player import AIPlayer  # noqa: E402
+from game.battle.adapters.headless_battle import AI_PHASES, HeadlessBattle, PhaseStats  # noqa: E402
+from game.test_utils.scenario_battles import load_battle, loadable_scenarios  # noqa: E402
+
+DIFFICULTIES = ('easy', 'medium', 'hard', 'mcts')
+# Playouts per MCTS decision: a fixed count rather than a time budget keeps battles repeatable
+MCTS_ITERATIONS = 100
+
+
+@dataclass(frozen=True)
+class BattleSpec:
+    """One battle of a tournament; picklable for worker processes"""
+    scenario: str
+    seed: int
+    difficulties: tuple
+    max_turns: int
+    mcts_iterations: int = MCTS_ITERATIONS
+
+
+@dataclass
+class BattleResult:
+    scenario: str
+    seed: int
+    winner: int | None
+    turns: int
+    actions: int
+    rejected: int
+    phases: dict
+
+
+@dataclass
+class TournamentReport:
+    battles: int = 0
+    wins: dict = field(default_factory=lambda: {1: 0, 2: 0, None: 0})
+    turns: int = 0
+    actions: int = 0
+    rejected: int = 0
+    phases: dict = field(default_factory=lambda: {
+        player_id: {phase: PhaseStats() for phase in AI_PHASES} for player_id in (1, 2)
+    })
+    by_scenario: dict = field(default_factory=dict)
+
+    def add(self, result: BattleResult) -> None:
+        self.battles += 1
+        self.wins[result.winner] += 1
+        self.turns += result.turns
+        self.actions += result.actions
+        self.rejected += result.rejected
+        for player_id, phases in result.phases.items():
+            for phase, stats in phases.items():
+                self.phases[player_id][phase].merge(stats)
+        scenario_wins = self.by_scenario.setdefault(result.scenario, {1: 0, 2: 0, None: 0})
+        scenario_wins[result.winner] += 1
+
+    def win_rate(self, winner) -> float:
+        return self.wins[winner] / self.battles if self.battles else 0.0
+
+
+def run_battle(spec: BattleSpec) -> BattleResult:
+    """Play one battle; the seed fixes every random choice the AIs and combat make.
+
+    MCTS players search a fixed number of playouts with a search seed drawn
+    from the battle seed, so their moves do not depend on machine speed.
+    """
+    random.seed(spec.seed)
+    ai_players = {}
+    for player_id, difficulty in zip((1, 2), spec.difficulties):
+        ai = AIPlayer(player_id, difficulty, mcts_seed=random.getrandbits(64))
+        ai.mcts_iterations = spec.mcts_iterations
+        ai_players[player_id] = ai
+    outcome = HeadlessBattle(load_battle(spec.scenario, current_player=1), ai_players).play(spec.max_turns)
+    return BattleResult(
+        scenario=spec.scenario,
+        seed=spec.seed,
+        winner=outcome.winner,
+        turns=outcome.turns,
+        actions=outcome.actions,
+        rejected=outcome.rejected,
+        phases=outcome.phases,
+    )
+
+
+def build_specs(scenarios, battles: int, seed: int, difficulties: tuple, max_turns: int,
+                mcts_iterations: int = MCTS_ITERATIONS) -> list:
+    """Spread battles round-robin over the scenarios with consecutive seeds"""
+    if not scenarios:
+        raise ValueError("at least one scenario is required")
+    if battles <= 0:
+        raise ValueError("battles must be positive")
+    if mcts_iterations <= 0:
+        raise ValueError("mcts_iterations must be positive")
+    return [
+        BattleSpec(scenarios[i % len(scenarios)], seed + i, difficulties, max_turns, mcts_iterations)
+        for i in range(battles)
+    ]
+
+
+def run_tournament(specs, workers: int = 1) -> TournamentReport:
+    report = TournamentReport()
+    if workers <= 1:
+        for result in map(run_battle, specs):
+            report.add(result)
+        return report
+    with ProcessPoolExecutor(max_workers=workers) as executor:
+        for result in executor.map(run_battle, specs):
+            report.add(result)
+    return report
+
+
+def format_report(report: TournamentReport, difficulties: tuple) -> str:
+    lines = [f"Battles: {report.battles}"]
+    for player_id, difficulty in zip((1, 2), difficulties):
+        lines.append(f"  Player {player_id} ({difficulty}) wins: "
+                     f"{report.wins[player_id]} ({report.win_rate(player_id):.0%})")
+    lines.append(f"  Undecided: {report.wins[None]} ({report.win_rate(None):.0%})")
+    if report.battles:
+        lines.append(f"  Turns per battle: {report.turns / report.battles:.1f}")
+        lines.append(f"  Actions per battle: {report.actions / report.battles:.1f}"
+                     f" (rejected: {report.rejected})")
+
+    lines.append("")
+    lines.append(f"{'Scenario':<24}{'P1':>6}{'P2':>6}{'Draw':>6}")
+    for scenario, wins in sorted(report.by_scenario.items()):
+        lines.append(f"{scenario:<24}{wins[1]:>6}{wins[2]:>6}{wins[None]:>6}")
+
+    lines.append("")
+    lines.append(f"{'Player':<8}{'Phase':<10}{'Calls':>8}{'Seconds':>10}{'ms/call':>10}{'Nodes':>10}")
+    for player_id in (1, 2):
+        for phase in AI_PHASES:
+            stats = report.phases[player_id][phase]
+            per_call = stats.seconds * 1000 / stats.calls if stats.calls else 0.0
+            lines.append(f"{player_id:<8}{phase:<10}{stats.calls:>8}{stats.seconds:>10.2f}"
+                         f"{per_call:>10.1f}{stats.nodes:>10}")
+    return "\n".join(lines)
+
+
+def main():
+    """Main entry point"""
+    parser = argparse.ArgumentParser(description='Play headless AI-vs-AI battles on the test scenarios')
+    parser.add_argument('--battles', '-n', type=int, default=8,
+                        help='Number of battles to play')
+    parser.add_argument('--scenario', '-s', action='append',
+                        help='Scenario to play (can be used multiple times; default: all loadable)')
+    parser.add_argument('--p1', choices=DIFFICULTIES, default='medium',
+                        help='Difficulty of player 1')
+    parser.add_argument('--p2', choices=DIFFICULTIES, default='medium',
+                        help='Difficulty of player 2')
+    parser.add_argument('--seed', type=int, default=0,
+                        help='Seed of the first battle; battle i uses seed + i')
+    parser.add_argument('--max-turns', type=int, default=20,
+                        help='Turn limit after which a battle is undecided')
+    parser.add_argument('--mcts-iterations', type=int, default=MCTS_ITERATIONS,
+                        help='Playouts per MCTS decision')
+    parser.add_argument('--workers', '-j', type=int, default=os.cpu_count() or 1,
+                        help='Worker processes')
+    parser.add_argument('--list', '-l', action='store_true',
+                        help='List loadable scenarios and exit')
+
+    args = parser.parse_args()
+
+    scenarios = loadable_scenarios()
+    if args.list:
+        print("Loadable scenarios:")
+        for name in scenarios:
+            print(f"   {name}")
+        return 0
+
+    if args.scenario:
+        unknown = [name for name in args.scenario if name not in scenarios]
+        if unknown:
+            print(f"❌ Unknown or unloadable scenario(s): {', '.join(unknown)}")
+            return 1
+        scenarios = args.scenario
+
+    difficulties = (args.p1, args.p2)
+    specs = build_specs(scenarios, args.battles, args.seed, difficulties, args.max_turns,
+                        args.mcts_iterations)
+    report = run_tournament(specs, min(args.workers, len(specs)))
+    print(format_report(report, difficulties))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
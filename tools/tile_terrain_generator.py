@@ -25,6 +25,7 @@ import io
 # Import campaign terrain types
 sys.path.append(os.path.dirname(os.path.dirname(__file__)))
 from game.campaign.campaign_state import CampaignTerrainType
+from game.campaign.campaign_map_file import write_campaign_map
 
 @dataclass
 class GeographicBounds:
@@ -526,10 +527,10 @@ def merge_horizontal_rectangles(row_rectangles: List[List[int]]) -> List[List[in
     merged_row.append(current_rect)
     return merged_row
 
-def export_to_json(terrain_map: Dict, width: int, height: int, hex_size_km: float, 
-                  output_path: str, bounds: GeographicBounds, zoom: int = 10, 
-                  map_image: Image.Image = None, classifier: TileTerrainClassifier = None):
-    """Export terrain map to game-compatible JSON format"""
+def build_export_data(terrain_map: Dict, width: int, height: int, hex_size_km: float,
+                      bounds: GeographicBounds, zoom: int = 10,
+                      map_image: Image.Image = None, classifier: TileTerrainClassifier = None) -> Dict:
+    """Campaign map data in the game's JSON layout: merged terrain rectangles, countries and cities"""
     # Group terrain by type (initially as individual hexes)
     terrain_groups = {}
     for (hex_x, hex_y), terrain_type in terrain_map.items():
@@ -577,17 +578,18 @@ def export_to_json(terrain_map: Dict, width: int, height: int, hex_size_km: floa
         print(f"   ⚠️  City collisions resolved: {collision_count}")
         print(f"   📍 Unique city positions: {unique_positions}")
     
-    export_data = {
+    return {
         "map": {"width": width, "height": height, "hex_size_km": hex_size_km, "terrain": terrain_groups},
         "countries": countries,
         "cities": cities,
         "neutral_regions": []
     }
-    
-    os.makedirs(os.path.dirname(output_path) if os.path.dirname(output_path) else '.', exist_ok=True)
-    with open(output_path, 'w', encoding='utf-8') as f:
-        json.dump(export_data, f, indent=2, ensure_ascii=False)
-    
+
+
+def print_export_statistics(terrain_map: Dict, export_data: Dict):
+    terrain_groups = export_data["map"]["terrain"]
+    cities = export_data["cities"]
+
     # Print terrain statistics
     print("\n📊 Terrain distribution:")
     for terrain_type, hexes in sorted(terrain_groups.items(), key=lambda x: len(x[1]), reverse=True):
@@ -606,6 +608,30 @@ def export_to_json(terrain_map: Dict, width: int, height: int, hex_size_km: floa
         for city_type, count in sorted(city_types.items(), key=lambda x: x[1], reverse=True):
             print(f"   {city_type}: {count} cities")
 
+
+def export_to_json(terrain_map: Dict, width: int, height: int, hex_size_km: float, 
+                  output_path: str, bounds: GeographicBounds, zoom: int = 10, 
+                  map_image: Image.Image = None, classifier: TileTerrainClassifier = None):
+    """Export terrain map to game-compatible JSON format"""
+    export_data = build_export_data(terrain_map, width, height, hex_size_km, bounds, zoom, map_image, classifier)
+    
+    os.makedirs(os.path.dirname(output_path) if os.path.dirname(output_path) else '.', exist_ok=True)
+    with open(output_path, 'w', encoding='utf-8') as f:
+        json.dump(export_data, f, indent=2, ensure_ascii=False)
+    
+    print_export_statistics(terrain_map, export_data)
+
+
+def export_to_binary(terrain_map: Dict, width: int, height: int, hex_size_km: float,
+                     output_path: str, bounds: GeographicBounds, zoom: int = 10,
+                     map_image: Image.Image = None, classifier: TileTerrainClassifier = None):
+    """Export terrain map to the game's memory-mapped .cmap format"""
+    export_data = build_export_data(terrain_map, width, height, hex_size_km, bounds, zoom, map_image, classifier)
+    write_campaign_map(output_path, export_data,
+                       (bounds.west_lon, bounds.east_lon, bounds.south_lat, bounds.north_lat))
+    print_export_statistics(terrain_map, export_data)
+
+
 def load_map_definitions():
     """Load map definitions from JSON file"""
     definitions_file = os.path.join(os.path.dirname(os.path.dirname(__file__)), 'map_definitions.json')
@@ -760,6 +786,9 @@ def generate_all_maps_from_definitions(args):
                 print(f"💾 Exporting to {output_path}...")
                 export_to_json(terrain_map, hex_grid_width, hex_grid_height, hex_size_km, output_path, bounds, 
                               zoom, map_image, classifier)
+                if args.binary:
+                    export_to_binary(terrain_map, hex_grid_width, hex_grid_height, hex_size_km,
+                                     os.path.splitext(output_path)[0] + '.cmap', bounds, zoom, map_image, classifier)
                 
                 print(f"✅ {map_def['name']} generation complete!")
                 print(f"   Generated: {output_path}")
@@ -810,6 +839,8 @@ def main():
                        help='Save the combined tile image for inspection')
     parser.add_argument('--list-maps', action='store_true',
                        help='List available map definitions from map_definitions.json and exit')
+    parser.add_argument('--binary', action='store_true',
+                       help='Also export a memory-mapped .cmap next to each JSON map')
     
     args = parser.parse_args()
     
@@ -982,6 +1013,9 @@ def main():
         print(f"\n💾 Exporting to {args.output}...")
         export_to_json(terrain_map, hex_grid_width, hex_grid_height, args.hex_size_km, args.output, bounds, 
                       args.zoom, map_image, classifier)
+        if args.binary:
+            export_to_binary(terrain_map, hex_grid_width, hex_grid_height, args.hex_size_km,
+                             os.path.splitext(args.output)[0] + '.cmap', bounds, args.zoom, map_image, classifier)
         
         print(f"\n✅ Terrain generation complete!")
         print(f"   Generated: {args.output}")